@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "audio_data_callback_napi.h"
+#include "intell_voice_log.h"
+#include "intell_voice_napi_util.h"
+#include "hot_log.h"
+
+#define LOG_TAG "AudioDataCallbackNapi"
+
+namespace OHOS {
+namespace IntellVoiceNapi {
+static constexpr size_t MAX_PENDING_AUDIO_BATCHES = 4;
+static constexpr size_t INITIAL_THREAD_COUNT = 1;
+static constexpr int64_t LOG_LIMIT_INTERVAL_MS = 1000;
+
+AudioDataCallbackNapi::~AudioDataCallbackNapi()
+{
+    if (tsfn_ != nullptr) {
+        napi_release_threadsafe_function(tsfn_, napi_tsfn_release);
+        tsfn_ = nullptr;
+    }
+}
+
+std::shared_ptr<AudioDataCallbackNapi> AudioDataCallbackNapi::Create(napi_env env, napi_value callback)
+{
+    std::shared_ptr<AudioDataCallbackNapi> callbackNapi(new (std::nothrow) AudioDataCallbackNapi());
+    CHECK_CONDITION_RETURN_RET(callbackNapi == nullptr, nullptr, "create audio data callback failed");
+
+    napi_value resourceName = nullptr;
+    napi_create_string_utf8(env, "AudioDataCallback", NAPI_AUTO_LENGTH, &resourceName);
+    napi_status status = napi_create_threadsafe_function(env, callback, nullptr, resourceName,
+        MAX_PENDING_AUDIO_BATCHES, INITIAL_THREAD_COUNT, nullptr, nullptr, nullptr, CallJs, &callbackNapi->tsfn_);
+    if (status != napi_ok) {
+        INTELL_VOICE_LOG_ERROR("create threadsafe function failed, status:%{public}d", status);
+        return nullptr;
+    }
+    return callbackNapi;
+}
+
+bool AudioDataCallbackNapi::OnAudioData(std::vector<uint8_t> &data)
+{
+    auto buffer = new (std::nothrow) std::vector<uint8_t>();
+    CHECK_CONDITION_RETURN_FALSE(buffer == nullptr, "create audio buffer failed");
+    buffer->swap(data);
+
+    napi_status status = napi_call_threadsafe_function(tsfn_, buffer, napi_tsfn_nonblocking);
+    if (status != napi_ok) {
+        INTELL_VOICE_LOG_WARN_LIMIT(LOG_LIMIT_INTERVAL_MS, "drop audio batch, status:%{public}d", status);
+        delete buffer;
+        return false;
+    }
+    return true;
+}
+
+void AudioDataCallbackNapi::CallJs(napi_env env, napi_value jsCallback, void * /* context */, void *data)
+{
+    std::unique_ptr<std::vector<uint8_t>> buffer(static_cast<std::vector<uint8_t> *>(data));
+    // env is null when the function is being torn down with batches still queued
+    if ((env == nullptr) || (jsCallback == nullptr) || (buffer == nullptr)) {
+        return;
+    }
+
+    napi_value undefined = nullptr;
+    napi_get_undefined(env, &undefined);
+    napi_value arg = CreateExternalArrayBuffer(env, std::move(*buffer));
+    buffer.reset();
+    napi_status status = napi_call_function(env, undefined, jsCallback, 1, &arg, nullptr);
+    if (status != napi_ok) {
+        INTELL_VOICE_LOG_ERROR("call audio data callback failed, status:%{public}d", status);
+    }
+}
+}  // namespace IntellVoiceNapi
+}  // namespace OHOS
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AUDIO_DATA_CALLBACK_NAPI_H
+#define AUDIO_DATA_CALLBACK_NAPI_H
+
+#include <memory>
+#include <vector>
+#include "napi/native_api.h"
+#include "napi/native_node_api.h"
+
+namespace OHOS {
+namespace IntellVoiceNapi {
+/*
+ * Delivers captured audio batches to a js callback through a threadsafe function.
+ * The queue is bounded, a batch that finds it full is rejected so the producer can count it as dropped.
+ */
+class AudioDataCallbackNapi {
+public:
+    ~AudioDataCallbackNapi();
+
+    static std::shared_ptr<AudioDataCallbackNapi> Create(napi_env env, napi_value callback);
+    bool OnAudioData(std::vector<uint8_t> &data);
+
+private:
+    AudioDataCallbackNapi() = default;
+    static void CallJs(napi_env env, napi_value jsCallback, void *context, void *data);
+
+    napi_threadsafe_function tsfn_ = nullptr;
+};
+}  // namespace IntellVoiceNapi
+}  // namespace OHOS
+#endif
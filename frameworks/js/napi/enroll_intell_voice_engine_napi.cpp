@@ -53,6 +53,8 @@ EnrollIntellVoiceEngineNapi::EnrollIntellVoiceEngineNapi()
 EnrollIntellVoiceEngineNapi::~EnrollIntellVoiceEngineNapi()
 {
     INTELL_VOICE_LOG_INFO("enter");
+    // queued calls use engine_, drain the worker before the members go away
+    worker_ = nullptr;
     if (wrapper_ != nullptr) {
         napi_delete_reference(env_, wrapper_);
     }
@@ -166,6 +168,11 @@ napi_value EnrollIntellVoiceEngineNapi::Construct(napi_env env, napi_callback_in
         return undefinedResult;
     }
 
+    engineNapi->worker_ = NapiWorker::Create(env, "EnrollNapiWorker");
+    if (engineNapi->worker_ == nullptr) {
+        INTELL_VOICE_LOG_WARN("create worker failed, use the shared async work pool");
+    }
+
     status = napi_wrap(env, jsThis, static_cast<void *>(engineNapi.get()),
         EnrollIntellVoiceEngineNapi::Destruct, nullptr, &(engineNapi->wrapper_));
     if (status == napi_ok) {
@@ -245,7 +252,7 @@ napi_value EnrollIntellVoiceEngineNapi::GetSupportedRegions(napi_env env, napi_c
         napi_set_element(env, result, 0, SetValue(env, "CN"));
     };
 
-    return NapiAsync::AsyncWork(env, context, "GetSupportedRegions", execute);
+    return QueueWork(env, context, "GetSupportedRegions", execute);
 }
 
 napi_value EnrollIntellVoiceEngineNapi::Init(napi_env env, napi_callback_info info)
@@ -300,7 +307,7 @@ napi_value EnrollIntellVoiceEngineNapi::Init(napi_env env, napi_callback_info in
 
     AsyncExecute execute = [](napi_env env, void *data) {};
 
-    return NapiAsync::AsyncWork(env, context, "Init", execute, CompleteCallback);
+    return QueueWork(env, context, "Init", execute, CompleteCallback);
 }
 
 napi_value EnrollIntellVoiceEngineNapi::EnrollForResult(napi_env env, napi_callback_info info)
@@ -343,7 +350,7 @@ napi_value EnrollIntellVoiceEngineNapi::EnrollForResult(napi_env env, napi_callb
 
     AsyncExecute execute = [](napi_env env, void *data) {};
 
-    return NapiAsync::AsyncWork(env, context, "Start", execute, CompleteCallback);
+    return QueueWork(env, context, "Start", execute, CompleteCallback);
 }
 
 napi_value EnrollIntellVoiceEngineNapi::Stop(napi_env env, napi_callback_info info)
@@ -377,7 +384,7 @@ napi_value EnrollIntellVoiceEngineNapi::Stop(napi_env env, napi_callback_info in
         execute = [](napi_env env, void *data) {};
     }
 
-    return NapiAsync::AsyncWork(env, context, "Stop", execute);
+    return QueueWork(env, context, "Stop", execute);
 }
 
 napi_value EnrollIntellVoiceEngineNapi::SetParameter(napi_env env, napi_callback_info info)
@@ -421,7 +428,7 @@ napi_value EnrollIntellVoiceEngineNapi::SetParameter(napi_env env, napi_callback
         execute = [](napi_env env, void *data) {};
     }
 
-    return NapiAsync::AsyncWork(env, context, "SetParameter", execute);
+    return QueueWork(env, context, "SetParameter", execute);
 }
 
 napi_value EnrollIntellVoiceEngineNapi::GetParameter(napi_env env, napi_callback_info info)
@@ -470,7 +477,7 @@ napi_value EnrollIntellVoiceEngineNapi::GetParameter(napi_env env, napi_callback
         execute = [](napi_env env, void *data) {};
     }
 
-    return NapiAsync::AsyncWork(env, context, "GetParameter", execute);
+    return QueueWork(env, context, "GetParameter", execute);
 }
 
 napi_value EnrollIntellVoiceEngineNapi::SetSensibility(napi_env env, napi_callback_info info)
@@ -507,7 +514,7 @@ napi_value EnrollIntellVoiceEngineNapi::SetSensibility(napi_env env, napi_callba
         engine->SetSensibility(asyncContext->sensibility);
     };
 
-    return NapiAsync::AsyncWork(env, context, "SetSensibility", execute);
+    return QueueWork(env, context, "SetSensibility", execute);
 }
 
 napi_value EnrollIntellVoiceEngineNapi::SetWakeupHapInfo(napi_env env, napi_callback_info info)
@@ -551,7 +558,7 @@ napi_value EnrollIntellVoiceEngineNapi::SetWakeupHapInfo(napi_env env, napi_call
         engine->SetWakeupHapInfo(asyncContext->hapInfo);
     };
 
-    return NapiAsync::AsyncWork(env, context, "SetWakeupHapInfo", execute);
+    return QueueWork(env, context, "SetWakeupHapInfo", execute);
 }
 
 napi_value EnrollIntellVoiceEngineNapi::Commit(napi_env env, napi_callback_info info)
@@ -587,7 +594,7 @@ napi_value EnrollIntellVoiceEngineNapi::Commit(napi_env env, napi_callback_info
 
     AsyncExecute execute = [](napi_env env, void *data) {};
 
-    return NapiAsync::AsyncWork(env, context, "Commit", execute, CompleteCallback);
+    return QueueWork(env, context, "Commit", execute, CompleteCallback);
 }
 
 napi_value EnrollIntellVoiceEngineNapi::EvaluateForResult(napi_env env, napi_callback_info info)
@@ -642,7 +649,7 @@ napi_value EnrollIntellVoiceEngineNapi::EvaluateForResult(napi_env env, napi_cal
         napi_set_named_property(env, result, "score", SetValue(env, context->info.score));
         napi_set_named_property(env, result, "resultCode", SetValue(env, context->info.resultCode));
     };
-    return NapiAsync::AsyncWork(env, context, "Evaluate", execute);
+    return QueueWork(env, context, "Evaluate", execute);
 }
 
 napi_value EnrollIntellVoiceEngineNapi::Release(napi_env env, napi_callback_info info)
@@ -677,7 +684,20 @@ napi_value EnrollIntellVoiceEngineNapi::Release(napi_env env, napi_callback_info
         execute = [](napi_env env, void *data) {};
     }
 
-    return NapiAsync::AsyncWork(env, context, "Release", execute);
+    return QueueWork(env, context, "Release", execute);
+}
+
+napi_value EnrollIntellVoiceEngineNapi::QueueWork(napi_env env, std::shared_ptr<AsyncContext> context,
+    const std::string &name, AsyncExecute execute, napi_async_complete_callback complete)
+{
+    auto engineNapi = reinterpret_cast<EnrollIntellVoiceEngineNapi *>(context->instanceNapi_);
+    if ((engineNapi == nullptr) || (engineNapi->worker_ == nullptr)) {
+        if (complete == nullptr) {
+            return NapiAsync::AsyncWork(env, context, name, execute);
+        }
+        return NapiAsync::AsyncWork(env, context, name, execute, complete);
+    }
+    return engineNapi->worker_->Submit(env, context, execute, complete);
 }
 
 void EnrollIntellVoiceEngineNapi::CompleteCallback(napi_env env, napi_status status, void *data)
@@ -21,6 +21,7 @@
 #include "napi/native_node_api.h"
 #include "enroll_intell_voice_engine.h"
 #include "enroll_intell_voice_engine_callback_napi.h"
+#include "intell_voice_napi_worker.h"
 
 namespace OHOS {
 namespace IntellVoiceNapi {
@@ -54,6 +55,8 @@ private:
     static napi_value Release(napi_env env, napi_callback_info info);
 
     static void CompleteCallback(napi_env env, napi_status status, void *data);
+    static napi_value QueueWork(napi_env env, std::shared_ptr<AsyncContext> context, const std::string &name,
+        AsyncExecute execute, napi_async_complete_callback complete = nullptr);
 
 private:
     napi_env env_ = nullptr;
@@ -64,6 +67,7 @@ private:
     std::shared_ptr<EnrollIntellVoiceEngineCallbackNapi> callbackNapi_ = nullptr;
     EngineConfig config_;
     bool isLast_ = false;
+    std::shared_ptr<NapiWorker> worker_ = nullptr;
 };
 }  // namespace IntellVoiceNapi
 }  // namespace OHOS
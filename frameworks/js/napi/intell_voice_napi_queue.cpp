@@ -17,6 +17,7 @@
 #include "intell_voice_common_napi.h"
 #include "intell_voice_napi_util.h"
 #include "intell_voice_log.h"
+#include "hot_log.h"
 
 #define LOG_TAG "IntellVoiceNapiQueue"
 
@@ -26,12 +27,12 @@ namespace OHOS {
 namespace IntellVoiceNapi {
 AsyncContext::AsyncContext(napi_env env) : env_(env)
 {
-    INTELL_VOICE_LOG_INFO("enter");
+    INTELL_VOICE_HOT_LOG_DEBUG("enter");
 }
 
 AsyncContext::~AsyncContext()
 {
-    INTELL_VOICE_LOG_INFO("enter");
+    INTELL_VOICE_HOT_LOG_DEBUG("enter");
     if (env_ != nullptr) {
         if (work_ != nullptr) {
             napi_delete_async_work(env_, work_);
@@ -43,6 +44,26 @@ AsyncContext::~AsyncContext()
     }
 }
 
+void AsyncContext::Recycle()
+{
+    if (env_ != nullptr) {
+        if (work_ != nullptr) {
+            napi_delete_async_work(env_, work_);
+        }
+        if (callbackRef_ != nullptr) {
+            napi_delete_reference(env_, callbackRef_);
+        }
+    }
+    work_ = nullptr;
+    callbackRef_ = nullptr;
+    deferred_ = nullptr;
+    instanceNapi_ = nullptr;
+    result_ = -1;
+    complete_ = nullptr;
+    execute_ = nullptr;
+    workComplete_ = nullptr;
+}
+
 bool AsyncContext::GetCbInfo(napi_env env, napi_callback_info info, size_t callBackIndex, CbInfoParser parser)
 {
     INTELL_VOICE_LOG_INFO("enter");
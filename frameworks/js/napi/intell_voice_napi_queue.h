@@ -34,6 +34,7 @@ public:
     explicit AsyncContext(napi_env env);
     ~AsyncContext();
     bool GetCbInfo(napi_env env, napi_callback_info info, size_t callBackIndex, CbInfoParser parser);
+    void Recycle();
 
     napi_env env_ = nullptr;
     void *instanceNapi_ = nullptr;
@@ -42,6 +43,8 @@ public:
     AsyncComplete complete_ = nullptr;
 
     napi_async_work work_ = nullptr;
+    AsyncExecute execute_ = nullptr;
+    napi_async_complete_callback workComplete_ = nullptr;
     napi_deferred deferred_ = nullptr;
     napi_ref callbackRef_ = nullptr;
     std::shared_ptr<AsyncContext> contextSp_ = nullptr;
@@ -56,6 +59,7 @@ public:
     static void CommonCallbackRoutine(napi_env env, AsyncContext *context, const napi_value &data);
 
 private:
+    friend class NapiWorker;
     static void AsyncCompleteCallback(napi_env env, napi_status status, void *data);
     static void HandlePromise(napi_env env, AsyncContext *context, const napi_value &data);
     static void HandleAsyncCallback(napi_env env, AsyncContext *context, const napi_value &data);
@@ -96,6 +96,28 @@ napi_value SetValue(napi_env env, const std::vector<uint8_t> &value)
     return result;
 }
 
+napi_value CreateExternalArrayBuffer(napi_env env, std::vector<uint8_t> &&value)
+{
+    if (value.empty()) {
+        return SetValue(env, value);
+    }
+
+    auto holder = new (std::nothrow) std::vector<uint8_t>(std::move(value));
+    CHECK_CONDITION_RETURN_RET(holder == nullptr, nullptr, "failed to create buffer holder");
+
+    napi_value result = nullptr;
+    napi_status status = napi_create_external_arraybuffer(env, holder->data(), holder->size(),
+        [](napi_env env, void *data, void *hint) {
+            delete static_cast<std::vector<uint8_t> *>(hint);
+        }, holder, &result);
+    if (status != napi_ok || result == nullptr) {
+        INTELL_VOICE_LOG_WARN("external array buffer is not available, status:%{public}d", status);
+        result = SetValue(env, *holder);
+        delete holder;
+    }
+    return result;
+}
+
 napi_status GetValue(napi_env env, napi_value jsValue, int32_t &value)
 {
     napi_valuetype valueType = napi_undefined;
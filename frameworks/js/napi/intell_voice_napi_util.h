@@ -16,6 +16,7 @@
 #ifndef INTELL_VOICE_NAPI_UTIL_H
 #define INTELL_VOICE_NAPI_UTIL_H
 
+#include <vector>
 #include "napi/native_api.h"
 #include "napi/native_node_api.h"
 
@@ -35,6 +36,8 @@ napi_value SetValue(napi_env env, const int32_t value);
 napi_value SetValue(napi_env env, const uint32_t value);
 napi_value SetValue(napi_env env, const std::string &value);
 napi_value SetValue(napi_env env, const std::vector<uint8_t> &value);
+// hands the buffer to js without copying, the vector is freed when the array buffer is collected
+napi_value CreateExternalArrayBuffer(napi_env env, std::vector<uint8_t> &&value);
 
 napi_status GetValue(napi_env env, napi_value jsValue, int32_t &value);
 napi_status GetValue(napi_env env, napi_value jsValue, bool &value);
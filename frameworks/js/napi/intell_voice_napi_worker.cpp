@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "intell_voice_napi_worker.h"
+
+#include <cerrno>
+#include <pthread.h>
+#include "intell_voice_common_napi.h"
+#include "intell_voice_log.h"
+#include "hot_log.h"
+
+#define LOG_TAG "IntellVoiceNapiWorker"
+
+namespace OHOS {
+namespace IntellVoiceNapi {
+static constexpr size_t UNLIMITED_QUEUE_SIZE = 0;
+static constexpr size_t INITIAL_THREAD_COUNT = 1;
+static constexpr size_t MAX_THREAD_NAME_LEN = 15;
+
+NapiWorker::~NapiWorker()
+{
+    Stop();
+}
+
+std::shared_ptr<NapiWorker> NapiWorker::Create(napi_env env, const std::string &name)
+{
+    std::shared_ptr<NapiWorker> worker(new (std::nothrow) NapiWorker());
+    CHECK_CONDITION_RETURN_RET(worker == nullptr, nullptr, "create napi worker failed");
+    if (!worker->Start(env, name)) {
+        return nullptr;
+    }
+    return worker;
+}
+
+bool NapiWorker::Start(napi_env env, const std::string &name)
+{
+    env_ = env;
+    napi_value resourceName = nullptr;
+    napi_create_string_utf8(env, name.c_str(), NAPI_AUTO_LENGTH, &resourceName);
+    napi_status status = napi_create_threadsafe_function(env, nullptr, nullptr, resourceName,
+        UNLIMITED_QUEUE_SIZE, INITIAL_THREAD_COUNT, nullptr, nullptr, this, CallJs, &tsfn_);
+    if (status != napi_ok) {
+        INTELL_VOICE_LOG_ERROR("create threadsafe function failed, status:%{public}d", status);
+        tsfn_ = nullptr;
+        return false;
+    }
+    // an idle worker must not keep the event loop alive
+    napi_unref_threadsafe_function(env, tsfn_);
+
+    if (sem_init(&sem_, 0, 0) != 0) {
+        INTELL_VOICE_LOG_ERROR("init semaphore failed");
+        return false;
+    }
+    isSemInited_ = true;
+
+    isRunning_.store(true);
+    thread_ = std::thread(&NapiWorker::Run, this);
+    pthread_setname_np(thread_.native_handle(), name.substr(0, MAX_THREAD_NAME_LEN).c_str());
+    return true;
+}
+
+void NapiWorker::Stop()
+{
+    if (thread_.joinable()) {
+        isRunning_.store(false);
+        sem_post(&sem_);
+        thread_.join();
+    }
+
+    // the engine is going away, whatever has not been delivered yet is rejected rather than left pending
+    uint32_t tail = tail_.load(std::memory_order_relaxed);
+    if (completed_ != tail) {
+        INTELL_VOICE_LOG_WARN("reject %{public}u pending calls", tail - completed_);
+    }
+    for (; completed_ != tail; ++completed_) {
+        RejectContext(env_, ring_[completed_ % QUEUE_CAPACITY]);
+    }
+    head_.store(tail, std::memory_order_release);
+
+    if (tsfn_ != nullptr) {
+        napi_release_threadsafe_function(tsfn_, napi_tsfn_abort);
+        tsfn_ = nullptr;
+    }
+    if (isSemInited_) {
+        sem_destroy(&sem_);
+        isSemInited_ = false;
+    }
+}
+
+napi_value NapiWorker::Submit(napi_env env, std::shared_ptr<AsyncContext> context, AsyncExecute execute,
+    napi_async_complete_callback complete)
+{
+    napi_value result = nullptr;
+    if (context->callbackRef_ == nullptr) {
+        napi_create_promise(env, &context->deferred_, &result);
+    } else {
+        napi_get_undefined(env, &result);
+    }
+
+    context->execute_ = execute;
+    context->workComplete_ = complete;
+    context->contextSp_ = context;
+
+    uint32_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - completed_ >= QUEUE_CAPACITY) {
+        INTELL_VOICE_LOG_ERROR("too many pending calls");
+        napi_value undefined = nullptr;
+        napi_get_undefined(env, &undefined);
+        context->result_ = NAPI_INTELLIGENT_VOICE_SYSTEM_ERROR;
+        NapiAsync::CommonCallbackRoutine(env, context.get(), undefined);
+        return result;
+    }
+
+    ring_[tail % QUEUE_CAPACITY] = context.get();
+    tail_.store(tail + 1, std::memory_order_release);
+    sem_post(&sem_);
+    return result;
+}
+
+void NapiWorker::Run()
+{
+    while (true) {
+        if (sem_wait(&sem_) != 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            INTELL_VOICE_LOG_ERROR("wait semaphore failed");
+            break;
+        }
+
+        if (!isRunning_.load()) {
+            break;
+        }
+
+        uint32_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) {
+            continue;
+        }
+        AsyncContext *context = ring_[head % QUEUE_CAPACITY];
+
+        INTELL_VOICE_HOT_LOG_DEBUG("execute context");
+        if (context->execute_ != nullptr) {
+            context->execute_(env_, context);
+        }
+        head_.store(head + 1, std::memory_order_release);
+        if (napi_call_threadsafe_function(tsfn_, nullptr, napi_tsfn_blocking) != napi_ok) {
+            INTELL_VOICE_LOG_ERROR("failed to deliver completion");
+        }
+    }
+}
+
+void NapiWorker::DeliverCompletions(napi_env env)
+{
+    uint32_t head = head_.load(std::memory_order_acquire);
+    for (; completed_ != head; ++completed_) {
+        AsyncContext *context = ring_[completed_ % QUEUE_CAPACITY];
+        if (context->workComplete_ != nullptr) {
+            context->workComplete_(env, napi_ok, context);
+        } else {
+            NapiAsync::AsyncCompleteCallback(env, napi_ok, context);
+        }
+    }
+}
+
+void NapiWorker::CallJs(napi_env env, napi_value /* jsCallback */, void *context, void * /* data */)
+{
+    // env is null when the worker is torn down, Stop has already settled every pending call by then
+    if ((env == nullptr) || (context == nullptr)) {
+        return;
+    }
+    static_cast<NapiWorker *>(context)->DeliverCompletions(env);
+}
+
+void NapiWorker::RejectContext(napi_env env, AsyncContext *context)
+{
+    if (context == nullptr) {
+        return;
+    }
+    napi_value undefined = nullptr;
+    napi_get_undefined(env, &undefined);
+    context->result_ = NAPI_INTELLIGENT_VOICE_SYSTEM_ERROR;
+    NapiAsync::CommonCallbackRoutine(env, context, undefined);
+}
+}  // namespace IntellVoiceNapi
+}  // namespace OHOS
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef INTELL_VOICE_NAPI_WORKER_H
+#define INTELL_VOICE_NAPI_WORKER_H
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <semaphore.h>
+#include "intell_voice_napi_queue.h"
+
+namespace OHOS {
+namespace IntellVoiceNapi {
+/*
+ * Serial worker owned by one engine instance. Calls are executed in submission order on a dedicated thread
+ * instead of the shared libuv pool, and all completions go back to js through one threadsafe function.
+ * Only the js thread submits and completes, only the worker executes, so the ring is lock free: a context
+ * stays in its slot from Submit until its completion has been delivered.
+ * Calls still pending when the worker stops are rejected with a system error.
+ */
+class NapiWorker {
+public:
+    ~NapiWorker();
+
+    static std::shared_ptr<NapiWorker> Create(napi_env env, const std::string &name);
+    napi_value Submit(napi_env env, std::shared_ptr<AsyncContext> context, AsyncExecute execute,
+        napi_async_complete_callback complete = nullptr);
+
+private:
+    NapiWorker() = default;
+    bool Start(napi_env env, const std::string &name);
+    void Stop();
+    void Run();
+    void DeliverCompletions(napi_env env);
+    static void CallJs(napi_env env, napi_value jsCallback, void *context, void *data);
+    static void RejectContext(napi_env env, AsyncContext *context);
+
+    static constexpr uint32_t QUEUE_CAPACITY = 64;
+    std::array<AsyncContext *, QUEUE_CAPACITY> ring_ = {};
+    // [completed_, head_) executed and waiting for delivery, [head_, tail_) waiting for execution
+    uint32_t completed_ = 0;
+    std::atomic<uint32_t> head_ { 0 };
+    std::atomic<uint32_t> tail_ { 0 };
+    std::atomic<bool> isRunning_ { false };
+    bool isSemInited_ = false;
+    sem_t sem_;
+    std::thread thread_;
+    napi_env env_ = nullptr;
+    napi_threadsafe_function tsfn_ = nullptr;
+};
+
+/*
+ * Recycles async contexts of one type. Contexts are acquired and returned on the js thread only:
+ * the last reference is dropped when the completion has been delivered.
+ */
+template<typename T>
+class AsyncContextPool : public std::enable_shared_from_this<AsyncContextPool<T>> {
+public:
+    explicit AsyncContextPool(size_t maxIdle) : maxIdle_(maxIdle) {}
+
+    std::shared_ptr<T> Acquire(napi_env env)
+    {
+        T *context = nullptr;
+        if (!idle_.empty()) {
+            context = idle_.back().release();
+            idle_.pop_back();
+        } else {
+            context = new (std::nothrow) T(env);
+        }
+        if (context == nullptr) {
+            return nullptr;
+        }
+
+        std::weak_ptr<AsyncContextPool<T>> weakPool = this->shared_from_this();
+        return std::shared_ptr<T>(context, [weakPool](T *ctx) {
+            auto pool = weakPool.lock();
+            if ((pool == nullptr) || (pool->idle_.size() >= pool->maxIdle_)) {
+                delete ctx;
+                return;
+            }
+            ctx->Recycle();
+            pool->idle_.emplace_back(ctx);
+        });
+    }
+
+private:
+    size_t maxIdle_ = 0;
+    std::vector<std::unique_ptr<T>> idle_;
+};
+}  // namespace IntellVoiceNapi
+}  // namespace OHOS
+#endif
@@ -22,6 +22,7 @@
 #include "intell_voice_common_napi.h"
 #include "intell_voice_napi_util.h"
 #include "intell_voice_napi_queue.h"
+#include "audio_data_callback_napi.h"
 
 #include "intell_voice_log.h"
 #include "i_intell_voice_engine_callback.h"
@@ -40,6 +41,13 @@ static constexpr uint32_t MAX_CHANNEL_CNT = 4;
 
 static const std::string WAKEUP_ENGINE_NAPI_CLASS_NAME = "WakeupIntelligentVoiceEngine";
 static const std::string INTELL_VOICE_EVENT_CALLBACK_NAME = "wakeupIntelligentVoiceEvent";
+static constexpr size_t MAX_IDLE_READ_CONTEXT = 4;
+
+class ReadAudioContext : public AsyncContext {
+public:
+    explicit ReadAudioContext(napi_env napiEnv) : AsyncContext(napiEnv) {};
+    std::vector<uint8_t> data;
+};
 
 WakeupIntellVoiceEngineNapi::WakeupIntellVoiceEngineNapi()
 {
@@ -49,6 +57,8 @@ WakeupIntellVoiceEngineNapi::WakeupIntellVoiceEngineNapi()
 WakeupIntellVoiceEngineNapi::~WakeupIntellVoiceEngineNapi()
 {
     INTELL_VOICE_LOG_INFO("enter");
+    // queued calls use engine_, drain the worker before the members go away
+    worker_ = nullptr;
     if (wrapper_ != nullptr) {
         napi_delete_reference(env_, wrapper_);
     }
@@ -74,6 +84,8 @@ napi_value WakeupIntellVoiceEngineNapi::Export(napi_env env, napi_value exports)
         DECLARE_NAPI_FUNCTION("startCapturer", StartCapturer),
         DECLARE_NAPI_FUNCTION("read", Read),
         DECLARE_NAPI_FUNCTION("stopCapturer", StopCapturer),
+        DECLARE_NAPI_FUNCTION("onAudioData", OnAudioData),
+        DECLARE_NAPI_FUNCTION("offAudioData", OffAudioData),
         DECLARE_NAPI_FUNCTION("getPcm", GetPcm),
     };
 
@@ -151,6 +163,12 @@ napi_value WakeupIntellVoiceEngineNapi::Construct(napi_env env, napi_callback_in
         return undefinedResult;
     }
 
+    engineNapi->worker_ = NapiWorker::Create(env, "WakeupNapiWorker");
+    if (engineNapi->worker_ == nullptr) {
+        INTELL_VOICE_LOG_WARN("create worker failed, use the shared async work pool");
+    }
+    engineNapi->readContextPool_ = std::make_shared<AsyncContextPool<ReadAudioContext>>(MAX_IDLE_READ_CONTEXT);
+
     status = napi_wrap(env, jsThis, static_cast<void *>(engineNapi.get()), WakeupIntellVoiceEngineNapi::Destruct,
         nullptr, &(engineNapi->wrapper_));
     if (status == napi_ok) {
@@ -235,7 +253,7 @@ napi_value WakeupIntellVoiceEngineNapi::GetSupportedRegions(napi_env env, napi_c
         napi_set_element(env, result, 0, SetValue(env, "CN"));
     };
 
-    return NapiAsync::AsyncWork(env, context, "GetSupportedRegions", execute);
+    return QueueWork(env, context, "GetSupportedRegions", execute);
 }
 
 napi_value WakeupIntellVoiceEngineNapi::SetParameter(napi_env env, napi_callback_info info)
@@ -270,14 +288,14 @@ napi_value WakeupIntellVoiceEngineNapi::SetParameter(napi_env env, napi_callback
         execute = [](napi_env env, void *data) {
             CHECK_CONDITION_RETURN_VOID((data == nullptr), "data is nullptr");
             auto asyncContext = static_cast<SetParameterContext *>(data);
-            auto engine = reinterpret_cast<WakeupIntellVoiceEngineNapi *>(asyncContext->instanceNapi_)->engine_;
+            auto engine = reinterpret_cast<WakeupIntellVoiceEngineNapi *>(asyncContext->instanceNapi_)->GetEngine();
             CHECK_CONDITION_RETURN_VOID((engine == nullptr), "get engine instance failed");
             engine->SetParameter(asyncContext->key, asyncContext->value);
         };
     } else {
         execute = [](napi_env env, void *data) {};
     }
-    return NapiAsync::AsyncWork(env, context, "SetParameter", execute);
+    return QueueWork(env, context, "SetParameter", execute);
 }
 
 napi_value WakeupIntellVoiceEngineNapi::GetParameter(napi_env env, napi_callback_info info)
@@ -312,7 +330,7 @@ napi_value WakeupIntellVoiceEngineNapi::GetParameter(napi_env env, napi_callback
         execute = [](napi_env env, void *data) {
             CHECK_CONDITION_RETURN_VOID((data == nullptr), "data is nullptr");
             auto asyncContext = reinterpret_cast<GetParamContext *>(data);
-            auto engine = reinterpret_cast<WakeupIntellVoiceEngineNapi *>(asyncContext->instanceNapi_)->engine_;
+            auto engine = reinterpret_cast<WakeupIntellVoiceEngineNapi *>(asyncContext->instanceNapi_)->GetEngine();
             CHECK_CONDITION_RETURN_VOID((engine == nullptr), "get engine instance failed");
             asyncContext->value = engine->GetParameter(asyncContext->key);
         };
@@ -326,7 +344,7 @@ napi_value WakeupIntellVoiceEngineNapi::GetParameter(napi_env env, napi_callback
         execute = [](napi_env env, void *data) {};
     }
 
-    return NapiAsync::AsyncWork(env, context, "GetParameter", execute);
+    return QueueWork(env, context, "GetParameter", execute);
 }
 
 napi_value WakeupIntellVoiceEngineNapi::SetSensibility(napi_env env, napi_callback_info info)
@@ -358,12 +376,12 @@ napi_value WakeupIntellVoiceEngineNapi::SetSensibility(napi_env env, napi_callba
         CHECK_CONDITION_RETURN_VOID((data == nullptr), "data is nullptr");
         auto asyncContext = static_cast<SetSensibilityContext *>(data);
         CHECK_CONDITION_RETURN_VOID((asyncContext->result_ != NAPI_INTELLIGENT_VOICE_SUCCESS), "no need to execute");
-        auto engine = reinterpret_cast<WakeupIntellVoiceEngineNapi *>(asyncContext->instanceNapi_)->engine_;
+        auto engine = reinterpret_cast<WakeupIntellVoiceEngineNapi *>(asyncContext->instanceNapi_)->GetEngine();
         CHECK_CONDITION_RETURN_VOID((engine == nullptr), "get engine instance failed");
         engine->SetSensibility(asyncContext->sensibility);
     };
 
-    return NapiAsync::AsyncWork(env, context, "SetSensibility", execute);
+    return QueueWork(env, context, "SetSensibility", execute);
 }
 
 napi_value WakeupIntellVoiceEngineNapi::SetWakeupHapInfo(napi_env env, napi_callback_info info)
@@ -402,12 +420,12 @@ napi_value WakeupIntellVoiceEngineNapi::SetWakeupHapInfo(napi_env env, napi_call
         CHECK_CONDITION_RETURN_VOID((data == nullptr), "data is nullptr");
         auto asyncContext = static_cast<SetWakeupHapContext *>(data);
         CHECK_CONDITION_RETURN_VOID((asyncContext->result_ != NAPI_INTELLIGENT_VOICE_SUCCESS), "no need to execute");
-        auto engine = reinterpret_cast<WakeupIntellVoiceEngineNapi *>(asyncContext->instanceNapi_)->engine_;
+        auto engine = reinterpret_cast<WakeupIntellVoiceEngineNapi *>(asyncContext->instanceNapi_)->GetEngine();
         CHECK_CONDITION_RETURN_VOID((engine == nullptr), "get engine instance failed");
         engine->SetWakeupHapInfo(asyncContext->hapInfo);
     };
 
-    return NapiAsync::AsyncWork(env, context, "SetWakeupHapInfo", execute);
+    return QueueWork(env, context, "SetWakeupHapInfo", execute);
 }
 
 napi_value WakeupIntellVoiceEngineNapi::Release(napi_env env, napi_callback_info info)
@@ -427,13 +445,13 @@ napi_value WakeupIntellVoiceEngineNapi::Release(napi_env env, napi_callback_info
         CHECK_CONDITION_RETURN_VOID((data == nullptr), "data is nullptr");
         auto asyncContext = static_cast<AsyncContext *>(data);
         CHECK_CONDITION_RETURN_VOID((asyncContext->result_ != NAPI_INTELLIGENT_VOICE_SUCCESS), "no need to execute");
-        auto engine = reinterpret_cast<WakeupIntellVoiceEngineNapi *>(asyncContext->instanceNapi_)->engine_;
+        auto engine = reinterpret_cast<WakeupIntellVoiceEngineNapi *>(asyncContext->instanceNapi_)->GetEngine();
         CHECK_CONDITION_RETURN_VOID((engine == nullptr), "get engine instance failed");
         engine->Release();
-        reinterpret_cast<WakeupIntellVoiceEngineNapi *>(asyncContext->instanceNapi_)->engine_ = nullptr;
+        reinterpret_cast<WakeupIntellVoiceEngineNapi *>(asyncContext->instanceNapi_)->ResetEngine();
     };
 
-    return NapiAsync::AsyncWork(env, context, "Release", execute);
+    return QueueUrgentWork(env, context, "Release", execute);
 }
 
 napi_value WakeupIntellVoiceEngineNapi::On(napi_env env, napi_callback_info info)
@@ -500,7 +518,8 @@ napi_value WakeupIntellVoiceEngineNapi::RegisterCallback(napi_env env, napi_valu
         return result;
     }
 
-    if (engineNapi->engine_ == nullptr) {
+    auto engine = engineNapi->GetEngine();
+    if (engine == nullptr) {
         INTELL_VOICE_LOG_ERROR("engine is null");
         IntellVoiceCommonNapi::ThrowError(env, NAPI_INTELLIGENT_VOICE_PERMISSION_DENIED);
         return result;
@@ -513,7 +532,7 @@ napi_value WakeupIntellVoiceEngineNapi::RegisterCallback(napi_env env, napi_valu
         return result;
     }
     engineNapi->callbackNapi_->SaveCallbackReference(args[ARG_INDEX_1]);
-    engineNapi->engine_->SetCallback(engineNapi->callbackNapi_);
+    engine->SetCallback(engineNapi->callbackNapi_);
     INTELL_VOICE_LOG_INFO("Set callback finish");
     return result;
 }
@@ -633,7 +652,7 @@ napi_value WakeupIntellVoiceEngineNapi::StartCapturer(napi_env env, napi_callbac
         execute = [](napi_env env, void *data) {
             CHECK_CONDITION_RETURN_VOID((data == nullptr), "data is nullptr");
             auto asyncContext = static_cast<StartCapturerContext *>(data);
-            auto engine = reinterpret_cast<WakeupIntellVoiceEngineNapi *>(asyncContext->instanceNapi_)->engine_;
+            auto engine = reinterpret_cast<WakeupIntellVoiceEngineNapi *>(asyncContext->instanceNapi_)->GetEngine();
             if (engine == nullptr) {
                 INTELL_VOICE_LOG_ERROR("get engine instance failed");
                 asyncContext->result_ = NAPI_INTELLIGENT_VOICE_START_CAPTURER_FAILED;
@@ -646,7 +665,7 @@ napi_value WakeupIntellVoiceEngineNapi::StartCapturer(napi_env env, napi_callbac
         execute = [](napi_env env, void *data) {};
     }
 
-    return NapiAsync::AsyncWork(env, context, "StartCapturer", execute);
+    return QueueWork(env, context, "StartCapturer", execute);
 }
 
 napi_value WakeupIntellVoiceEngineNapi::Read(napi_env env, napi_callback_info info)
@@ -654,14 +673,9 @@ napi_value WakeupIntellVoiceEngineNapi::Read(napi_env env, napi_callback_info in
     napi_value undefined = nullptr;
     napi_get_undefined(env, &undefined);
 
-    class GetAudioContext : public AsyncContext {
-    public:
-        explicit GetAudioContext(napi_env napiEnv) : AsyncContext(napiEnv) {};
-        std::vector<uint8_t> data;
-    };
-
-    shared_ptr<GetAudioContext> context = make_shared<GetAudioContext>(env);
+    shared_ptr<ReadAudioContext> context = AcquireReadContext(env, info);
     CHECK_CONDITION_RETURN_RET(context == nullptr, undefined, "create context fail");
+    context->data.clear();
 
     context->result_ = (context->GetCbInfo(env, info, 0, nullptr) ? NAPI_INTELLIGENT_VOICE_SUCCESS :
         NAPI_INTELLIGENT_VOICE_INVALID_PARAM);
@@ -670,8 +684,8 @@ napi_value WakeupIntellVoiceEngineNapi::Read(napi_env env, napi_callback_info in
     if (context->result_ == NAPI_INTELLIGENT_VOICE_SUCCESS) {
         execute = [](napi_env env, void *data) {
             CHECK_CONDITION_RETURN_VOID((data == nullptr), "data is nullptr");
-            auto asyncContext = static_cast<GetAudioContext *>(data);
-            auto engine = reinterpret_cast<WakeupIntellVoiceEngineNapi *>(asyncContext->instanceNapi_)->engine_;
+            auto asyncContext = static_cast<ReadAudioContext *>(data);
+            auto engine = reinterpret_cast<WakeupIntellVoiceEngineNapi *>(asyncContext->instanceNapi_)->GetEngine();
             if (engine == nullptr) {
                 INTELL_VOICE_LOG_ERROR("get engine instance failed");
                 asyncContext->result_ = NAPI_INTELLIGENT_VOICE_READ_FAILED;
@@ -688,12 +702,12 @@ napi_value WakeupIntellVoiceEngineNapi::Read(napi_env env, napi_callback_info in
 
     context->complete_ = [](napi_env env, AsyncContext *asyncContext, napi_value &result) {
         CHECK_CONDITION_RETURN_VOID((asyncContext == nullptr), "async context is null");
-        auto context = static_cast<GetAudioContext *>(asyncContext);
-        result = SetValue(env, context->data);
+        auto context = static_cast<ReadAudioContext *>(asyncContext);
+        result = CreateExternalArrayBuffer(env, std::move(context->data));
         vector<uint8_t>().swap(context->data);
     };
 
-    return NapiAsync::AsyncWork(env, context, "Read", execute);
+    return QueueWork(env, context, "Read", execute);
 }
 
 napi_value WakeupIntellVoiceEngineNapi::StopCapturer(napi_env env, napi_callback_info info)
@@ -714,7 +728,7 @@ napi_value WakeupIntellVoiceEngineNapi::StopCapturer(napi_env env, napi_callback
         execute = [](napi_env env, void *data) {
             CHECK_CONDITION_RETURN_VOID((data == nullptr), "data is nullptr");
             auto asyncContext = static_cast<AsyncContext *>(data);
-            auto engine = reinterpret_cast<WakeupIntellVoiceEngineNapi *>(asyncContext->instanceNapi_)->engine_;
+            auto engine = reinterpret_cast<WakeupIntellVoiceEngineNapi *>(asyncContext->instanceNapi_)->GetEngine();
             CHECK_CONDITION_RETURN_VOID((engine == nullptr), "get engine instance failed");
             engine->StopCapturer();
         };
@@ -722,7 +736,142 @@ napi_value WakeupIntellVoiceEngineNapi::StopCapturer(napi_env env, napi_callback
         execute = [](napi_env env, void *data) {};
     }
 
-    return NapiAsync::AsyncWork(env, context, "StopCapturer", execute);
+    return QueueUrgentWork(env, context, "StopCapturer", execute);
+}
+
+napi_value WakeupIntellVoiceEngineNapi::QueueWork(napi_env env, std::shared_ptr<AsyncContext> context,
+    const std::string &name, AsyncExecute execute)
+{
+    auto engineNapi = reinterpret_cast<WakeupIntellVoiceEngineNapi *>(context->instanceNapi_);
+    if ((engineNapi == nullptr) || (engineNapi->worker_ == nullptr)) {
+        return NapiAsync::AsyncWork(env, context, name, execute);
+    }
+    return engineNapi->worker_->Submit(env, context, execute);
+}
+
+napi_value WakeupIntellVoiceEngineNapi::QueueUrgentWork(napi_env env, std::shared_ptr<AsyncContext> context,
+    const std::string &name, AsyncExecute execute)
+{
+    return NapiAsync::AsyncWork(env, context, name, execute);
+}
+
+std::shared_ptr<WakeupIntellVoiceEngine> WakeupIntellVoiceEngineNapi::GetEngine()
+{
+    std::lock_guard<std::mutex> lock(engineMutex_);
+    return engine_;
+}
+
+void WakeupIntellVoiceEngineNapi::ResetEngine()
+{
+    std::lock_guard<std::mutex> lock(engineMutex_);
+    engine_ = nullptr;
+}
+
+std::shared_ptr<ReadAudioContext> WakeupIntellVoiceEngineNapi::AcquireReadContext(napi_env env,
+    napi_callback_info info)
+{
+    napi_value jsThis = nullptr;
+    WakeupIntellVoiceEngineNapi *engineNapi = nullptr;
+    if ((napi_get_cb_info(env, info, nullptr, nullptr, &jsThis, nullptr) == napi_ok) &&
+        (napi_unwrap(env, jsThis, reinterpret_cast<void **>(&engineNapi)) == napi_ok) &&
+        (engineNapi != nullptr) && (engineNapi->readContextPool_ != nullptr)) {
+        return engineNapi->readContextPool_->Acquire(env);
+    }
+    return std::make_shared<ReadAudioContext>(env);
+}
+
+napi_value WakeupIntellVoiceEngineNapi::OnAudioData(napi_env env, napi_callback_info info)
+{
+    INTELL_VOICE_LOG_INFO("enter");
+    napi_value undefinedResult = nullptr;
+    napi_get_undefined(env, &undefinedResult);
+
+    size_t argCount = ARGC_TWO;
+    napi_value args[ARGC_TWO] = { nullptr, nullptr };
+    napi_value jsThis = nullptr;
+    napi_status status = napi_get_cb_info(env, info, &argCount, args, &jsThis, nullptr);
+    if (status != napi_ok || argCount != ARGC_TWO) {
+        INTELL_VOICE_LOG_ERROR("failed to get parameters");
+        IntellVoiceCommonNapi::ThrowError(env, NAPI_INTELLIGENT_VOICE_INVALID_PARAM);
+        return undefinedResult;
+    }
+
+    napi_valuetype handler = napi_undefined;
+    if (napi_typeof(env, args[ARG_INDEX_0], &handler) != napi_ok || handler != napi_function) {
+        INTELL_VOICE_LOG_ERROR("callback handler type mismatch");
+        IntellVoiceCommonNapi::ThrowError(env, NAPI_INTELLIGENT_VOICE_INVALID_PARAM);
+        return undefinedResult;
+    }
+
+    int32_t framesPerCallback = 0;
+    if ((GetValue(env, args[ARG_INDEX_1], framesPerCallback) != napi_ok) || (framesPerCallback <= 0) ||
+        (static_cast<uint32_t>(framesPerCallback) > MAX_AUDIO_FRAMES_PER_CALLBACK)) {
+        INTELL_VOICE_LOG_ERROR("frames per callback is invalid");
+        IntellVoiceCommonNapi::ThrowError(env, NAPI_INTELLIGENT_VOICE_INVALID_PARAM);
+        return undefinedResult;
+    }
+
+    WakeupIntellVoiceEngineNapi *engineNapi = nullptr;
+    status = napi_unwrap(env, jsThis, reinterpret_cast<void **>(&engineNapi));
+    auto engine = (engineNapi == nullptr) ? nullptr : engineNapi->GetEngine();
+    if (status != napi_ok || engine == nullptr) {
+        INTELL_VOICE_LOG_ERROR("Failed to get engine napi instance");
+        IntellVoiceCommonNapi::ThrowError(env, NAPI_INTELLIGENT_VOICE_SYSTEM_ERROR);
+        return undefinedResult;
+    }
+
+    auto callbackNapi = AudioDataCallbackNapi::Create(env, args[ARG_INDEX_0]);
+    if (callbackNapi == nullptr) {
+        IntellVoiceCommonNapi::ThrowError(env, NAPI_INTELLIGENT_VOICE_NO_MEMORY);
+        return undefinedResult;
+    }
+
+    // the pump thread owns the callback, so the threadsafe function is released when the pump exits
+    int32_t ret = engine->SubscribeAudioData([callbackNapi](std::vector<uint8_t> &data) -> bool {
+        return callbackNapi->OnAudioData(data);
+    }, static_cast<uint32_t>(framesPerCallback));
+    if (ret != 0) {
+        INTELL_VOICE_LOG_ERROR("failed to subscribe audio data");
+        IntellVoiceCommonNapi::ThrowError(env, NAPI_INTELLIGENT_VOICE_SYSTEM_ERROR);
+    }
+    return undefinedResult;
+}
+
+napi_value WakeupIntellVoiceEngineNapi::OffAudioData(napi_env env, napi_callback_info info)
+{
+    INTELL_VOICE_LOG_INFO("enter");
+    napi_value undefined = nullptr;
+    napi_get_undefined(env, &undefined);
+
+    auto context = make_shared<AsyncContext>(env);
+    CHECK_CONDITION_RETURN_RET(context == nullptr, undefined, "create context fail");
+
+    context->result_ = (context->GetCbInfo(env, info, 0, nullptr) ? NAPI_INTELLIGENT_VOICE_SUCCESS :
+        NAPI_INTELLIGENT_VOICE_INVALID_PARAM);
+
+    AsyncExecute execute;
+    if (context->result_ == NAPI_INTELLIGENT_VOICE_SUCCESS) {
+        auto engine = reinterpret_cast<WakeupIntellVoiceEngineNapi *>(context->instanceNapi_)->GetEngine();
+        if (engine != nullptr) {
+            // no more batches are queued from here on, the pump is reaped off the js thread
+            engine->RequestAudioDataStop();
+        }
+        execute = [](napi_env env, void *data) {
+            CHECK_CONDITION_RETURN_VOID((data == nullptr), "data is nullptr");
+            auto asyncContext = static_cast<AsyncContext *>(data);
+            auto engine = reinterpret_cast<WakeupIntellVoiceEngineNapi *>(asyncContext->instanceNapi_)->GetEngine();
+            if (engine == nullptr) {
+                INTELL_VOICE_LOG_ERROR("get engine instance failed");
+                asyncContext->result_ = NAPI_INTELLIGENT_VOICE_SYSTEM_ERROR;
+                return;
+            }
+            engine->UnsubscribeAudioData();
+        };
+    } else {
+        execute = [](napi_env env, void *data) {};
+    }
+
+    return QueueUrgentWork(env, context, "OffAudioData", execute);
 }
 
 napi_value WakeupIntellVoiceEngineNapi::GetPcm(napi_env env, napi_callback_info info)
@@ -748,7 +897,7 @@ napi_value WakeupIntellVoiceEngineNapi::GetPcm(napi_env env, napi_callback_info
         execute = [](napi_env env, void *data) {
             CHECK_CONDITION_RETURN_VOID((data == nullptr), "data is nullptr");
             auto asyncContext = static_cast<GetPcmContext *>(data);
-            auto engine = reinterpret_cast<WakeupIntellVoiceEngineNapi *>(asyncContext->instanceNapi_)->engine_;
+            auto engine = reinterpret_cast<WakeupIntellVoiceEngineNapi *>(asyncContext->instanceNapi_)->GetEngine();
             if (engine == nullptr) {
                 INTELL_VOICE_LOG_ERROR("get engine instance failed");
                 asyncContext->result_ = NAPI_INTELLIGENT_VOICE_NO_MEMORY;
@@ -766,11 +915,11 @@ napi_value WakeupIntellVoiceEngineNapi::GetPcm(napi_env env, napi_callback_info
     context->complete_ = [](napi_env env, AsyncContext *asyncContext, napi_value &result) {
         CHECK_CONDITION_RETURN_VOID((asyncContext == nullptr), "async context is null");
         auto context = static_cast<GetPcmContext *>(asyncContext);
-        result = SetValue(env, context->data);
+        result = CreateExternalArrayBuffer(env, std::move(context->data));
         vector<uint8_t>().swap(context->data);
     };
 
-    return NapiAsync::AsyncWork(env, context, "GetPcm", execute);
+    return QueueWork(env, context, "GetPcm", execute);
 }
 
 }  // namespace IntellVoiceNapi
@@ -15,15 +15,18 @@
 #ifndef WAKEUP_INTELL_VOICE_ENGINE_NAPI_H
 #define WAKEUP_INTELL_VOICE_ENGINE_NAPI_H
 
+#include <mutex>
 #include "napi/native_api.h"
 #include "napi/native_node_api.h"
 #include "engine_event_callback_napi.h"
+#include "intell_voice_napi_worker.h"
 #include "wakeup_intell_voice_engine.h"
 
 namespace OHOS {
 namespace IntellVoiceNapi {
 using OHOS::IntellVoice::WakeupIntellVoiceEngine;
 using OHOS::IntellVoice::WakeupIntelligentVoiceEngineDescriptor;
+class ReadAudioContext;
 
 class WakeupIntellVoiceEngineNapi {
 public:
@@ -48,19 +51,33 @@ private:
     static napi_value StartCapturer(napi_env env, napi_callback_info info);
     static napi_value Read(napi_env env, napi_callback_info info);
     static napi_value StopCapturer(napi_env env, napi_callback_info info);
+    static napi_value OnAudioData(napi_env env, napi_callback_info info);
+    static napi_value OffAudioData(napi_env env, napi_callback_info info);
     static napi_value GetPcm(napi_env env, napi_callback_info info);
 
     static napi_value RegisterCallback(napi_env env, napi_value jsThis, napi_value *args);
     static napi_value UnregisterCallback(napi_env env, napi_value jsThis, const std::string &callbackName,
         napi_value callback);
+    static napi_value QueueWork(napi_env env, std::shared_ptr<AsyncContext> context, const std::string &name,
+        AsyncExecute execute);
+    // for calls that cut capture short: they run on the shared pool instead of waiting behind a pending read
+    static napi_value QueueUrgentWork(napi_env env, std::shared_ptr<AsyncContext> context, const std::string &name,
+        AsyncExecute execute);
+    static std::shared_ptr<ReadAudioContext> AcquireReadContext(napi_env env, napi_callback_info info);
+    std::shared_ptr<WakeupIntellVoiceEngine> GetEngine();
+    void ResetEngine();
 
 private:
     napi_env env_ = nullptr;
     napi_ref wrapper_ = nullptr;
     static WakeupIntelligentVoiceEngineDescriptor g_wakeupEngineDesc_;
     static int32_t constructResult_;
+    // release resets it on the shared pool while queued calls may still use it
+    std::mutex engineMutex_;
     std::shared_ptr<WakeupIntellVoiceEngine> engine_ = nullptr;
     std::shared_ptr<EngineEventCallbackNapi> callbackNapi_ = nullptr;
+    std::shared_ptr<NapiWorker> worker_ = nullptr;
+    std::shared_ptr<AsyncContextPool<ReadAudioContext>> readContextPool_ = nullptr;
 };
 }  // namespace IntellVoiceNapi
 }  // namespace OHOS
@@ -41,7 +41,7 @@ class UploadFilesContext : public AsyncContext {
 public:
     explicit UploadFilesContext(napi_env env) : AsyncContext(env) {};
     int numMax = 0;
-    std::vector<OHOS::IntellVoice::UploadFilesInfo> uploadFiles;
+    std::vector<OHOS::IntellVoice::UploadFilesViewInfo> uploadFiles;
 };
 
 static __thread napi_ref g_wakeupManagerConstructor = nullptr;
@@ -330,9 +330,9 @@ napi_value WakeupManagerNapi::GetUploadFiles(napi_env env, napi_callback_info in
                 return;
             }
 
-            std::vector<UploadFilesInfo>().swap(context->uploadFiles);
+            std::vector<UploadFilesViewInfo>().swap(context->uploadFiles);
             context->result_ = IntellVoiceCommonNapi::ConvertResultCode(
-                manager->GetUploadFiles(context->numMax, context->uploadFiles));
+                manager->GetUploadFilesView(context->numMax, context->uploadFiles));
         };
     } else {
         execute = [](napi_env env, void *data) {};
@@ -349,7 +349,7 @@ void WakeupManagerNapi::GetUploadFilesComplete(napi_env env, AsyncContext *data,
     INTELL_VOICE_LOG_INFO("enter");
     auto *context = reinterpret_cast<UploadFilesContext *>(data);
     napi_get_undefined(env, &result);
-    std::vector<UploadFilesInfo> &uploadFiles = context->uploadFiles;
+    std::vector<UploadFilesViewInfo> &uploadFiles = context->uploadFiles;
 
     if (uploadFiles.size() == 0) {
         context->result_ = NAPI_INTELLIGENT_VOICE_SYSTEM_ERROR;
@@ -376,7 +376,7 @@ void WakeupManagerNapi::GetUploadFilesComplete(napi_env env, AsyncContext *data,
         }
 
         for (uint32_t j = 0; j < uploadFiles[index].filesContent.size(); j++) {
-            napi_value content = SetValue(env, uploadFiles[index].filesContent[j]);
+            napi_value content = CreateUploadFileArrayBuffer(env, uploadFiles[index].filesContent[j]);
             if (content == nullptr) {
                 context->result_ = NAPI_INTELLIGENT_VOICE_NO_MEMORY;
                 goto EXIT;
@@ -388,7 +388,40 @@ void WakeupManagerNapi::GetUploadFilesComplete(napi_env env, AsyncContext *data,
     }
 
 EXIT:
-    std::vector<UploadFilesInfo>().swap(uploadFiles);
+    std::vector<UploadFilesViewInfo>().swap(uploadFiles);
+}
+
+napi_value WakeupManagerNapi::CreateUploadFileArrayBuffer(napi_env env, const std::shared_ptr<UploadFileView> &view)
+{
+    if ((view == nullptr) || (view->Data() == nullptr)) {
+        INTELL_VOICE_LOG_ERROR("file view is invalid");
+        return nullptr;
+    }
+
+    napi_value result = nullptr;
+    if (!view->IsWritable()) {
+        void *buf = nullptr;
+        if ((napi_create_arraybuffer(env, view->Size(), &buf, &result) != napi_ok) || (buf == nullptr)) {
+            INTELL_VOICE_LOG_ERROR("failed to create array buffer");
+            return nullptr;
+        }
+        std::copy(view->Data(), view->Data() + view->Size(), static_cast<uint8_t *>(buf));
+        return result;
+    }
+
+    // the array buffer shares the mapping and keeps the view alive until it is collected
+    auto holder = new (std::nothrow) std::shared_ptr<UploadFileView>(view);
+    CHECK_CONDITION_RETURN_RET(holder == nullptr, nullptr, "failed to create view holder");
+    napi_status status = napi_create_external_arraybuffer(env, view->Data(), view->Size(),
+        [](napi_env env, void *data, void *hint) {
+            delete static_cast<std::shared_ptr<UploadFileView> *>(hint);
+        }, holder, &result);
+    if (status != napi_ok) {
+        INTELL_VOICE_LOG_ERROR("failed to create external array buffer");
+        delete holder;
+        return nullptr;
+    }
+    return result;
 }
 
 napi_value WakeupManagerNapi::GetWakeupSourceFiles(napi_env env, napi_callback_info info)
@@ -453,7 +486,8 @@ void WakeupManagerNapi::GetCloneCompleteCallback(napi_env env, AsyncContext *dat
             goto EXIT;
         }
         napi_set_named_property(env, obj, "filePath", SetValue(env, files[filesIndex].filePath));
-        napi_set_named_property(env, obj, "fileContent", SetValue(env, files[filesIndex].fileContent));
+        napi_set_named_property(env, obj, "fileContent",
+            CreateExternalArrayBuffer(env, std::move(files[filesIndex].fileContent)));
         napi_set_element(env, result, filesIndex, obj);
     }
 
@@ -41,6 +41,8 @@ private:
     static napi_value GetParameter(napi_env env, napi_callback_info info);
     static napi_value GetUploadFiles(napi_env env, napi_callback_info info);
     static void GetUploadFilesComplete(napi_env env, AsyncContext *data, napi_value &result);
+    static napi_value CreateUploadFileArrayBuffer(napi_env env,
+        const std::shared_ptr<OHOS::IntellVoice::UploadFileView> &view);
     static napi_value GetWakeupSourceFiles(napi_env env, napi_callback_info info);
     static void GetCloneCompleteCallback(napi_env env, AsyncContext *data, napi_value &result);
     static napi_value EnrollWithWakeupFilesForResult(napi_env env, napi_callback_info info);
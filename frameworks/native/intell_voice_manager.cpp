@@ -14,6 +14,7 @@
  */
 #include "intell_voice_manager.h"
 
+#include <algorithm>
 #include <chrono>
 #include "iservice_registry.h"
 #include "system_ability_definition.h"
@@ -166,11 +167,11 @@ int32_t IntellVoiceManager::GetUploadFiles(int numMax, std::vector<UploadFilesIn
         return -1;
     }
     INTELL_VOICE_LOG_INFO("upload files size:%{public}u", static_cast<uint32_t>(hdiFiles.size()));
-    for (auto hdiFile : hdiFiles) {
+    for (auto &hdiFile : hdiFiles) {
         UploadFilesInfo filesInfo;
         filesInfo.type = hdiFile.type;
-        filesInfo.filesDescription = hdiFile.filesDescription;
-        for (auto content : hdiFile.filesContent) {
+        filesInfo.filesDescription = std::move(hdiFile.filesDescription);
+        for (const auto &content : hdiFile.filesContent) {
             if (content == nullptr) {
                 INTELL_VOICE_LOG_ERROR("fileContent is nullptr");
                 continue;
@@ -180,14 +181,53 @@ int32_t IntellVoiceManager::GetUploadFiles(int numMax, std::vector<UploadFilesIn
                 INTELL_VOICE_LOG_ERROR("failed to file data from ashmem");
                 continue;
             }
-            filesInfo.filesContent.push_back(fileData);
+            filesInfo.filesContent.emplace_back(std::move(fileData));
         }
-        files.push_back(filesInfo);
+        files.emplace_back(std::move(filesInfo));
     }
     std::vector<UploadFilesFromHdi>().swap(hdiFiles);
     return 0;
 }
 
+int32_t IntellVoiceManager::GetUploadFilesView(int numMax, std::vector<UploadFilesViewInfo> &files)
+{
+    INTELL_VOICE_LOG_INFO("enter, numMax: %{public}d", numMax);
+    sptr<IIntellVoiceService> proxy = GetServiceProxy();
+    CHECK_CONDITION_RETURN_RET(proxy == nullptr, -1, "IntellVoiceService Proxy is null");
+
+    std::vector<UploadFilesFromHdi> hdiFiles;
+    int32_t ret = proxy->GetUploadFiles(numMax, hdiFiles);
+    if (ret != 0) {
+        INTELL_VOICE_LOG_ERROR("Get upload files failed, ret:%{public}d", ret);
+        return ret;
+    }
+
+    if (hdiFiles.empty()) {
+        INTELL_VOICE_LOG_ERROR("no upload files");
+        return -1;
+    }
+    INTELL_VOICE_LOG_INFO("upload files size:%{public}u", static_cast<uint32_t>(hdiFiles.size()));
+    for (auto &hdiFile : hdiFiles) {
+        UploadFilesViewInfo filesInfo;
+        filesInfo.type = hdiFile.type;
+        filesInfo.filesDescription = std::move(hdiFile.filesDescription);
+        for (const auto &content : hdiFile.filesContent) {
+            if (content == nullptr) {
+                INTELL_VOICE_LOG_ERROR("fileContent is nullptr");
+                continue;
+            }
+            auto view = std::make_shared<UploadFileView>(content);
+            if (view->Map() != 0) {
+                INTELL_VOICE_LOG_ERROR("failed to map file content");
+                continue;
+            }
+            filesInfo.filesContent.emplace_back(std::move(view));
+        }
+        files.emplace_back(std::move(filesInfo));
+    }
+    return 0;
+}
+
 int32_t IntellVoiceManager::GetFileDataFromAshmem(sptr<Ashmem> ashmem, std::vector<uint8_t> &fileData)
 {
     if (ashmem == nullptr) {
@@ -233,6 +273,18 @@ int32_t IntellVoiceManager::SetParameter(const std::string &key, const std::stri
     return g_sProxy->SetParameter(keyValueList);
 }
 
+int32_t IntellVoiceManager::SetParameters(const OHOS::IntellVoiceUtils::ParamBatch &batch)
+{
+    INTELL_VOICE_LOG_INFO("enter, num:%{public}zu", batch.Entries().size());
+    CHECK_CONDITION_RETURN_RET(batch.Empty(), -1, "no parameter");
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (g_sProxy == nullptr) {
+        INTELL_VOICE_LOG_ERROR("IntellVoiceService Proxy is null");
+        return -1;
+    }
+    return g_sProxy->SetParameters(batch);
+}
+
 std::string IntellVoiceManager::GetParameter(const std::string &key)
 {
     INTELL_VOICE_LOG_INFO("enter");
@@ -250,36 +302,149 @@ std::string IntellVoiceManager::GetParameter(const std::string &key)
     return g_sProxy->GetParameter(key);
 }
 
+sptr<IIntellVoiceService> IntellVoiceManager::GetServiceProxy()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    return g_sProxy;
+}
+
 int32_t IntellVoiceManager::GetWakeupSourceFiles(std::vector<WakeupSourceFile> &cloneFileInfo)
 {
     INTELL_VOICE_LOG_INFO("enter");
-    std::unique_lock<std::mutex> lock(mutex_);
-    if (g_sProxy == nullptr) {
-        INTELL_VOICE_LOG_ERROR("IntellVoiceService Proxy is null");
-        return -1;
-    }
+    return StreamWakeupSourceFiles([&cloneFileInfo](const std::string &filePath, const uint8_t *data,
+        uint32_t size) {
+        WakeupSourceFile fileInfo;
+        fileInfo.filePath = filePath;
+        fileInfo.fileContent.assign(data, data + size);
+        cloneFileInfo.emplace_back(std::move(fileInfo));
+        return true;
+    });
+}
+
+int32_t IntellVoiceManager::StreamWakeupSourceFiles(const WakeupSourceFileHandler &onFile, uint32_t maxBatchSize)
+{
+    INTELL_VOICE_LOG_INFO("enter, max batch size:%{public}u", maxBatchSize);
+    CHECK_CONDITION_RETURN_RET(onFile == nullptr, -1, "onFile is nullptr");
+    sptr<IIntellVoiceService> proxy = GetServiceProxy();
+    CHECK_CONDITION_RETURN_RET(proxy == nullptr, -1, "IntellVoiceService Proxy is null");
 
     std::vector<std::string> cloneFiles;
-    int ret = g_sProxy->GetWakeupSourceFilesList(cloneFiles);
+    int32_t ret = proxy->GetWakeupSourceFilesList(cloneFiles);
     if (ret != 0) {
         INTELL_VOICE_LOG_ERROR("get clone list err");
         return -1;
     }
 
-    WakeupSourceFile fileInfo;
-    size_t fileCount = cloneFiles.size();
-    cloneFiles.reserve(fileCount);
+    size_t index = 0;
+    while (index < cloneFiles.size()) {
+        size_t batchNum = std::min(cloneFiles.size() - index, static_cast<size_t>(CLONE_FILES_BATCH_NUM_MAX));
+        std::vector<std::string> batchPaths(cloneFiles.begin() + index, cloneFiles.begin() + index + batchNum);
+        std::vector<uint32_t> fileSizes;
+        sptr<Ashmem> ashmem = nullptr;
+        ret = proxy->GetWakeupSourceFilesBatch(batchPaths, maxBatchSize, fileSizes, ashmem);
+        if ((ret != 0) || fileSizes.empty() || (fileSizes.size() > batchNum) || (ashmem == nullptr)) {
+            INTELL_VOICE_LOG_ERROR("get clone files batch err, index:%{public}zu, ret:%{public}d", index, ret);
+            return -1;
+        }
 
-    for (size_t index = 0; index < fileCount; ++index) {
-        fileInfo.filePath = cloneFiles[index];
-        ret = g_sProxy->GetWakeupSourceFile(cloneFiles[index], fileInfo.fileContent);
+        ret = DispatchFilesFromAshmem(ashmem, batchPaths, fileSizes, onFile);
         if (ret != 0) {
-            INTELL_VOICE_LOG_ERROR("get clone file err");
+            return ret;
+        }
+        index += fileSizes.size();
+    }
+
+    INTELL_VOICE_LOG_INFO("stream clone files finish, num:%{public}zu", cloneFiles.size());
+    return 0;
+}
+
+int32_t IntellVoiceManager::DispatchFilesFromAshmem(sptr<Ashmem> ashmem, const std::vector<std::string> &filePaths,
+    const std::vector<uint32_t> &fileSizes, const WakeupSourceFileHandler &onFile)
+{
+    ON_SCOPE_EXIT {
+        ashmem->UnmapAshmem();
+        ashmem->CloseAshmem();
+    };
+
+    uint64_t totalSize = static_cast<uint64_t>(ashmem->GetAshmemSize());
+    if ((totalSize == 0) || !ashmem->MapReadOnlyAshmem()) {
+        INTELL_VOICE_LOG_ERROR("map ashmem failed");
+        return -1;
+    }
+
+    uint64_t offset = 0;
+    for (size_t i = 0; i < fileSizes.size(); ++i) {
+        if ((i >= filePaths.size()) || (offset + fileSizes[i] > totalSize)) {
+            INTELL_VOICE_LOG_ERROR("invalid file size, index:%{public}zu", i);
             return -1;
         }
-        cloneFileInfo.push_back(fileInfo);
+        // an empty file takes no room in the region
+        const uint8_t *data = (fileSizes[i] == 0) ? nullptr :
+            static_cast<const uint8_t *>(ashmem->ReadFromAshmem(fileSizes[i], offset));
+        if ((data == nullptr) && (fileSizes[i] != 0)) {
+            INTELL_VOICE_LOG_ERROR("read from ashmem failed");
+            return -1;
+        }
+        if (!onFile(filePaths[i], data, fileSizes[i])) {
+            INTELL_VOICE_LOG_WARN("stream clone files is stopped by caller");
+            return -1;
+        }
+        offset += fileSizes[i];
     }
+    return 0;
+}
 
+int32_t IntellVoiceManager::SendWakeupFilesInBatches(sptr<IIntellVoiceService> proxy,
+    const std::vector<WakeupSourceFile> &cloneFileInfo, uint32_t maxBatchSize)
+{
+    size_t index = 0;
+    while (index < cloneFileInfo.size()) {
+        std::vector<std::string> filePaths;
+        std::vector<uint32_t> fileSizes;
+        uint64_t totalSize = 0;
+        size_t end = index;
+        // at least one file per batch, a file larger than the batch size is sent alone
+        while ((end < cloneFileInfo.size()) && (end - index < CLONE_FILES_BATCH_NUM_MAX) && ((end == index) ||
+            (totalSize + cloneFileInfo[end].fileContent.size() <= maxBatchSize))) {
+            const auto &content = cloneFileInfo[end].fileContent;
+            if (content.size() > CLONE_FILES_BATCH_SIZE_MAX) {
+                INTELL_VOICE_LOG_ERROR("invalid clone file size, index:%{public}zu", end);
+                return -1;
+            }
+            filePaths.push_back(cloneFileInfo[end].filePath);
+            fileSizes.push_back(static_cast<uint32_t>(content.size()));
+            totalSize += content.size();
+            ++end;
+        }
+
+        // ashmem cannot be empty, a batch of empty files still maps one byte
+        sptr<Ashmem> ashmem = Ashmem::CreateAshmem("CloneFilesBatch",
+            static_cast<int32_t>(std::max<uint64_t>(totalSize, 1)));
+        CHECK_CONDITION_RETURN_RET(ashmem == nullptr, -1, "failed to create ashmem");
+        ON_SCOPE_EXIT {
+            ashmem->UnmapAshmem();
+            ashmem->CloseAshmem();
+        };
+        CHECK_CONDITION_RETURN_RET(!ashmem->MapReadAndWriteAshmem(), -1, "failed to map ashmem");
+
+        uint32_t offset = 0;
+        for (size_t i = index; i < end; ++i) {
+            const auto &content = cloneFileInfo[i].fileContent;
+            if (!content.empty() && !ashmem->WriteToAshmem(content.data(), content.size(), offset)) {
+                INTELL_VOICE_LOG_ERROR("failed to write ashmem, index:%{public}zu", i);
+                return -1;
+            }
+            offset += static_cast<uint32_t>(content.size());
+        }
+
+        int32_t ret = proxy->SendWakeupFilesBatch(filePaths, fileSizes, ashmem);
+        if (ret != 0) {
+            INTELL_VOICE_LOG_ERROR("send clone files batch err, index:%{public}zu, size:%{public}zu, ret:%{public}d",
+                index, cloneFileInfo.size(), ret);
+            return -1;
+        }
+        index = end;
+    }
     return 0;
 }
 
@@ -287,22 +452,17 @@ int32_t IntellVoiceManager::EnrollWithWakeupFilesForResult(const std::vector<Wak
     const std::string &wakeupInfo, const shared_ptr<IIntellVoiceUpdateCallback> callback)
 {
     INTELL_VOICE_LOG_INFO("enter");
-    std::unique_lock<std::mutex> lock(mutex_);
-    if (g_sProxy == nullptr) {
+    sptr<IIntellVoiceService> proxy = GetServiceProxy();
+    if (proxy == nullptr) {
         INTELL_VOICE_LOG_ERROR("IntellVoiceService proxy is null");
         return -1;
     }
 
-    size_t fileCount = cloneFileInfo.size();
-    for (size_t index = 0; index < fileCount; ++index) {
-        int ret = g_sProxy->SendWakeupFile(cloneFileInfo[index].filePath, cloneFileInfo[index].fileContent);
-        if (ret != 0) {
-            INTELL_VOICE_LOG_ERROR("send clone file err, index:%{public}zu, size:%{public}zu, ret:%{public}d",
-                index, fileCount, ret);
-            return -1;
-        }
+    if (SendWakeupFilesInBatches(proxy, cloneFileInfo, CLONE_FILES_BATCH_SIZE_DEFAULT) != 0) {
+        return -1;
     }
 
+    std::unique_lock<std::mutex> lock(mutex_);
     callback_ = sptr<UpdateCallbackInner>(new (std::nothrow) UpdateCallbackInner());
     if (callback_ == nullptr) {
         INTELL_VOICE_LOG_ERROR("callback_ is nullptr");
@@ -310,7 +470,7 @@ int32_t IntellVoiceManager::EnrollWithWakeupFilesForResult(const std::vector<Wak
     }
     callback_->SetUpdateCallback(callback);
 
-    return g_sProxy->EnrollWithWakeupFilesForResult(wakeupInfo, callback_->AsObject());
+    return proxy->EnrollWithWakeupFilesForResult(wakeupInfo, callback_->AsObject());
 }
 
 int32_t IntellVoiceManager::ClearUserData()
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "upload_file_view.h"
+
+#include <sys/mman.h>
+#include "intell_voice_log.h"
+
+#define LOG_TAG "UploadFileView"
+
+namespace OHOS {
+namespace IntellVoice {
+UploadFileView::UploadFileView(sptr<Ashmem> ashmem) : ashmem_(ashmem)
+{
+}
+
+UploadFileView::~UploadFileView()
+{
+    if (data_ != nullptr) {
+        munmap(data_, size_);
+        data_ = nullptr;
+    }
+    if (ashmem_ != nullptr) {
+        ashmem_->CloseAshmem();
+        ashmem_ = nullptr;
+    }
+}
+
+int32_t UploadFileView::Map()
+{
+    if (data_ != nullptr) {
+        return 0;
+    }
+
+    if (ashmem_ == nullptr) {
+        INTELL_VOICE_LOG_ERROR("ashmem is nullptr");
+        return -1;
+    }
+
+    int32_t size = ashmem_->GetAshmemSize();
+    if (size <= 0) {
+        INTELL_VOICE_LOG_ERROR("invalid ashmem size:%{public}d", size);
+        return -1;
+    }
+
+    void *addr = mmap(nullptr, static_cast<size_t>(size), PROT_READ | PROT_WRITE, MAP_PRIVATE,
+        ashmem_->GetAshmemFd(), 0);
+    writable_ = (addr != MAP_FAILED);
+    if (!writable_) {
+        // the sender may have restricted the region to read only
+        INTELL_VOICE_LOG_WARN("failed to map ashmem writable, map read only");
+        addr = mmap(nullptr, static_cast<size_t>(size), PROT_READ, MAP_PRIVATE, ashmem_->GetAshmemFd(), 0);
+    }
+    if (addr == MAP_FAILED) {
+        INTELL_VOICE_LOG_ERROR("failed to map ashmem, size:%{public}d", size);
+        return -1;
+    }
+
+    data_ = static_cast<uint8_t *>(addr);
+    size_ = static_cast<uint32_t>(size);
+    return 0;
+}
+
+int32_t UploadFileView::GetFd() const
+{
+    if (ashmem_ == nullptr) {
+        return -1;
+    }
+    return ashmem_->GetAshmemFd();
+}
+}  // namespace IntellVoice
+}  // namespace OHOS
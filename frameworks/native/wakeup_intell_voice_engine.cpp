@@ -14,9 +14,13 @@
  */
 
 #include "wakeup_intell_voice_engine.h"
+#include <chrono>
+#include <pthread.h>
 #include "i_intell_voice_engine.h"
 #include "intell_voice_manager.h"
 #include "intell_voice_log.h"
+#include "hot_log.h"
+#include "time_util.h"
 
 #define LOG_TAG "WakeupIntellVoiceEngine"
 
@@ -25,6 +29,10 @@ using namespace OHOS::IntellVoiceEngine;
 
 namespace OHOS {
 namespace IntellVoice {
+static constexpr uint32_t READ_RETRY_INTERVAL_MS = 10;
+// about 1 s of retries, the capturer is gone rather than late
+static constexpr uint32_t MAX_CONSECUTIVE_READ_FAILURES = 100;
+
 WakeupIntellVoiceEngine::WakeupIntellVoiceEngine(const WakeupIntelligentVoiceEngineDescriptor &descriptor,
     IntellVoiceEngineType type)
 {
@@ -48,6 +56,7 @@ WakeupIntellVoiceEngine::WakeupIntellVoiceEngine(const WakeupIntelligentVoiceEng
 WakeupIntellVoiceEngine::~WakeupIntellVoiceEngine()
 {
     INTELL_VOICE_LOG_INFO("enter");
+    UnsubscribeAudioData();
 }
 
 int32_t WakeupIntellVoiceEngine::SetSensibility(const int32_t &sensibility)
@@ -132,10 +141,170 @@ int32_t WakeupIntellVoiceEngine::Read(std::vector<uint8_t> &data)
 {
     INTELL_VOICE_LOG_INFO("enter");
     CHECK_CONDITION_RETURN_RET(engine_ == nullptr, -1, "engine is null");
+    CHECK_CONDITION_RETURN_RET(isAudioDataRunning_.load(), -1, "audio data is pushed to the subscriber");
 
     return engine_->Read(data);
 }
 
+int32_t WakeupIntellVoiceEngine::Read(std::vector<uint8_t> &data, AudioFrameInfo &info)
+{
+    INTELL_VOICE_HOT_LOG_DEBUG("enter");
+    CHECK_CONDITION_RETURN_RET(engine_ == nullptr, -1, "engine is null");
+    CHECK_CONDITION_RETURN_RET(isAudioDataRunning_.load(), -1, "audio data is pushed to the subscriber");
+
+    return engine_->ReadFrame(data, info);
+}
+
+int32_t WakeupIntellVoiceEngine::SetReadCodec(int32_t codec)
+{
+    INTELL_VOICE_LOG_INFO("enter, codec:%{public}d", codec);
+    CHECK_CONDITION_RETURN_RET(engine_ == nullptr, -1, "engine is null");
+
+    engine_->SetReadCodec(codec);
+    return 0;
+}
+
+int32_t WakeupIntellVoiceEngine::SubscribeAudioData(AudioDataCallback callback, uint32_t framesPerCallback)
+{
+    INTELL_VOICE_LOG_INFO("enter, frames per callback:%{public}u", framesPerCallback);
+    CHECK_CONDITION_RETURN_RET(engine_ == nullptr, -1, "engine is null");
+    CHECK_CONDITION_RETURN_RET(callback == nullptr, -1, "callback is null");
+    if ((framesPerCallback == 0) || (framesPerCallback > MAX_AUDIO_FRAMES_PER_CALLBACK)) {
+        INTELL_VOICE_LOG_ERROR("frames per callback:%{public}u is invalid", framesPerCallback);
+        return -1;
+    }
+
+    // an unsubscribe reaping the previous pump holds the lock, do not wait for it on the caller thread
+    std::unique_lock<std::mutex> lock(audioDataMutex_, std::try_to_lock);
+    CHECK_CONDITION_RETURN_RET(!lock.owns_lock(), -1, "previous subscription is stopping");
+    CHECK_CONDITION_RETURN_RET(isAudioDataRunning_.load(), -1, "audio data is already subscribed");
+    if (audioDataThread_.joinable()) {
+        CHECK_CONDITION_RETURN_RET(!isAudioDataExited_.load(), -1, "previous subscription is stopping");
+        audioDataThread_.join();
+    }
+
+    deliveredFrames_.store(0);
+    droppedFrames_.store(0);
+    readFailures_.store(0);
+    captureDroppedFrames_.store(0);
+    sequenceGaps_.store(0);
+    maxLatencyUs_.store(0);
+    isAudioDataRunning_.store(true);
+    isAudioDataExited_.store(false);
+    audioDataThread_ = std::thread(&WakeupIntellVoiceEngine::AudioDataLoop, this, std::move(callback),
+        framesPerCallback);
+    pthread_setname_np(audioDataThread_.native_handle(), "WakeupAudioData");
+    return 0;
+}
+
+void WakeupIntellVoiceEngine::RequestAudioDataStop()
+{
+    {
+        std::lock_guard<std::mutex> lock(audioDataWaitMutex_);
+        isAudioDataRunning_.store(false);
+    }
+    audioDataCv_.notify_all();
+}
+
+int32_t WakeupIntellVoiceEngine::UnsubscribeAudioData()
+{
+    std::lock_guard<std::mutex> lock(audioDataMutex_);
+    if (!audioDataThread_.joinable()) {
+        return 0;
+    }
+
+    INTELL_VOICE_LOG_INFO("enter");
+    RequestAudioDataStop();
+    // an in-flight read returns once the capturer has data or times out
+    audioDataThread_.join();
+    INTELL_VOICE_LOG_INFO("delivered frames:%{public}llu, dropped frames:%{public}llu, read failures:%{public}llu",
+        static_cast<unsigned long long>(deliveredFrames_.load()),
+        static_cast<unsigned long long>(droppedFrames_.load()),
+        static_cast<unsigned long long>(readFailures_.load()));
+    INTELL_VOICE_LOG_INFO("capture dropped frames:%{public}llu, sequence gaps:%{public}llu, "
+        "max latency:%{public}lld us",
+        static_cast<unsigned long long>(captureDroppedFrames_.load()),
+        static_cast<unsigned long long>(sequenceGaps_.load()),
+        static_cast<long long>(maxLatencyUs_.load()));
+    return 0;
+}
+
+AudioDataStats WakeupIntellVoiceEngine::GetAudioDataStats() const
+{
+    AudioDataStats stats;
+    stats.deliveredFrames = deliveredFrames_.load();
+    stats.droppedFrames = droppedFrames_.load();
+    stats.readFailures = readFailures_.load();
+    stats.captureDroppedFrames = captureDroppedFrames_.load();
+    stats.sequenceGaps = sequenceGaps_.load();
+    stats.maxLatencyUs = maxLatencyUs_.load();
+    return stats;
+}
+
+void WakeupIntellVoiceEngine::AudioDataLoop(AudioDataCallback callback, uint32_t framesPerCallback)
+{
+    std::vector<uint8_t> frame;
+    std::vector<uint8_t> batch;
+    uint32_t frameCnt = 0;
+    uint32_t consecutiveFailures = 0;
+    AudioFrameInfo info;
+
+    while (isAudioDataRunning_.load()) {
+        frame.clear();
+        if (engine_->ReadFrame(frame, info) != 0) {
+            readFailures_.fetch_add(1);
+            if (++consecutiveFailures >= MAX_CONSECUTIVE_READ_FAILURES) {
+                INTELL_VOICE_LOG_ERROR("read failed %{public}u times in a row, stop pushing audio data",
+                    consecutiveFailures);
+                isAudioDataRunning_.store(false);
+                break;
+            }
+            // the capturer is not started yet or has been stopped, back off instead of spinning on ipc
+            std::unique_lock<std::mutex> lock(audioDataWaitMutex_);
+            audioDataCv_.wait_for(lock, std::chrono::milliseconds(READ_RETRY_INTERVAL_MS),
+                [this] { return !isAudioDataRunning_.load(); });
+            continue;
+        }
+        consecutiveFailures = 0;
+        UpdateFrameStats(info);
+
+        if (batch.empty()) {
+            batch.reserve(frame.size() * framesPerCallback);
+        }
+        batch.insert(batch.end(), frame.begin(), frame.end());
+        if (++frameCnt < framesPerCallback) {
+            continue;
+        }
+        // a stop requested during the read wins over the batch it completed
+        if (!isAudioDataRunning_.load()) {
+            break;
+        }
+
+        if (callback(batch)) {
+            deliveredFrames_.fetch_add(frameCnt);
+        } else {
+            droppedFrames_.fetch_add(frameCnt);
+        }
+        batch.clear();
+        frameCnt = 0;
+    }
+    isAudioDataExited_.store(true);
+}
+
+void WakeupIntellVoiceEngine::UpdateFrameStats(const AudioFrameInfo &info)
+{
+    // the service counters are cumulative per capture session, a restarted session starts again from 0
+    captureDroppedFrames_.store(info.droppedFrames);
+    sequenceGaps_.store(info.gapCnt);
+    if (info.captureTimeUs == 0) {
+        return;
+    }
+    int64_t latencyUs = IntellVoiceUtils::TimeUtil::GetMonotonicTimeUs() - info.captureTimeUs;
+    if (latencyUs > maxLatencyUs_.load()) {
+        maxLatencyUs_.store(latencyUs);
+    }
+}
+
 int32_t WakeupIntellVoiceEngine::StopCapturer()
 {
     INTELL_VOICE_LOG_INFO("enter");
@@ -17,6 +17,7 @@
 #define INTELL_VOICE_MANAGER_H
 
 #include <condition_variable>
+#include <functional>
 #include "iremote_object.h"
 #include "iremote_broker.h"
 #include "i_intell_voice_engine.h"
@@ -24,6 +25,8 @@
 #include "update_callback_inner.h"
 #include "intell_voice_info.h"
 #include "wakeup_intell_voice_engine.h"
+#include "upload_file_view.h"
+#include "intell_voice_param.h"
 
 namespace OHOS {
 namespace IntellVoice {
@@ -36,6 +39,12 @@ struct UploadFilesInfo {
     std::vector<std::vector<uint8_t>> filesContent;
 };
 
+struct UploadFilesViewInfo {
+    int32_t type;
+    std::string filesDescription;
+    std::vector<std::shared_ptr<UploadFileView>> filesContent;
+};
+
 class IntellVoiceManager {
 public:
     static IntellVoiceManager *GetInstance();
@@ -49,10 +58,20 @@ public:
     int32_t RegisterServiceDeathRecipient(sptr<OHOS::IRemoteObject::DeathRecipient> callback);
     int32_t DeregisterServiceDeathRecipient(sptr<OHOS::IRemoteObject::DeathRecipient> callback);
     int32_t GetUploadFiles(int numMax, std::vector<UploadFilesInfo> &reportedFilesInfo);
+    // same as GetUploadFiles, but the file contents are mapped from the shared memory instead of copied
+    int32_t GetUploadFilesView(int numMax, std::vector<UploadFilesViewInfo> &reportedFilesInfo);
 
     int32_t SetParameter(const std::string &key, const std::string &value);
+    // sets several typed parameters with one request
+    int32_t SetParameters(const OHOS::IntellVoiceUtils::ParamBatch &batch);
     std::string GetParameter(const std::string &key);
     int32_t GetWakeupSourceFiles(std::vector<WakeupSourceFile> &cloneFileInfo);
+    // files are delivered batch by batch, so the mapped region is bounded by maxBatchSize instead of all files;
+    // a single file larger than maxBatchSize comes alone in its own batch;
+    // an empty file is delivered with a null data pointer and size 0
+    using WakeupSourceFileHandler = std::function<bool(const std::string &, const uint8_t *, uint32_t)>;
+    int32_t StreamWakeupSourceFiles(const WakeupSourceFileHandler &onFile,
+        uint32_t maxBatchSize = OHOS::IntellVoiceEngine::CLONE_FILES_BATCH_SIZE_DEFAULT);
     int32_t EnrollWithWakeupFilesForResult(const std::vector<WakeupSourceFile> &cloneFileInfo,
         const std::string &wakeupInfo, const std::shared_ptr<IIntellVoiceUpdateCallback> callback);
     int32_t ClearUserData();
@@ -60,6 +79,11 @@ private:
     IntellVoiceManager();
     ~IntellVoiceManager();
     int32_t GetFileDataFromAshmem(sptr<Ashmem> ashmem, std::vector<uint8_t> &fileData);
+    sptr<OHOS::IntellVoiceEngine::IIntellVoiceService> GetServiceProxy();
+    int32_t DispatchFilesFromAshmem(sptr<Ashmem> ashmem, const std::vector<std::string> &filePaths,
+        const std::vector<uint32_t> &fileSizes, const WakeupSourceFileHandler &onFile);
+    int32_t SendWakeupFilesInBatches(sptr<OHOS::IntellVoiceEngine::IIntellVoiceService> proxy,
+        const std::vector<WakeupSourceFile> &cloneFileInfo, uint32_t maxBatchSize);
 
     std::mutex mutex_;
     std::condition_variable proxyConVar_;
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef UPLOAD_FILE_VIEW_H
+#define UPLOAD_FILE_VIEW_H
+
+#include <cstdint>
+#include <ashmem.h>
+#include "nocopyable.h"
+
+namespace OHOS {
+namespace IntellVoice {
+/*
+ * Maps an upload file shared by the service instead of copying it. The region is mapped private,
+ * so writes through Data() stay local to this process (copy on write) and never reach the service.
+ * If the region is read only for this process, IsWritable() is false and Data() must not be written.
+ * The mapping and the ashmem fd are released when the view is destroyed.
+ */
+class UploadFileView {
+public:
+    explicit UploadFileView(sptr<Ashmem> ashmem);
+    ~UploadFileView();
+
+    int32_t Map();
+    uint8_t *Data() const
+    {
+        return data_;
+    }
+    uint32_t Size() const
+    {
+        return size_;
+    }
+    bool IsWritable() const
+    {
+        return writable_;
+    }
+    int32_t GetFd() const;
+
+private:
+    sptr<Ashmem> ashmem_ = nullptr;
+    uint8_t *data_ = nullptr;
+    uint32_t size_ = 0;
+    bool writable_ = false;
+
+    DISALLOW_COPY(UploadFileView);
+    DISALLOW_MOVE(UploadFileView);
+};
+}  // namespace IntellVoice
+}  // namespace OHOS
+#endif
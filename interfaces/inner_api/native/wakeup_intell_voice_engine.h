@@ -16,6 +16,11 @@
 #ifndef WAKEUP_INTELL_VOICE_ENGINE_H
 #define WAKEUP_INTELL_VOICE_ENGINE_H
 
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
 #include "intell_voice_info.h"
 #include "i_intell_voice_engine.h"
 #include "engine_callback_inner.h"
@@ -31,6 +36,24 @@ struct WakeupIntelligentVoiceEngineDescriptor {
     std::string wakeupPhrase;
 };
 
+constexpr uint32_t MAX_AUDIO_FRAMES_PER_CALLBACK = 50;
+
+/*
+ * Receives a batch of captured frames. The callee may take the buffer by swapping it out.
+ * Returns false if the consumer is backed up, the batch is then counted as dropped.
+ */
+using AudioDataCallback = std::function<bool(std::vector<uint8_t> &data)>;
+
+struct AudioDataStats {
+    uint64_t deliveredFrames = 0;
+    uint64_t droppedFrames = 0;
+    uint64_t readFailures = 0;
+    // reported by the service for the current capture session
+    uint64_t captureDroppedFrames = 0;
+    uint64_t sequenceGaps = 0;
+    int64_t maxLatencyUs = 0;
+};
+
 class WakeupIntellVoiceEngine {
 public:
     WakeupIntellVoiceEngine(const WakeupIntelligentVoiceEngineDescriptor &descriptor,
@@ -45,6 +68,15 @@ public:
     int32_t SetCallback(std::shared_ptr<IIntellVoiceEngineEventCallback> callback);
     int32_t StartCapturer(int32_t channels);
     int32_t Read(std::vector<uint8_t> &data);
+    int32_t Read(std::vector<uint8_t> &data, OHOS::IntellVoiceEngine::AudioFrameInfo &info);
+    // compresses the pcm of Read on the ipc link, see AudioCodecType; data is still returned as pcm
+    int32_t SetReadCodec(int32_t codec);
+    int32_t SubscribeAudioData(AudioDataCallback callback, uint32_t framesPerCallback);
+    // only signals the pump, returns at once; UnsubscribeAudioData still has to reap it
+    void RequestAudioDataStop();
+    // blocks until the pump has exited, at most one in-flight read, keep it off the js thread
+    int32_t UnsubscribeAudioData();
+    AudioDataStats GetAudioDataStats() const;
     int32_t StopCapturer();
     int32_t GetWakeupPcm(std::vector<uint8_t> &data);
     int32_t NotifyHeadsetWakeEvent();
@@ -52,9 +84,24 @@ public:
     int32_t result_ = INTELLIGENT_VOICE_SUCCESS;
 
 private:
+    void AudioDataLoop(AudioDataCallback callback, uint32_t framesPerCallback);
+    void UpdateFrameStats(const OHOS::IntellVoiceEngine::AudioFrameInfo &info);
+
     sptr<IIntellVoiceEngine> engine_ = nullptr;
     std::unique_ptr<WakeupIntelligentVoiceEngineDescriptor> descriptor_ = nullptr;
     sptr<EngineCallbackInner> callback_ = nullptr;
+    std::mutex audioDataMutex_;
+    std::thread audioDataThread_;
+    std::mutex audioDataWaitMutex_;
+    std::condition_variable audioDataCv_;
+    std::atomic<bool> isAudioDataRunning_ { false };
+    std::atomic<bool> isAudioDataExited_ { true };
+    std::atomic<uint64_t> deliveredFrames_ { 0 };
+    std::atomic<uint64_t> droppedFrames_ { 0 };
+    std::atomic<uint64_t> readFailures_ { 0 };
+    std::atomic<uint64_t> captureDroppedFrames_ { 0 };
+    std::atomic<uint64_t> sequenceGaps_ { 0 };
+    std::atomic<int64_t> maxLatencyUs_ { 0 };
 };
 }  // namespace IntellVoice
 }  // namespace OHOS
@@ -1393,6 +1393,36 @@ declare namespace intelligentVoice {
      * @since 12
      */
     stopCapturer(): Promise<void>;
+    /**
+     * Subscribes the audio read from the capturer. Audio is pushed to the callback in batches of
+     * framesPerCallback frames, so there is no need to call read repeatedly. Batches that arrive while
+     * earlier ones are still queued for the callback are dropped. read fails while subscribed.
+     * @permission ohos.permission.MANAGE_INTELLIGENT_VOICE
+     * @param { Callback<ArrayBuffer> } callback - the callback invoked with each batch of audio.
+     * @param { number } framesPerCallback - the frames in each batch. It should be in the range [1, 50].
+     * @throws { BusinessError } 201 - Permission denied.
+     * @throws { BusinessError } 202 - Not system application.
+     * @throws { BusinessError } 401 - Parameter error. Possible causes: 1. Mandatory parameters are left unspecified. 2. Incorrect parameter types. 3.Parameter verification failed.
+     * @throws { BusinessError } 22700102 - Invalid parameter.
+     * @throws { BusinessError } 22700107 - System error.
+     * @syscap SystemCapability.AI.IntelligentVoice.Core
+     * @systemapi
+     * @since 12
+     */
+    onAudioData(callback: Callback<ArrayBuffer>, framesPerCallback: number): void;
+    /**
+     * Unsubscribes the audio read from the capturer. No new batch is pushed once this is called, the promise
+     * is resolved when the subscription has fully stopped. A subscription is also stopped after repeated
+     * read failures.
+     * @permission ohos.permission.MANAGE_INTELLIGENT_VOICE
+     * @returns { Promise<void> } the promise used to return the result.
+     * @throws { BusinessError } 201 - Permission denied.
+     * @throws { BusinessError } 202 - Not system application.
+     * @syscap SystemCapability.AI.IntelligentVoice.Core
+     * @systemapi
+     * @since 12
+     */
+    offAudioData(): Promise<void>;
     /**
      * Releases the engine, This method uses an asynchronous callback to return the result.
      * @permission ohos.permission.MANAGE_INTELLIGENT_VOICE
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "catch2/catch.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "audio_codec.h"
+
+namespace OHOS {
+namespace IntellVoiceUtils {
+static constexpr uint32_t CHANNEL_CNT = 4;
+static constexpr size_t CHANNEL_FRAME_SIZE = 640;  // 20 ms of 16 kHz 16-bit pcm
+static constexpr size_t FRAME_SIZE = CHANNEL_FRAME_SIZE * CHANNEL_CNT;
+static constexpr int32_t BENCH_ROUNDS = 20;
+
+// 2 s of recorded speech shipped with the unit tests, searched from the usual working directories
+static std::vector<uint8_t> LoadVoice()
+{
+    static const char *paths[] = {
+        "tests/unittest/intell_voice_test/resource/one.pcm",
+        "../tests/unittest/intell_voice_test/resource/one.pcm",
+        "/data/test/resource/one.pcm",
+    };
+    for (const char *path : paths) {
+        std::ifstream file(path, std::ios::binary);
+        if (file.is_open()) {
+            return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        }
+    }
+    return {};
+}
+
+// fallback when the recording is not found: voiced harmonics with a syllable envelope and some noise
+static std::vector<uint8_t> SynthesizeVoice(uint32_t sampleCnt)
+{
+    std::vector<uint8_t> pcm(sampleCnt * sizeof(int16_t));
+    uint32_t seed = 1;
+    for (uint32_t i = 0; i < sampleCnt; ++i) {
+        double t = i / 16000.0;
+        double envelope = 0.5 * (1 - std::cos(2 * M_PI * 4 * t));
+        double voiced = 0;
+        for (int32_t harmonic = 1; harmonic <= 8; ++harmonic) {
+            voiced += std::sin(2 * M_PI * 140 * harmonic * t) / harmonic;
+        }
+        seed = seed * 1103515245 + 12345;
+        int32_t noise = static_cast<int32_t>((seed >> 16) % 201) - 100;
+        int16_t sample = static_cast<int16_t>(3000 * envelope * voiced + noise);
+        std::memcpy(&pcm[i * sizeof(int16_t)], &sample, sizeof(sample));
+    }
+    return pcm;
+}
+
+// planar 4-channel frames as the wakeup Read path returns them, channels offset in time like a mic array
+static std::vector<std::vector<uint8_t>> BuildFrames(const std::vector<uint8_t> &voice)
+{
+    std::vector<std::vector<uint8_t>> frames;
+    for (size_t pos = 0; pos + CHANNEL_FRAME_SIZE * 2 <= voice.size(); pos += CHANNEL_FRAME_SIZE) {
+        std::vector<uint8_t> frame;
+        for (uint32_t channel = 0; channel < CHANNEL_CNT; ++channel) {
+            size_t offset = pos + channel * 2 * sizeof(int16_t);
+            frame.insert(frame.end(), voice.begin() + offset, voice.begin() + offset + CHANNEL_FRAME_SIZE);
+        }
+        frames.push_back(std::move(frame));
+    }
+    return frames;
+}
+
+static double SnrDb(const std::vector<uint8_t> &ref, const std::vector<uint8_t> &out)
+{
+    const int16_t *a = reinterpret_cast<const int16_t *>(ref.data());
+    const int16_t *b = reinterpret_cast<const int16_t *>(out.data());
+    double signal = 0;
+    double noise = 0;
+    for (size_t i = 0; i < ref.size() / sizeof(int16_t); ++i) {
+        signal += static_cast<double>(a[i]) * a[i];
+        noise += static_cast<double>(a[i] - b[i]) * (a[i] - b[i]);
+    }
+    return 10 * std::log10(signal / std::max(noise, 1.0));
+}
+
+TEST_CASE("AudioCodec round trip", "intell_voice_audio_codec") {
+    std::vector<uint8_t> pcm = SynthesizeVoice(1000);
+    std::vector<uint8_t> encoded;
+    std::vector<uint8_t> decoded;
+
+    SECTION("rice is lossless, including full scale and odd lengths") {
+        int16_t edges[] = { INT16_MAX, INT16_MIN, INT16_MAX, 0, INT16_MIN, INT16_MIN, 1 };
+        pcm.insert(pcm.end(), reinterpret_cast<uint8_t *>(edges), reinterpret_cast<uint8_t *>(edges) + sizeof(edges));
+        REQUIRE(AudioCodec::Encode(AUDIO_CODEC_RICE, pcm, encoded));
+        REQUIRE(AudioCodec::Decode(AUDIO_CODEC_RICE, encoded.data(), encoded.size(), decoded));
+        REQUIRE(decoded == pcm);
+    }
+
+    SECTION("adpcm keeps the waveform") {
+        REQUIRE(AudioCodec::Encode(AUDIO_CODEC_ADPCM, pcm, encoded));
+        REQUIRE(encoded.size() < pcm.size() / 3);
+        REQUIRE(AudioCodec::Decode(AUDIO_CODEC_ADPCM, encoded.data(), encoded.size(), decoded));
+        REQUIRE(decoded.size() == pcm.size());
+        REQUIRE(SnrDb(pcm, decoded) > 20);
+    }
+
+    SECTION("invalid input is rejected") {
+        REQUIRE(!AudioCodec::Encode(AUDIO_CODEC_BUT, pcm, encoded));
+        std::vector<uint8_t> odd(3);
+        REQUIRE(!AudioCodec::Encode(AUDIO_CODEC_RICE, odd, encoded));
+        REQUIRE(AudioCodec::Encode(AUDIO_CODEC_RICE, pcm, encoded));
+        REQUIRE(!AudioCodec::Decode(AUDIO_CODEC_RICE, encoded.data(), encoded.size() / 2, decoded));
+        REQUIRE(!AudioCodec::Decode(AUDIO_CODEC_ADPCM, encoded.data(), 2, decoded));
+    }
+}
+
+TEST_CASE("AudioCodec benchmark", "intell_voice_audio_codec") {
+    std::vector<uint8_t> voice = LoadVoice();
+    bool isRecorded = !voice.empty();
+    if (!isRecorded) {
+        voice = SynthesizeVoice(32000);
+    }
+    std::vector<std::vector<uint8_t>> frames = BuildFrames(voice);
+    REQUIRE(!frames.empty());
+
+    for (int32_t codec : { AUDIO_CODEC_RICE, AUDIO_CODEC_ADPCM }) {
+        size_t encodedBytes = 0;
+        double snr = 1000;
+        std::vector<uint8_t> encoded;
+        std::vector<uint8_t> decoded;
+        std::chrono::nanoseconds encodeCost(0);
+        std::chrono::nanoseconds decodeCost(0);
+        for (int32_t round = 0; round < BENCH_ROUNDS; ++round) {
+            for (const auto &frame : frames) {
+                auto begin = std::chrono::steady_clock::now();
+                AudioCodec::Encode(codec, frame, encoded);
+                auto middle = std::chrono::steady_clock::now();
+                AudioCodec::Decode(codec, encoded.data(), encoded.size(), decoded);
+                auto end = std::chrono::steady_clock::now();
+                encodeCost += middle - begin;
+                decodeCost += end - middle;
+                if (round == 0) {
+                    encodedBytes += encoded.size();
+                    snr = std::min(snr, SnrDb(frame, decoded));
+                    if (codec == AUDIO_CODEC_RICE) {
+                        REQUIRE(decoded == frame);
+                    }
+                }
+            }
+        }
+
+        size_t frameCnt = frames.size() * BENCH_ROUNDS;
+        double ratio = static_cast<double>(frames.size() * FRAME_SIZE) / encodedBytes;
+        WARN((isRecorded ? "recorded" : "synthetic") << " voice, codec " << codec << ": ratio " << ratio <<
+            ((codec == AUDIO_CODEC_RICE) ? std::string(", lossless") : ", min frame snr " + std::to_string(snr) +
+            " dB") << ", encode " << encodeCost.count() / frameCnt << " ns/frame, decode " <<
+            decodeCost.count() / frameCnt << " ns/frame (" << FRAME_SIZE << " byte frames)");
+        REQUIRE(ratio > ((codec == AUDIO_CODEC_RICE) ? 1.2 : 3.5));
+    }
+}
+}
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "catch2/catch.hpp"
+
+#include <sys/time.h>
+#include <chrono>
+#include <ctime>
+#include <sstream>
+#include <vector>
+#include "hot_log.h"
+
+namespace OHOS {
+namespace IntellVoiceUtils {
+static constexpr uint32_t FRAME_SIZE = 640; // 16k, 16bit, 20ms
+static constexpr uint32_t FRAME_NUM = 50000;
+
+// what a per-frame INFO log costs before it reaches hilog: stream formatting and wall clock formatting
+static void FormatFrameLog(uint32_t frameIndex, uint32_t size, std::string &out)
+{
+    std::ostringstream oss;
+    oss << "read frame " << frameIndex << " size " << size << " time ";
+    struct timeval now;
+    gettimeofday(&now, nullptr);
+    struct tm nowtm;
+    localtime_r(&now.tv_sec, &nowtm);
+    char tmbuf[64] = {0};
+    strftime(tmbuf, sizeof(tmbuf), "%Y-%m-%d %H:%M:%S", &nowtm);
+    char line[256] = {0};
+    snprintf(line, sizeof(line), "%s %s.%lld", oss.str().c_str(), tmbuf, static_cast<long long>(now.tv_usec));
+    out = line;
+}
+
+template<typename Func>
+static int64_t RunReadLoop(Func &&logFunc)
+{
+    std::vector<uint8_t> src(FRAME_SIZE, 1);
+    std::vector<uint8_t> dst(FRAME_SIZE, 0);
+    auto begin = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < FRAME_NUM; ++i) {
+        std::copy(src.begin(), src.end(), dst.begin());
+        logFunc(i);
+    }
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count();
+}
+
+TEST_CASE("LogRateLimiter", "intell_voice_hot_log") {
+    LogRateLimiter limiter(60000);
+    uint32_t suppressed = 0;
+    REQUIRE(limiter.Allow(suppressed));
+    REQUIRE(suppressed == 0);
+    REQUIRE(!limiter.Allow(suppressed));
+    REQUIRE(!limiter.Allow(suppressed));
+}
+
+TEST_CASE("HotLogRing", "intell_voice_hot_log") {
+    HotLogRing &ring = HotLogRing::GetInstance();
+    for (uint32_t i = 0; i < HotLogRing::RING_SIZE + 1; ++i) {
+        ring.Record("ring_test", { i, 1, 2, 3, 4 });
+    }
+    std::string info = ring.Dump();
+    // the oldest record is overwritten, extra arguments are dropped
+    REQUIRE(info.find("ring_test: 0, 1") == std::string::npos);
+    REQUIRE(info.find("ring_test: 1024, 1, 2, 3\n") != std::string::npos);
+}
+
+TEST_CASE("HotLogReadLoopBenchmark", "intell_voice_hot_log") {
+    std::string line;
+    int64_t formatCost = RunReadLoop([&line](uint32_t i) {
+        FormatFrameLog(i, FRAME_SIZE, line);
+    });
+    int64_t recordCost = RunReadLoop([](uint32_t i) {
+        INTELL_VOICE_HOT_RECORD("audio_read", i, FRAME_SIZE);
+    });
+    int64_t baseCost = RunReadLoop([](uint32_t) {});
+
+    WARN("read " << FRAME_NUM << " frames, base:" << baseCost << " us, formatted log:" << formatCost <<
+        " us, ring record:" << recordCost << " us");
+    REQUIRE(!line.empty());
+}
+}
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "catch2/catch.hpp"
+
+#include <chrono>
+#include <vector>
+#include "id_allocator.h"
+
+namespace OHOS {
+namespace IntellVoiceUtils {
+static constexpr int BENCH_CAPACITY = 8192;
+static constexpr uint32_t BENCH_ROUNDS = 100000;
+
+// the previous allocator: linear scan over std::vector<bool>
+class LinearIdAllocator {
+public:
+    explicit LinearIdAllocator(int maxNum) : idFlags_(maxNum, false) {}
+    int AllocId()
+    {
+        for (unsigned int i = 0; i < idFlags_.size(); i++) {
+            if (!idFlags_[i]) {
+                idFlags_[i] = true;
+                return i;
+            }
+        }
+        return INVALID_ID;
+    }
+    void ReleaseId(int id)
+    {
+        idFlags_[id] = false;
+    }
+
+private:
+    std::vector<bool> idFlags_;
+};
+
+template<typename Allocator>
+static int64_t RunAllocRelease(Allocator &allocator, uint32_t liveNum)
+{
+    for (uint32_t i = 0; i < liveNum; ++i) {
+        allocator.AllocId();
+    }
+    int sum = 0;
+    auto begin = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < BENCH_ROUNDS; ++i) {
+        int id = allocator.AllocId();
+        sum += id;
+        allocator.ReleaseId(id);
+    }
+    int64_t cost = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - begin).count();
+    REQUIRE(sum != 0);
+    return cost / BENCH_ROUNDS;
+}
+
+TEST_CASE("IdAllocator", "intell_voice_id_allocator") {
+    IdAllocator allocator(3);
+    int first = allocator.AllocId();
+    int second = allocator.AllocId();
+    int third = allocator.AllocId();
+    REQUIRE(first != second);
+    REQUIRE(second != third);
+    REQUIRE(allocator.AllocId() == INVALID_ID);
+
+    SECTION("stale id is rejected after the slot is reused") {
+        REQUIRE(allocator.ReleaseId(second));
+        int reused = allocator.AllocId();
+        REQUIRE(reused != second);
+        REQUIRE((reused & 0xffff) == (second & 0xffff));
+        REQUIRE(!allocator.IsAllocated(second));
+        REQUIRE(!allocator.ReleaseId(second));
+        REQUIRE(allocator.IsAllocated(reused));
+    }
+    SECTION("double release is rejected") {
+        REQUIRE(allocator.ReleaseId(first));
+        REQUIRE(!allocator.ReleaseId(first));
+        REQUIRE(!allocator.ReleaseId(INVALID_ID));
+        REQUIRE(!allocator.ReleaseId(-1));
+    }
+    SECTION("clear invalidates every live id") {
+        allocator.ClearId();
+        REQUIRE(!allocator.IsAllocated(first));
+        REQUIRE(!allocator.IsAllocated(third));
+        REQUIRE(allocator.AllocId() != INVALID_ID);
+    }
+}
+
+TEST_CASE("IdAllocatorBenchmark", "intell_voice_id_allocator") {
+    for (uint32_t liveNum : { 16, 256, 1024, 4096 }) {
+        IdAllocator bitset(BENCH_CAPACITY);
+        LinearIdAllocator linear(BENCH_CAPACITY);
+        int64_t bitsetCost = RunAllocRelease(bitset, liveNum);
+        int64_t linearCost = RunAllocRelease(linear, liveNum);
+        WARN("live timers:" << liveNum << ", alloc+release bitset:" << bitsetCost << " ns, linear:" <<
+            linearCost << " ns");
+    }
+}
+}
+}
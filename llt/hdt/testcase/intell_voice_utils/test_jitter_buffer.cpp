@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "catch2/catch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "jitter_buffer.h"
+
+namespace OHOS {
+namespace IntellVoiceUtils {
+static constexpr int64_t FRAME_US = 20000;
+static constexpr int64_t RUN_US = 10 * 1000 * 1000;  // the 10s post-wakeup read window
+
+// stands in for the headset adapter: hands out frames at recorded arrival times
+class StandInHeadsetAdapter {
+public:
+    explicit StandInHeadsetAdapter(std::vector<int64_t> arrivalUs) : arrivalUs_(std::move(arrivalUs)) {}
+    bool HasFrameAt(int64_t nowUs) const
+    {
+        return (next_ < arrivalUs_.size()) && (arrivalUs_[next_] <= nowUs);
+    }
+    void PopFrame()
+    {
+        next_++;
+    }
+    int64_t NextArrivalUs() const
+    {
+        return (next_ < arrivalUs_.size()) ? arrivalUs_[next_] : INT64_MAX;
+    }
+
+private:
+    std::vector<int64_t> arrivalUs_;
+    size_t next_ = 0;
+};
+
+struct ReplayResult {
+    JitterBufferStats stats;
+    std::vector<int64_t> releaseUs;
+    uint32_t maxDepth = 0;
+};
+
+// a reader that always wants the next frame, driven by a simulated clock
+static ReplayResult Replay(StandInHeadsetAdapter &adapter, JitterBuffer &jitterBuffer)
+{
+    ReplayResult result;
+    uint32_t depth = 0;
+    int64_t nowUs = 0;
+    while (nowUs < RUN_US) {
+        while (adapter.HasFrameAt(nowUs)) {
+            adapter.PopFrame();
+            jitterBuffer.OnArrival(nowUs, ++depth);
+        }
+        result.maxDepth = std::max(result.maxDepth, depth);
+
+        int64_t waitUs = jitterBuffer.Poll(nowUs, depth);
+        if (waitUs == 0) {
+            jitterBuffer.OnRelease(nowUs, --depth);
+            result.releaseUs.push_back(nowUs);
+            continue;
+        }
+        nowUs = std::min(nowUs + waitUs, adapter.NextArrivalUs());
+    }
+    result.stats = jitterBuffer.GetStats();
+    return result;
+}
+
+// share of release intervals within 25% of the frame interval, skipping the first second
+static double SteadyRatio(const std::vector<int64_t> &releaseUs, int64_t frameUs = FRAME_US)
+{
+    uint32_t total = 0;
+    uint32_t steady = 0;
+    for (size_t i = 1; i < releaseUs.size(); ++i) {
+        if (releaseUs[i - 1] < 1000 * 1000) {
+            continue;
+        }
+        int64_t interval = releaseUs[i] - releaseUs[i - 1];
+        total++;
+        if (std::abs(interval - frameUs) <= frameUs / 4) {
+            steady++;
+        }
+    }
+    return (total == 0) ? 0 : static_cast<double>(steady) / total;
+}
+
+// recorded bluetooth pattern: 6 frames delivered together every 120 ms, a 200 ms stall every 2 s
+static std::vector<int64_t> BurstPattern()
+{
+    std::vector<int64_t> arrivals;
+    int64_t burstUs = 0;
+    for (int32_t burst = 0; burstUs < RUN_US; ++burst) {
+        for (int32_t i = 0; i < 6; ++i) {
+            arrivals.push_back(burstUs + i * 300);
+        }
+        burstUs += ((burst % 16) == 15) ? 200000 : 120000;
+    }
+    return arrivals;
+}
+
+// steady cadence, each frame 0-4 ms late by a fixed pseudo random sequence
+static std::vector<int64_t> SteadyPattern(int64_t frameUs = FRAME_US)
+{
+    std::vector<int64_t> arrivals;
+    uint32_t seed = 1;
+    for (int64_t t = 0; t < RUN_US; t += frameUs) {
+        seed = seed * 1103515245 + 12345;
+        arrivals.push_back(t + static_cast<int64_t>((seed >> 16) % 4001));
+    }
+    return arrivals;
+}
+
+TEST_CASE("JitterBuffer steady input", "intell_voice_jitter_buffer") {
+    StandInHeadsetAdapter adapter(SteadyPattern());
+    JitterBuffer jitterBuffer;
+    ReplayResult result = Replay(adapter, jitterBuffer);
+
+    REQUIRE(result.stats.targetDepth == 2);
+    REQUIRE(result.stats.underrunCnt <= 1);
+    REQUIRE(result.stats.jitterUs < 4000);
+    REQUIRE(SteadyRatio(result.releaseUs) > 0.95);
+}
+
+TEST_CASE("JitterBuffer bursty input", "intell_voice_jitter_buffer") {
+    std::vector<int64_t> pattern = BurstPattern();
+    StandInHeadsetAdapter adapter(pattern);
+    JitterBuffer jitterBuffer;
+    ReplayResult result = Replay(adapter, jitterBuffer);
+
+    WARN("bursty input: target depth " << result.stats.targetDepth << ", jitter " << result.stats.jitterUs <<
+        " us, underrun " << result.stats.underrunCnt << ", late " << result.stats.lateCnt <<
+        ", steady releases " << SteadyRatio(result.releaseUs) << ", max depth " << result.maxDepth);
+    REQUIRE(result.stats.arrivalCnt == pattern.size());
+    REQUIRE(result.stats.targetDepth >= 6);
+    REQUIRE(result.stats.targetDepth <= 16);
+    REQUIRE(result.stats.underrunCnt < 10);
+    REQUIRE(result.stats.lateCnt <= result.stats.underrunCnt);
+    REQUIRE(SteadyRatio(result.releaseUs) > 0.9);
+
+    SECTION("passing bursts straight through is far from steady") {
+        REQUIRE(SteadyRatio(pattern) < 0.2);
+    }
+}
+
+TEST_CASE("JitterBuffer backlog", "intell_voice_jitter_buffer") {
+    // wake audio buffered before the first read, then a steady stream
+    std::vector<int64_t> arrivals(100, 0);
+    for (int64_t t = FRAME_US; t < RUN_US; t += FRAME_US) {
+        arrivals.push_back(t);
+    }
+    StandInHeadsetAdapter adapter(arrivals);
+    JitterBuffer jitterBuffer;
+    ReplayResult result = Replay(adapter, jitterBuffer);
+
+    // the backlog above the max depth goes out at once, the rest drains at a shortened cadence
+    REQUIRE(result.releaseUs.size() > 450);
+    REQUIRE(result.releaseUs[84] == 0);
+    REQUIRE(result.stats.underrunCnt == 0);
+}
+
+TEST_CASE("JitterBuffer non 20 ms cadence", "intell_voice_jitter_buffer") {
+    // 256 and 1024 byte headset blocks: 8 ms and 32 ms at 16 kHz mono 16-bit
+    for (int64_t blockUs : { 8000, 32000 }) {
+        StandInHeadsetAdapter adapter(SteadyPattern(blockUs));
+        JitterBuffer jitterBuffer;
+        jitterBuffer.SetFrameInterval(blockUs);
+        ReplayResult result = Replay(adapter, jitterBuffer);
+
+        StandInHeadsetAdapter nominalAdapter(SteadyPattern(blockUs));
+        JitterBuffer nominal;
+        ReplayResult nominalResult = Replay(nominalAdapter, nominal);
+
+        WARN(blockUs << " us blocks, paced at the block size: target depth " << result.stats.targetDepth <<
+            ", max depth " << result.maxDepth << ", underrun " << result.stats.underrunCnt << "; paced at 20 ms: " <<
+            "target depth " << nominalResult.stats.targetDepth << ", max depth " << nominalResult.maxDepth <<
+            ", underrun " << nominalResult.stats.underrunCnt);
+        REQUIRE(jitterBuffer.GetFrameInterval() == blockUs);
+        REQUIRE(result.stats.underrunCnt <= 1);
+        REQUIRE(result.maxDepth <= 4);
+        REQUIRE(SteadyRatio(result.releaseUs, blockUs) > 0.9);
+        // the nominal 20 ms cadence backs frames up or starves, latency grows either way
+        REQUIRE(nominalResult.maxDepth > 4);
+    }
+
+    SECTION("the interval survives a reset") {
+        JitterBuffer jitterBuffer;
+        jitterBuffer.SetFrameInterval(8000);
+        jitterBuffer.Reset();
+        REQUIRE(jitterBuffer.GetFrameInterval() == 8000);
+    }
+}
+
+TEST_CASE("JitterBuffer end of stream", "intell_voice_jitter_buffer") {
+    JitterBuffer jitterBuffer;
+    jitterBuffer.OnArrival(0, 1);
+    jitterBuffer.OnArrival(200000, 2);
+    REQUIRE(jitterBuffer.Poll(200000, 2) > 0);
+
+    // the tail below the target depth still goes out, and running dry is not an underrun
+    jitterBuffer.SetEndOfStream();
+    REQUIRE(jitterBuffer.Poll(200000, 2) == 0);
+    jitterBuffer.OnRelease(200000, 1);
+    REQUIRE(jitterBuffer.Poll(200000 + FRAME_US, 1) == 0);
+    jitterBuffer.OnRelease(200000 + FRAME_US, 0);
+    REQUIRE(jitterBuffer.Poll(200000 + 2 * FRAME_US, 0) > 0);
+    REQUIRE(jitterBuffer.GetStats().underrunCnt == 0);
+}
+
+TEST_CASE("JitterBuffer reset", "intell_voice_jitter_buffer") {
+    JitterBuffer jitterBuffer;
+    jitterBuffer.OnArrival(0, 1);
+    jitterBuffer.OnArrival(200000, 2);
+    REQUIRE(jitterBuffer.GetStats().targetDepth > 2);
+    jitterBuffer.Reset();
+    JitterBufferStats stats = jitterBuffer.GetStats();
+    REQUIRE(stats.targetDepth == 2);
+    REQUIRE(stats.arrivalCnt == 0);
+}
+}
+}
@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "catch2/catch.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <queue>
+#include <thread>
+#include <vector>
+#include <pthread.h>
+#include "message_queue.h"
+
+namespace OHOS {
+namespace IntellVoiceUtils {
+static constexpr uint32_t BENCH_QUEUE_SIZE = 100;
+static constexpr uint32_t BENCH_MSG_NUM = 160000;
+static constexpr double PERCENT_50 = 0.5;
+static constexpr double PERCENT_99 = 0.99;
+static constexpr double PERCENT_999 = 0.999;
+
+// the previous queue: pthread mutex and condvar around std::queue, one shared_ptr per message
+class LegacyMessageQueue {
+public:
+    explicit LegacyMessageQueue(uint32_t size) : size_(size)
+    {
+        pthread_cond_init(&cond_, nullptr);
+    }
+    ~LegacyMessageQueue()
+    {
+        pthread_mutex_destroy(&lock_);
+        pthread_cond_destroy(&cond_);
+    }
+    std::shared_ptr<Message> ObtainMsg()
+    {
+        return std::make_shared<Message>(0);
+    }
+    void RecycleMsg(std::shared_ptr<Message> &msg)
+    {
+        msg = nullptr;
+    }
+    std::shared_ptr<Message> ReceiveMsg()
+    {
+        pthread_mutex_lock(&lock_);
+        while (queue_.empty()) {
+            pthread_cond_wait(&cond_, &lock_);
+        }
+        std::shared_ptr<Message> msg = queue_.front();
+        queue_.pop();
+        pthread_mutex_unlock(&lock_);
+        return msg;
+    }
+    bool SendMsg(std::shared_ptr<Message> msg)
+    {
+        pthread_mutex_lock(&lock_);
+        if (queue_.size() >= size_) {
+            pthread_mutex_unlock(&lock_);
+            return false;
+        }
+        queue_.push(msg);
+        pthread_cond_signal(&cond_);
+        pthread_mutex_unlock(&lock_);
+        return true;
+    }
+
+private:
+    uint32_t size_;
+    pthread_mutex_t lock_ = PTHREAD_MUTEX_INITIALIZER;
+    pthread_cond_t cond_;
+    std::queue<std::shared_ptr<Message>> queue_;
+};
+
+struct BenchResult {
+    double msgPerSec = 0;
+    int64_t p50Ns = 0;
+    int64_t p99Ns = 0;
+    int64_t p999Ns = 0;
+};
+
+template<typename Queue>
+static BenchResult RunProducers(uint32_t producerNum)
+{
+    Queue queue(BENCH_QUEUE_SIZE);
+    uint32_t perProducer = BENCH_MSG_NUM / producerNum;
+    uint32_t total = perProducer * producerNum;
+    std::vector<std::vector<int64_t>> latencies(producerNum);
+
+    std::thread consumer([&queue, total]() {
+        for (uint32_t i = 0; i < total; ++i) {
+            std::shared_ptr<Message> msg = queue.ReceiveMsg();
+            queue.RecycleMsg(msg);
+        }
+    });
+
+    auto begin = std::chrono::steady_clock::now();
+    std::vector<std::thread> producers;
+    for (uint32_t p = 0; p < producerNum; ++p) {
+        producers.emplace_back([&queue, &latencies, p, perProducer]() {
+            latencies[p].reserve(perProducer);
+            for (uint32_t i = 0; i < perProducer; ++i) {
+                auto start = std::chrono::steady_clock::now();
+                std::shared_ptr<Message> msg = queue.ObtainMsg();
+                msg->what_ = i;
+                msg->arg1_ = static_cast<int32_t>(p);
+                while (!queue.SendMsg(msg)) {
+                    std::this_thread::yield();
+                }
+                latencies[p].push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start).count());
+            }
+        });
+    }
+    for (auto &producer : producers) {
+        producer.join();
+    }
+    consumer.join();
+    int64_t costNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - begin).count();
+
+    std::vector<int64_t> all;
+    all.reserve(total);
+    for (const auto &latency : latencies) {
+        all.insert(all.end(), latency.begin(), latency.end());
+    }
+    std::sort(all.begin(), all.end());
+
+    BenchResult result;
+    result.msgPerSec = static_cast<double>(total) * 1e9 / static_cast<double>(costNs);
+    result.p50Ns = all[static_cast<size_t>(all.size() * PERCENT_50)];
+    result.p99Ns = all[static_cast<size_t>(all.size() * PERCENT_99)];
+    result.p999Ns = all[static_cast<size_t>(all.size() * PERCENT_999)];
+    return result;
+}
+
+TEST_CASE("MessageQueue", "intell_voice_message_queue") {
+    MessageQueue queue(4);
+
+    SECTION("messages of one producer keep their order") {
+        for (uint32_t i = 0; i < 4; ++i) {
+            REQUIRE(queue.SendMsg(std::make_shared<Message>(i)));
+        }
+        REQUIRE(!queue.SendMsg(std::make_shared<Message>(4)));
+        REQUIRE(!queue.SendMsg(nullptr));
+        for (uint32_t i = 0; i < 4; ++i) {
+            REQUIRE(queue.ReceiveMsg()->what_ == i);
+        }
+    }
+
+    SECTION("recycled messages are reset and handed out again") {
+        std::shared_ptr<Message> msg = queue.ObtainMsg();
+        Message *raw = msg.get();
+        msg->what_ = 1;
+        msg->obj_ = "payload";
+        queue.RecycleMsg(msg);
+        REQUIRE(msg == nullptr);
+
+        std::shared_ptr<Message> again = queue.ObtainMsg();
+        REQUIRE(again.get() == raw);
+        REQUIRE(again->what_ == 0);
+        REQUIRE(again->obj_.empty());
+    }
+
+    SECTION("a message still held elsewhere is not pooled") {
+        std::shared_ptr<Message> msg = queue.ObtainMsg();
+        std::shared_ptr<Message> holder = msg;
+        queue.RecycleMsg(msg);
+        REQUIRE(queue.ObtainMsg().get() != holder.get());
+    }
+
+    SECTION("the consumer parks until a message arrives") {
+        uint32_t what = 0;
+        std::thread consumer([&queue, &what]() {
+            what = queue.ReceiveMsg()->what_;
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        REQUIRE(queue.SendMsg(std::make_shared<Message>(7)));
+        consumer.join();
+        REQUIRE(what == 7);
+    }
+}
+
+TEST_CASE("SynInfo", "intell_voice_message_queue") {
+    SynInfo info;
+    REQUIRE(!info.Wait(10));
+
+    std::thread handler([&info]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        info.Notify();
+    });
+    REQUIRE(info.Wait(1000));
+    handler.join();
+
+    info.Reset();
+    REQUIRE(!info.Wait(0));
+}
+
+TEST_CASE("MessageQueue benchmark", "intell_voice_message_queue") {
+    for (uint32_t producerNum : { 1, 4, 16 }) {
+        BenchResult legacy = RunProducers<LegacyMessageQueue>(producerNum);
+        BenchResult pooled = RunProducers<MessageQueue>(producerNum);
+        WARN("producers: " << producerNum <<
+            ", mutex queue: " << static_cast<int64_t>(legacy.msgPerSec) << " msg/s, p50/p99/p99.9 " <<
+            legacy.p50Ns << "/" << legacy.p99Ns << "/" << legacy.p999Ns << " ns" <<
+            ", lock-free queue: " << static_cast<int64_t>(pooled.msgPerSec) << " msg/s, p50/p99/p99.9 " <<
+            pooled.p50Ns << "/" << pooled.p99Ns << "/" << pooled.p999Ns << " ns");
+        REQUIRE(pooled.msgPerSec > 0);
+    }
+}
+}
+}
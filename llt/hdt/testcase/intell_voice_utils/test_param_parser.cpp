@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "catch2/catch.hpp"
+
+#include <chrono>
+#include <map>
+#include "intell_voice_param.h"
+#include "param_dispatcher.h"
+#include "string_util.h"
+
+namespace OHOS {
+namespace IntellVoiceUtils {
+static constexpr uint32_t PARSE_LOOP_NUM = 100000;
+static const std::string PARAM_LIST =
+    "Sensibility=3; wakeup_bundle_name=com.example.voice;wakeup_ability_name=MainAbility;language=zh;area=CN";
+
+// the path used before the parser: split, copy every pair into a map, compare keys as strings
+static uint32_t ParseByStringMap(const std::string &keyValueList)
+{
+    std::vector<std::string> paramsList;
+    std::map<std::string, std::string> kvpairs;
+    StringUtil::Split(keyValueList, ";", paramsList);
+    for (const auto &it : paramsList) {
+        std::string key;
+        std::string value;
+        if (StringUtil::SplitLineToPair(it, key, value)) {
+            kvpairs[key] = value;
+        }
+    }
+
+    uint32_t handled = 0;
+    for (const auto &it : kvpairs) {
+        if ((it.first == std::string("Sensibility")) || (it.first == std::string("wakeup_bundle_name")) ||
+            (it.first == std::string("wakeup_ability_name")) || (it.first == std::string("language")) ||
+            (it.first == std::string("area"))) {
+            ++handled;
+        }
+    }
+    return handled;
+}
+
+TEST_CASE("ParseKVPair", "intell_voice_param") {
+    std::map<std::string, std::string> pairs;
+    uint32_t count = IntellVoiceParam::ForEachKVPair(" a = 1;;b=;=c;d=4 ;e", [&pairs](std::string_view key,
+        std::string_view value) {
+        pairs[std::string(key)] = std::string(value);
+    });
+    REQUIRE(count == 2);
+    REQUIRE(pairs["a"] == "1");
+    REQUIRE(pairs["d"] == "4");
+
+    REQUIRE(IntellVoiceParam::InternKey("Sensibility") == PARAM_KEY_SENSIBILITY);
+    REQUIRE(IntellVoiceParam::InternKey("fold_status") == PARAM_KEY_FOLD_STATUS);
+    REQUIRE(IntellVoiceParam::InternKey("sensibility") == PARAM_KEY_UNKNOWN);
+}
+
+TEST_CASE("DispatchParam", "intell_voice_param") {
+    std::string sensibility;
+    bool recordStart = false;
+    std::string unknownKey;
+    ParamDispatcher dispatcher;
+    dispatcher.Register(PARAM_KEY_SENSIBILITY, [&sensibility](std::string_view value) {
+        sensibility = std::string(value);
+    }).Register(PARAM_KEY_RECORD_START, [&recordStart](std::string_view value) {
+        recordStart = IntellVoiceParam::ParseBool(value);
+    }).SetUnknownHandler([&unknownKey](std::string_view key, std::string_view) {
+        unknownKey = std::string(key);
+    });
+
+    REQUIRE(dispatcher.Dispatch("Sensibility=2;record_start=true;other=1") == 2);
+    REQUIRE(sensibility == "2");
+    REQUIRE(recordStart);
+    REQUIRE(unknownKey == "other");
+
+    SECTION("batch") {
+        ParamBatch batch;
+        batch.Set(PARAM_KEY_SENSIBILITY, 3).Set(PARAM_KEY_RECORD_START, false);
+        REQUIRE(batch.ToString() == "Sensibility=3;record_start=false");
+        REQUIRE(dispatcher.Dispatch(batch) == 2);
+        REQUIRE(sensibility == "3");
+        REQUIRE(!recordStart);
+    }
+}
+
+TEST_CASE("ParseParamBenchmark", "intell_voice_param") {
+    uint32_t legacyHandled = 0;
+    auto begin = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < PARSE_LOOP_NUM; ++i) {
+        legacyHandled += ParseByStringMap(PARAM_LIST);
+    }
+    auto legacyCost = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - begin).count();
+
+    uint32_t handled = 0;
+    begin = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < PARSE_LOOP_NUM; ++i) {
+        IntellVoiceParam::ForEachKVPair(PARAM_LIST, [&handled](std::string_view key, std::string_view) {
+            if (IntellVoiceParam::InternKey(key) != PARAM_KEY_UNKNOWN) {
+                ++handled;
+            }
+        });
+    }
+    auto cost = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - begin).count();
+
+    WARN("parse " << PARSE_LOOP_NUM << " lists, string map:" << legacyCost << " us, string view:" << cost << " us");
+    REQUIRE(handled == legacyHandled);
+}
+}
+}
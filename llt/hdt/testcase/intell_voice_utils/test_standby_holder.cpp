@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "catch2/catch.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "standby_holder.h"
+
+namespace OHOS {
+namespace IntellVoiceUtils {
+static std::atomic<uint32_t> g_releaseCnt { 0 };
+
+// stands in for the audio capturer: creating and configuring it is the slow part, starting it is cheap
+class StandInCapturer {
+public:
+    static constexpr auto CREATE_COST = std::chrono::milliseconds(30);
+    static constexpr auto START_COST = std::chrono::milliseconds(2);
+
+    static std::unique_ptr<StandInCapturer> Create()
+    {
+        std::this_thread::sleep_for(CREATE_COST);
+        return std::make_unique<StandInCapturer>();
+    }
+    bool Start()
+    {
+        std::this_thread::sleep_for(START_COST);
+        isRunning_ = true;
+        return true;
+    }
+    void Stop()
+    {
+        isRunning_ = false;
+    }
+    bool IsRunning() const
+    {
+        return isRunning_;
+    }
+
+private:
+    bool isRunning_ = false;
+};
+
+static StandbyHolder<StandInCapturer>::ReleaseFunc CountRelease()
+{
+    return [](std::unique_ptr<StandInCapturer> item) {
+        if (item != nullptr) {
+            g_releaseCnt++;
+        }
+    };
+}
+
+// same flow as AudioSource::Start: take the parked capturer if there is one, create it otherwise
+static std::unique_ptr<StandInCapturer> StartSession(StandbyHolder<StandInCapturer> &holder, const std::string &key)
+{
+    std::unique_ptr<StandInCapturer> capturer = holder.Take(key);
+    if (capturer == nullptr) {
+        capturer = StandInCapturer::Create();
+    }
+    capturer->Start();
+    return capturer;
+}
+
+TEST_CASE("StandbyHolder", "intell_voice_standby_holder") {
+    g_releaseCnt = 0;
+    StandbyHolder<StandInCapturer> holder(CountRelease());
+
+    SECTION("a parked object is handed back for the same key only") {
+        holder.Park(std::make_unique<StandInCapturer>(), "16000_4", 1000);
+        REQUIRE(holder.IsParked());
+        REQUIRE(holder.Take("16000_1") == nullptr);
+        REQUIRE(g_releaseCnt == 1);
+
+        holder.Park(std::make_unique<StandInCapturer>(), "16000_4", 1000);
+        REQUIRE(holder.Take("16000_4") != nullptr);
+        REQUIRE(!holder.IsParked());
+        REQUIRE(g_releaseCnt == 1);
+    }
+
+    SECTION("nothing outlives the grace period") {
+        holder.Park(std::make_unique<StandInCapturer>(), "16000_4", 20);
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        REQUIRE(!holder.IsParked());
+        REQUIRE(g_releaseCnt == 1);
+
+        // the reaper is restarted for the next park
+        holder.Park(std::make_unique<StandInCapturer>(), "16000_4", 20);
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        REQUIRE(g_releaseCnt == 2);
+    }
+
+    SECTION("opting out releases at once") {
+        holder.Park(std::make_unique<StandInCapturer>(), "16000_4", 0);
+        REQUIRE(!holder.IsParked());
+        REQUIRE(g_releaseCnt == 1);
+
+        holder.Park(std::make_unique<StandInCapturer>(), "16000_4", 1000);
+        holder.Flush();
+        REQUIRE(g_releaseCnt == 2);
+    }
+}
+
+TEST_CASE("StandbyHolder releases on destruction", "intell_voice_standby_holder") {
+    g_releaseCnt = 0;
+    {
+        StandbyHolder<StandInCapturer> holder(CountRelease());
+        holder.Park(std::make_unique<StandInCapturer>(), "16000_4", 1000);
+    }
+    REQUIRE(g_releaseCnt == 1);
+}
+
+TEST_CASE("StandbyHolder cold and warm start", "intell_voice_standby_holder") {
+    constexpr int32_t sessionNum = 5;
+    const std::string key = "16000_4";
+    StandbyHolder<StandInCapturer> holder(CountRelease());
+
+    auto measure = [&](uint32_t graceMs) {
+        std::chrono::microseconds total(0);
+        holder.Flush();
+        for (int32_t i = 0; i < sessionNum; ++i) {
+            auto begin = std::chrono::steady_clock::now();
+            std::unique_ptr<StandInCapturer> capturer = StartSession(holder, key);
+            total += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin);
+            REQUIRE(capturer->IsRunning());
+            capturer->Stop();
+            holder.Park(std::move(capturer), key, graceMs);
+        }
+        return total.count() / sessionNum;
+    };
+
+    auto coldUs = measure(0);
+    auto warmUs = measure(1000);
+    WARN("start to first frame, cold: " << coldUs << " us, warm (first session cold): " << warmUs << " us");
+    REQUIRE(warmUs < coldUs);
+}
+}
+}
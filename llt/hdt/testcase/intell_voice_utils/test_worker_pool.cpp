@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "catch2/catch.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "worker_pool.h"
+
+namespace OHOS {
+namespace IntellVoiceUtils {
+// same limits as worker_pool.cpp
+static constexpr uint32_t WORKER_NUM = 2;
+static constexpr uint32_t MAX_TASK_NUM = 32;
+static constexpr uint32_t PENDING_TASK_NUM = 5;
+static constexpr auto WAIT_TIMEOUT = std::chrono::seconds(2);
+
+template<typename Pred>
+static bool WaitUntil(Pred pred)
+{
+    auto deadline = std::chrono::steady_clock::now() + WAIT_TIMEOUT;
+    while (!pred()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+// keeps every worker busy until released, so that later tasks stay queued
+static void BlockWorkers(WorkerPool &pool, std::atomic<bool> &isReleased, std::atomic<uint32_t> &busyCnt)
+{
+    for (uint32_t i = 0; i < WORKER_NUM; ++i) {
+        REQUIRE(pool.Submit("block", [&isReleased, &busyCnt]() {
+            busyCnt++;
+            while (!isReleased.load()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }));
+    }
+    REQUIRE(WaitUntil([&busyCnt]() { return busyCnt.load() == WORKER_NUM; }));
+}
+
+TEST_CASE("WorkerPool rejects tasks when the queue is full", "intell_voice_worker_pool") {
+    WorkerPool &pool = WorkerPool::GetInstance();
+    std::atomic<bool> isReleased { false };
+    std::atomic<uint32_t> busyCnt { 0 };
+    std::atomic<uint32_t> runCnt { 0 };
+    BlockWorkers(pool, isReleased, busyCnt);
+    uint64_t rejectedCnt = pool.GetStats().rejectedCnt;
+
+    for (uint32_t i = 0; i < MAX_TASK_NUM; ++i) {
+        REQUIRE(pool.Submit("queued", [&runCnt]() { runCnt++; }));
+    }
+    REQUIRE(!pool.Submit("rejected", [&runCnt]() { runCnt++; }));
+    REQUIRE(pool.GetStats().rejectedCnt == rejectedCnt + 1);
+    REQUIRE(pool.GetStats().queueDepth == MAX_TASK_NUM);
+
+    isReleased.store(true);
+    REQUIRE(WaitUntil([&runCnt]() { return runCnt.load() == MAX_TASK_NUM; }));
+    pool.Shutdown();
+    REQUIRE(runCnt.load() == MAX_TASK_NUM);
+}
+
+TEST_CASE("WorkerPool runs pending tasks after shutdown", "intell_voice_worker_pool") {
+    WorkerPool &pool = WorkerPool::GetInstance();
+    std::atomic<bool> isReleased { false };
+    std::atomic<uint32_t> busyCnt { 0 };
+    std::atomic<uint32_t> runCnt { 0 };
+    BlockWorkers(pool, isReleased, busyCnt);
+
+    for (uint32_t i = 0; i < PENDING_TASK_NUM; ++i) {
+        REQUIRE(pool.Submit("pending", [&runCnt]() { runCnt++; }));
+    }
+
+    // shutdown joins the busy workers, so it has to run aside until they are released
+    std::thread stopper([&pool]() { pool.Shutdown(); });
+    REQUIRE(WaitUntil([&pool]() { return pool.GetStats().queueDepth == 0; }));
+    isReleased.store(true);
+    stopper.join();
+
+    REQUIRE(WaitUntil([&runCnt]() { return runCnt.load() == PENDING_TASK_NUM; }));
+
+    // the pool starts again on the next submit
+    REQUIRE(pool.Submit("restart", [&runCnt]() { runCnt++; }));
+    REQUIRE(WaitUntil([&runCnt]() { return runCnt.load() == PENDING_TASK_NUM + 1; }));
+    pool.Shutdown();
+}
+}
+}
@@ -37,6 +37,7 @@ public:
     }
     int32_t StartCapturer(int32_t channels) override;
     int32_t Read(std::vector<uint8_t> &data) override;
+    int32_t ReadFrame(std::vector<uint8_t> &data, AudioFrameInfo &info) override;
     int32_t StopCapturer() override;
     int32_t GetWakeupPcm(std::vector<uint8_t> &data) override;
     int32_t Evaluate(const std::string &word, EvaluationResult &result) override;
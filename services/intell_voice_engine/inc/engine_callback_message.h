@@ -23,6 +23,7 @@
 #include <optional>
 #include "nocopyable.h"
 #include "intell_voice_log.h"
+#include "hot_log.h"
 
 #undef LOG_TAG
 #define LOG_TAG "EngineCallbackMessage"
@@ -60,7 +61,7 @@ public:
     {
         std::vector<std::any> params = { std::forward<Args>(args)... };
         if (EngineFuncMap.find(id) != EngineFuncMap.end()) {
-            INTELL_VOICE_LOG_INFO("enter, EngineCbMessageId: %{public}d, Number of arguments: %{public}u",
+            INTELL_VOICE_HOT_LOG_DEBUG("enter, EngineCbMessageId: %{public}d, Number of arguments: %{public}u",
                 id, static_cast<uint32_t>(params.size()));
             return EngineFuncMap[id](params);
         } else {
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ENGINE_REGISTRY_H
+#define ENGINE_REGISTRY_H
+
+#include <array>
+#include <mutex>
+#include <functional>
+#include "engine_base.h"
+#include "nocopyable.h"
+
+namespace OHOS {
+namespace IntellVoiceEngine {
+constexpr int32_t ENGINE_SLOT_NUM = ENGINE_TYPE_BUT + 1;
+constexpr int32_t HEADSET_ENGINE_SLOT = ENGINE_TYPE_BUT;
+constexpr int32_t INVALID_ENGINE_SLOT = -1;
+
+constexpr int32_t EngineTypeToSlot(IntellVoiceEngineType type)
+{
+    if ((type >= INTELL_VOICE_ENROLL) && (type < ENGINE_TYPE_BUT)) {
+        return static_cast<int32_t>(type);
+    }
+    if (type == INTELL_VOICE_HEADSET_WAKEUP) {
+        return HEADSET_ENGINE_SLOT;
+    }
+    return INVALID_ENGINE_SLOT;
+}
+
+constexpr IntellVoiceEngineType SlotToEngineType(int32_t slot)
+{
+    return (slot == HEADSET_ENGINE_SLOT) ? INTELL_VOICE_HEADSET_WAKEUP : static_cast<IntellVoiceEngineType>(slot);
+}
+
+/*
+ * Engines indexed by type, one lock per slot: looking up or creating one engine type never waits
+ * for an operation on another type.
+ */
+class EngineRegistry {
+public:
+    EngineRegistry() = default;
+    ~EngineRegistry() = default;
+
+    sptr<EngineBase> Get(IntellVoiceEngineType type) const;
+    sptr<EngineBase> GetOrCreate(IntellVoiceEngineType type, const std::function<sptr<EngineBase>()> &creator);
+    bool Detach(IntellVoiceEngineType type);
+
+private:
+    struct Slot {
+        mutable std::mutex mutex;
+        sptr<EngineBase> engine = nullptr;
+    };
+
+    std::array<Slot, ENGINE_SLOT_NUM> slots_;
+
+    DISALLOW_COPY(EngineRegistry);
+    DISALLOW_MOVE(EngineRegistry);
+};
+}
+}
+#endif
@@ -16,8 +16,8 @@
 #ifndef INTELL_VOICE_ENGINE_ARBITRATION_H
 #define INTELL_VOICE_ENGINE_ARBITRATION_H
 
-#include <map>
 #include "engine_base.h"
+#include "engine_registry.h"
 
 namespace OHOS {
 namespace IntellVoiceEngine {
@@ -38,19 +38,13 @@ public:
     IntellVoiceEngineArbitration();
     ~IntellVoiceEngineArbitration();
 
-    ArbitrationResult ApplyArbitration(IntellVoiceEngineType type,
-        std::map<IntellVoiceEngineType, sptr<EngineBase>> &engines);
-    sptr<EngineBase> GetEngine(IntellVoiceEngineType type,
-        const std::map<IntellVoiceEngineType, sptr<EngineBase>> &engines);
+    ArbitrationResult ApplyArbitration(IntellVoiceEngineType type, EngineRegistry &engines);
+    sptr<EngineBase> GetEngine(IntellVoiceEngineType type, const EngineRegistry &engines);
 
 private:
-    bool JudgeRejection(IntellVoiceEngineType type, const std::map<IntellVoiceEngineType, sptr<EngineBase>> &engines);
-    void HandlePreemption(IntellVoiceEngineType type,
-        const std::map<IntellVoiceEngineType, sptr<EngineBase>> &engines);
-    void HandleReplace(IntellVoiceEngineType type, std::map<IntellVoiceEngineType, sptr<EngineBase>> &engines);
-
-private:
-    std::map<IntellVoiceEngineType, std::map<IntellVoiceEngineType, EngineRelationType>> engineRelationTbl_;
+    bool JudgeRejection(IntellVoiceEngineType type, const EngineRegistry &engines);
+    void HandlePreemption(IntellVoiceEngineType type, const EngineRegistry &engines);
+    void HandleReplace(IntellVoiceEngineType type, EngineRegistry &engines);
 };
 }
 }
@@ -18,6 +18,7 @@
 #include <map>
 #include <atomic>
 #include "engine_base.h"
+#include "engine_registry.h"
 #include "intell_voice_engine_arbitration.h"
 #include "intell_voice_death_recipient.h"
 #include "update_engine_controller.h"
@@ -98,7 +99,7 @@ private:
     static std::atomic<bool> g_enrollResult[ENGINE_TYPE_BUT];
     static std::atomic<bool> screenoff_;
     std::mutex deathMutex_;
-    std::map<IntellVoiceEngineType, sptr<EngineBase>> engines_;
+    EngineRegistry engines_;
     std::map<IntellVoiceEngineType, sptr<IntellVoiceUtils::IntellVoiceDeathRecipient>> proxyDeathRecipient_;
     std::map<IntellVoiceEngineType, sptr<IRemoteObject>> deathRecipientObj_;
 };
@@ -18,6 +18,8 @@
 
 #define LOG_TAG "IntellVoiceEngineProxy"
 
+using namespace OHOS::IntellVoiceUtils;
+
 namespace OHOS {
 namespace IntellVoiceEngine {
 void IntellVoiceEngineProxy::SetCallback(sptr<IRemoteObject> object)
@@ -178,12 +180,19 @@ int32_t IntellVoiceEngineProxy::StartCapturer(int32_t channels)
 }
 
 int32_t IntellVoiceEngineProxy::Read(std::vector<uint8_t> &data)
+{
+    AudioFrameInfo info;
+    return ReadFrame(data, info);
+}
+
+int32_t IntellVoiceEngineProxy::ReadFrame(std::vector<uint8_t> &data, AudioFrameInfo &info)
 {
     MessageParcel parcelData;
     MessageParcel reply;
     MessageOption option;
 
     parcelData.WriteInterfaceToken(IIntellVoiceEngine::GetDescriptor());
+    parcelData.WriteInt32(readCodec_.load());
     int32_t error = Remote()->SendRequest(INTELL_VOICE_ENGINE_READ, parcelData, reply, option);
     if (error != 0) {
         INTELL_VOICE_LOG_ERROR("read error: %{public}d", error);
@@ -205,11 +214,35 @@ int32_t IntellVoiceEngineProxy::Read(std::vector<uint8_t> &data)
         INTELL_VOICE_LOG_ERROR("buffer is nullptr");
         return -1;
     }
-    data.resize(size);
-    std::copy(buff, buff + size, data.begin());
+    info.sequence = reply.ReadUint64();
+    info.captureTimeUs = reply.ReadInt64();
+    info.droppedFrames = reply.ReadUint64();
+    info.gapCnt = reply.ReadUint64();
+    // the service falls back to pcm when it cannot encode, a service without codec support writes nothing here
+    int32_t codec = reply.ReadInt32();
+    if (codec == AUDIO_CODEC_PCM) {
+        data.resize(size);
+        std::copy(buff, buff + size, data.begin());
+        return ret;
+    }
+
+    if (!AudioCodec::Decode(codec, buff, size, data)) {
+        INTELL_VOICE_LOG_ERROR("failed to decode, codec:%{public}d, size:%{public}u", codec, size);
+        return -1;
+    }
     return ret;
 }
 
+void IntellVoiceEngineProxy::SetReadCodec(int32_t codec)
+{
+    if (!AudioCodec::IsSupported(codec)) {
+        INTELL_VOICE_LOG_ERROR("codec:%{public}d is not supported", codec);
+        return;
+    }
+    INTELL_VOICE_LOG_INFO("read codec:%{public}d", codec);
+    readCodec_.store(codec);
+}
+
 int32_t IntellVoiceEngineProxy::StopCapturer()
 {
     MessageParcel data;
@@ -16,8 +16,10 @@
 #ifndef INTELL_VOICE_ENGINE_PROXY_H
 #define INTELL_VOICE_ENGINE_PROXY_H
 
+#include <atomic>
 #include <iremote_proxy.h>
 #include "i_intell_voice_engine.h"
+#include "audio_codec.h"
 #include "v1_2/intell_voice_engine_types.h"
 
 namespace OHOS {
@@ -38,6 +40,8 @@ public:
     int32_t WriteAudio(const uint8_t *buffer, uint32_t size) override;
     int32_t StartCapturer(int32_t channels) override;
     int32_t Read(std::vector<uint8_t> &data) override;
+    int32_t ReadFrame(std::vector<uint8_t> &data, AudioFrameInfo &info) override;
+    void SetReadCodec(int32_t codec) override;
     int32_t StopCapturer() override;
     int32_t GetWakeupPcm(std::vector<uint8_t> &data) override;
     int32_t Evaluate(const std::string &word, EvaluationResult &result) override;
@@ -46,6 +50,7 @@ public:
 
 private:
     static inline BrokerDelegator<IntellVoiceEngineProxy> delegator_;
+    std::atomic<int32_t> readCodec_ { OHOS::IntellVoiceUtils::AUDIO_CODEC_PCM };
 };
 }
 }
@@ -107,7 +107,7 @@ int32_t IntellVoiceServiceProxy::GetUploadFiles(int numMax, std::vector<UploadFi
         for (int32_t j = 0; j < filesContentSize; j++) {
             file.filesContent.push_back(reply.ReadAshmem());
         }
-        files.push_back(file);
+        files.emplace_back(std::move(file));
     }
     return ret;
 }
@@ -144,6 +144,32 @@ int32_t IntellVoiceServiceProxy::SetParameter(const std::string &keyValueList)
     return reply.ReadInt32();
 }
 
+int32_t IntellVoiceServiceProxy::SetParameters(const IntellVoiceUtils::ParamBatch &batch)
+{
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option;
+
+    const auto &entries = batch.Entries();
+    if (entries.empty() || (entries.size() > PARAM_BATCH_NUM_MAX)) {
+        INTELL_VOICE_LOG_ERROR("invalid parameter num:%{public}zu", entries.size());
+        return -1;
+    }
+
+    data.WriteInterfaceToken(IIntellVoiceService::GetDescriptor());
+    data.WriteUint32(entries.size());
+    for (const auto &entry : entries) {
+        data.WriteUint32(static_cast<uint32_t>(entry.first));
+        data.WriteString(entry.second);
+    }
+    int32_t error = Remote()->SendRequest(HDI_INTELL_VOICE_SERVICE_SET_PARAMETERS, data, reply, option);
+    if (error != 0) {
+        INTELL_VOICE_LOG_ERROR("set parameters error: %{public}d", error);
+        return -1;
+    }
+    return reply.ReadInt32();
+}
+
 int32_t IntellVoiceServiceProxy::GetWakeupSourceFilesList(std::vector<std::string>& cloneFiles)
 {
     MessageParcel data;
@@ -236,6 +262,81 @@ int32_t IntellVoiceServiceProxy::SendWakeupFile(const std::string &filePath, con
     return reply.ReadInt32();
 }
 
+int32_t IntellVoiceServiceProxy::GetWakeupSourceFilesBatch(const std::vector<std::string> &filePaths,
+    uint32_t maxBatchSize, std::vector<uint32_t> &fileSizes, sptr<Ashmem> &ashmem)
+{
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option;
+
+    if (filePaths.empty()) {
+        INTELL_VOICE_LOG_ERROR("file paths is empty");
+        return -1;
+    }
+
+    data.WriteInterfaceToken(IIntellVoiceService::GetDescriptor());
+    data.WriteUint32(maxBatchSize);
+    data.WriteUint32(filePaths.size());
+    for (const auto &filePath : filePaths) {
+        data.WriteString(filePath);
+    }
+    int32_t error = Remote()->SendRequest(HDI_INTELL_VOICE_SERVICE_GET_CLONE_FILES_BATCH, data, reply, option);
+    if (error != 0) {
+        INTELL_VOICE_LOG_ERROR("get wakeup source files batch error: %{public}d", error);
+        return -1;
+    }
+    int32_t ret = reply.ReadInt32();
+    if (ret != 0) {
+        INTELL_VOICE_LOG_ERROR("get wakeup source files batch failed, ret:%{public}d", ret);
+        return ret;
+    }
+
+    uint32_t count = reply.ReadUint32();
+    if (count == 0 || count > filePaths.size()) {
+        INTELL_VOICE_LOG_ERROR("invalid file count %{public}u", count);
+        return -1;
+    }
+
+    fileSizes.reserve(count);
+    for (uint32_t i = 0; i < count; i++) {
+        fileSizes.push_back(reply.ReadUint32());
+    }
+
+    ashmem = reply.ReadAshmem();
+    if (ashmem == nullptr) {
+        INTELL_VOICE_LOG_ERROR("ashmem is nullptr");
+        return -1;
+    }
+    return ret;
+}
+
+int32_t IntellVoiceServiceProxy::SendWakeupFilesBatch(const std::vector<std::string> &filePaths,
+    const std::vector<uint32_t> &fileSizes, const sptr<Ashmem> &ashmem)
+{
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option;
+
+    if (filePaths.empty() || (filePaths.size() != fileSizes.size()) || (ashmem == nullptr)) {
+        INTELL_VOICE_LOG_ERROR("invalid files batch");
+        return -1;
+    }
+
+    data.WriteInterfaceToken(IIntellVoiceService::GetDescriptor());
+    data.WriteUint32(filePaths.size());
+    for (size_t i = 0; i < filePaths.size(); i++) {
+        data.WriteString(filePaths[i]);
+        data.WriteUint32(fileSizes[i]);
+    }
+    data.WriteAshmem(ashmem);
+    int32_t error = Remote()->SendRequest(HDI_INTELL_VOICE_SERVICE_SEND_CLONE_FILES_BATCH, data, reply, option);
+    if (error != 0) {
+        INTELL_VOICE_LOG_ERROR("send wakeup files batch error: %{public}d", error);
+        return -1;
+    }
+    return reply.ReadInt32();
+}
+
 int32_t IntellVoiceServiceProxy::EnrollWithWakeupFilesForResult(const std::string &wakeupInfo,
     sptr<IRemoteObject> object)
 {
@@ -31,10 +31,15 @@ public:
     int32_t ReleaseIntellVoiceEngine(IntellVoiceEngineType type) override;
     int32_t GetUploadFiles(int numMax, std::vector<UploadFilesFromHdi> &files) override;
     int32_t SetParameter(const std::string &keyValueList) override;
+    int32_t SetParameters(const IntellVoiceUtils::ParamBatch &batch) override;
     std::string GetParameter(const std::string &key) override;
     int32_t GetWakeupSourceFilesList(std::vector<std::string> &cloneFiles) override;
     int32_t GetWakeupSourceFile(const std::string &filePath, std::vector<uint8_t> &buffer) override;
     int32_t SendWakeupFile(const std::string &filePath, const std::vector<uint8_t> &buffer) override;
+    int32_t GetWakeupSourceFilesBatch(const std::vector<std::string> &filePaths, uint32_t maxBatchSize,
+        std::vector<uint32_t> &fileSizes, sptr<Ashmem> &ashmem) override;
+    int32_t SendWakeupFilesBatch(const std::vector<std::string> &filePaths,
+        const std::vector<uint32_t> &fileSizes, const sptr<Ashmem> &ashmem) override;
     int32_t EnrollWithWakeupFilesForResult(const std::string &wakeupInfo, const sptr<IRemoteObject> object) override;
     int32_t ClearUserData() override;
 
@@ -16,8 +16,11 @@
 
 #include "securec.h"
 #include "intell_voice_log.h"
+#include "hot_log.h"
 #include "memory_guard.h"
 #include "array_buffer_util.h"
+#include "standby_holder.h"
+#include "time_util.h"
 
 #define LOG_TAG "AudioSource"
 
@@ -28,6 +31,18 @@ namespace OHOS {
 namespace IntellVoiceEngine {
 static const std::string CACHE_PATH = "/data/data/intell_voice/cache/";
 
+// one warm capturer is shared by all sources, a source with other options releases it on start
+static StandbyHolder<AudioCapturer> &GetCapturerStandby()
+{
+    static StandbyHolder<AudioCapturer> standby([](std::unique_ptr<AudioCapturer> capturer) {
+        INTELL_VOICE_LOG_INFO("release standby capturer");
+        if (!capturer->Release()) {
+            INTELL_VOICE_LOG_ERROR("release standby capturer error");
+        }
+    });
+    return standby;
+}
+
 AudioSource::AudioSource(uint32_t minBufferSize, uint32_t bufferCnt,
     std::unique_ptr<AudioSourceListener> listener, const OHOS::AudioStandard::AudioCapturerOptions &capturerOptions)
     : minBufferSize_(minBufferSize), bufferCnt_(bufferCnt), listener_(std::move(listener))
@@ -64,16 +79,7 @@ bool AudioSource::Start()
         return false;
     }
 
-    audioCapturer_ = AudioCapturer::Create(capturerOptions_, CACHE_PATH);
-    if (audioCapturer_ == nullptr) {
-        INTELL_VOICE_LOG_ERROR("audioCapturer_ is nullptr");
-        return false;
-    }
-
-    if (!audioCapturer_->Start()) {
-        INTELL_VOICE_LOG_ERROR("start audio capturer failed");
-        audioCapturer_->Release();
-        audioCapturer_ = nullptr;
+    if (!StartCapturer()) {
         return false;
     }
 
@@ -92,6 +98,48 @@ bool AudioSource::Start()
     return true;
 }
 
+bool AudioSource::StartCapturer()
+{
+    int64_t beginUs = TimeUtil::GetMonotonicTimeUs();
+    audioCapturer_ = GetCapturerStandby().Take(GetCapturerKey());
+    bool isWarm = (audioCapturer_ != nullptr);
+    if (isWarm && !audioCapturer_->Start()) {
+        INTELL_VOICE_LOG_WARN("restart standby capturer failed, create a new one");
+        audioCapturer_->Release();
+        audioCapturer_ = nullptr;
+        isWarm = false;
+    }
+
+    if (audioCapturer_ == nullptr) {
+        audioCapturer_ = AudioCapturer::Create(capturerOptions_, CACHE_PATH);
+        if (audioCapturer_ == nullptr) {
+            INTELL_VOICE_LOG_ERROR("audioCapturer_ is nullptr");
+            return false;
+        }
+
+        if (!audioCapturer_->Start()) {
+            INTELL_VOICE_LOG_ERROR("start audio capturer failed");
+            audioCapturer_->Release();
+            audioCapturer_ = nullptr;
+            return false;
+        }
+    }
+
+    INTELL_VOICE_LOG_INFO("%{public}s start, cost:%{public}lld us", isWarm ? "warm" : "cold",
+        static_cast<long long>(TimeUtil::GetMonotonicTimeUs() - beginUs));
+    return true;
+}
+
+std::string AudioSource::GetCapturerKey() const
+{
+    return std::to_string(capturerOptions_.streamInfo.samplingRate) + "_" +
+        std::to_string(capturerOptions_.streamInfo.encoding) + "_" +
+        std::to_string(capturerOptions_.streamInfo.format) + "_" +
+        std::to_string(capturerOptions_.streamInfo.channels) + "_" +
+        std::to_string(capturerOptions_.capturerInfo.sourceType) + "_" +
+        std::to_string(capturerOptions_.capturerInfo.capturerFlags);
+}
+
 void AudioSource::Run()
 {
     INTELL_VOICE_LOG_INFO("enter");
@@ -111,6 +159,7 @@ void AudioSource::Run()
             break;
         }
         ++readCnt;
+        INTELL_VOICE_HOT_RECORD("audio_read", readCnt, minBufferSize_);
     }
 }
 
@@ -156,14 +205,27 @@ void AudioSource::Stop()
 
     if (!audioCapturer_->Stop()) {
         INTELL_VOICE_LOG_ERROR("stop audio capturer error");
+    } else if (standbyMs_ != 0) {
+        INTELL_VOICE_LOG_INFO("keep capturer in standby for %{public}u ms", standbyMs_);
+        GetCapturerStandby().Park(std::move(audioCapturer_), GetCapturerKey(), standbyMs_);
     }
 
-    if (!audioCapturer_->Release()) {
+    if ((audioCapturer_ != nullptr) && !audioCapturer_->Release()) {
         INTELL_VOICE_LOG_ERROR("release audio capturer error");
     }
 
     audioCapturer_ = nullptr;
     listener_ = nullptr;
 }
+
+void AudioSource::SetStandbyMs(uint32_t standbyMs)
+{
+    standbyMs_ = standbyMs;
+}
+
+void AudioSource::FlushStandby()
+{
+    GetCapturerStandby().Flush();
+}
 }
 }
\ No newline at end of file
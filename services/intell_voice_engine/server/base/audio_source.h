@@ -19,6 +19,7 @@
 #include <functional>
 #include <thread>
 #include <atomic>
+#include <string>
 #include "audio_capturer.h"
 #include "audio_info.h"
 #include "audio_debug.h"
@@ -47,14 +48,21 @@ public:
     ~AudioSource();
     bool Start();
     void Stop();
+    // keep the stopped capturer for standbyMs so the next source with the same options starts warm, 0 disables
+    void SetStandbyMs(uint32_t standbyMs);
+    // release a capturer kept in standby right away
+    static void FlushStandby();
 
 private:
     void Run();
     bool Read();
+    bool StartCapturer();
+    std::string GetCapturerKey() const;
 
 private:
     uint32_t minBufferSize_ = 0;
     uint32_t bufferCnt_ = 0;
+    uint32_t standbyMs_ = 0;
     bool isEnd_ = false;
     std::unique_ptr<AudioSourceListener> listener_ = nullptr;
     std::atomic<bool> isReading_ = false;
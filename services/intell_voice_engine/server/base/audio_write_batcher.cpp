@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "audio_write_batcher.h"
+#include "intell_voice_log.h"
+
+#define LOG_TAG "AudioWriteBatcher"
+
+namespace OHOS {
+namespace IntellVoiceEngine {
+static constexpr uint32_t MAX_BATCH_LATENCY_MS = 200;
+
+void AudioWriteBatcher::Configure(uint32_t maxLatencyMs, uint32_t bytesPerMs)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (maxLatencyMs > MAX_BATCH_LATENCY_MS) {
+        INTELL_VOICE_LOG_WARN("max latency %{public}u ms is too large, use %{public}u ms", maxLatencyMs,
+            MAX_BATCH_LATENCY_MS);
+        maxLatencyMs = MAX_BATCH_LATENCY_MS;
+    }
+    batchBytes_ = maxLatencyMs * bytesPerMs;
+    batch_.clear();
+    batch_.reserve(batchBytes_);
+    INTELL_VOICE_LOG_INFO("max latency:%{public}u ms, batch bytes:%{public}u", maxLatencyMs, batchBytes_);
+}
+
+int32_t AudioWriteBatcher::Write(const std::shared_ptr<IAdapterHostManager> &adapter, const uint8_t *buffer,
+    uint32_t size)
+{
+    if ((adapter == nullptr) || (buffer == nullptr) || (size == 0)) {
+        INTELL_VOICE_LOG_ERROR("invalid param, size:%{public}u", size);
+        return -1;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    batch_.insert(batch_.end(), buffer, buffer + size);
+    if (batch_.size() < batchBytes_) {
+        return 0;
+    }
+    return FlushLocked(adapter);
+}
+
+int32_t AudioWriteBatcher::Write(const std::shared_ptr<IAdapterHostManager> &adapter,
+    const std::vector<uint8_t> &frame)
+{
+    if ((adapter == nullptr) || frame.empty()) {
+        INTELL_VOICE_LOG_ERROR("invalid param");
+        return -1;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (batchBytes_ == 0) {
+        return adapter->WriteAudio(frame);
+    }
+    batch_.insert(batch_.end(), frame.begin(), frame.end());
+    if (batch_.size() < batchBytes_) {
+        return 0;
+    }
+    return FlushLocked(adapter);
+}
+
+int32_t AudioWriteBatcher::WritePlanes(const std::shared_ptr<IAdapterHostManager> &adapter,
+    const std::vector<std::vector<uint8_t>> &planes, uint32_t planeCnt)
+{
+    if ((adapter == nullptr) || (planeCnt == 0) || (planeCnt > planes.size())) {
+        INTELL_VOICE_LOG_ERROR("invalid param, plane cnt:%{public}u", planeCnt);
+        return -1;
+    }
+
+    // the adapter expects all planes of one frame in a single call, so planar frames are never merged
+    std::lock_guard<std::mutex> lock(mutex_);
+    int32_t ret = FlushLocked(adapter);
+    for (uint32_t i = 0; i < planeCnt; i++) {
+        batch_.insert(batch_.end(), planes[i].begin(), planes[i].end());
+    }
+    int32_t planeRet = FlushLocked(adapter);
+    return (ret != 0) ? ret : planeRet;
+}
+
+int32_t AudioWriteBatcher::Flush(const std::shared_ptr<IAdapterHostManager> &adapter)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return FlushLocked(adapter);
+}
+
+void AudioWriteBatcher::Reset()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    batch_.clear();
+}
+
+int32_t AudioWriteBatcher::FlushLocked(const std::shared_ptr<IAdapterHostManager> &adapter)
+{
+    if (batch_.empty()) {
+        return 0;
+    }
+    if (adapter == nullptr) {
+        INTELL_VOICE_LOG_ERROR("adapter is nullptr, drop %{public}zu bytes", batch_.size());
+        batch_.clear();
+        return -1;
+    }
+
+    int32_t ret = adapter->WriteAudio(batch_);
+    // clear keeps the capacity, so steady state submission does not allocate
+    batch_.clear();
+    return ret;
+}
+}
+}
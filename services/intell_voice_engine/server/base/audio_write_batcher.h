@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef AUDIO_WRITE_BATCHER_H
+#define AUDIO_WRITE_BATCHER_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "i_adapter_host_manager.h"
+
+namespace OHOS {
+namespace IntellVoiceEngine {
+/*
+ * Coalesces captured frames into one reusable buffer before handing them to the engine adapter.
+ * With a zero max latency (old HDI, or batching not advertised) every frame is submitted on its own,
+ * which keeps the original per-frame behaviour.
+ */
+class AudioWriteBatcher {
+public:
+    AudioWriteBatcher() = default;
+    ~AudioWriteBatcher() = default;
+    void Configure(uint32_t maxLatencyMs, uint32_t bytesPerMs);
+    int32_t Write(const std::shared_ptr<IAdapterHostManager> &adapter, const uint8_t *buffer, uint32_t size);
+    int32_t Write(const std::shared_ptr<IAdapterHostManager> &adapter, const std::vector<uint8_t> &frame);
+    int32_t WritePlanes(const std::shared_ptr<IAdapterHostManager> &adapter,
+        const std::vector<std::vector<uint8_t>> &planes, uint32_t planeCnt);
+    int32_t Flush(const std::shared_ptr<IAdapterHostManager> &adapter);
+    void Reset();
+
+private:
+    int32_t FlushLocked(const std::shared_ptr<IAdapterHostManager> &adapter);
+
+private:
+    std::mutex mutex_;
+    uint32_t batchBytes_ = 0;
+    std::vector<uint8_t> batch_;
+};
+}
+}
+#endif
@@ -13,6 +13,7 @@
  * limitations under the License.
  */
 #include "data_operation_callback.h"
+#include <sys/mman.h>
 #include "intell_voice_log.h"
 #include "huks_aes_adapter.h"
 #include "scope_guard.h"
@@ -46,106 +47,66 @@ int32_t DataOperationCallback::OnIntellVoiceDataOprEvent(
         return -1;
     }
 
-    auto inData = CreateArrayBufferFromAshmem(inBuffer);
-    if (inData == nullptr) {
-        INTELL_VOICE_LOG_ERROR("create in data failed");
+    uint32_t inSize = static_cast<uint32_t>(inBuffer->GetAshmemSize());
+    if ((inSize == 0) || !inBuffer->MapReadOnlyAshmem()) {
+        INTELL_VOICE_LOG_ERROR("failed to map in buffer, size:%{public}u", inSize);
         return -1;
     }
 
-    int32_t ret = HKS_SUCCESS;
-    std::unique_ptr<OHOS::IntellVoiceUtils::Uint8ArrayBuffer> outData = nullptr;
-
-    if (type == OHOS::HDI::IntelligentVoice::Engine::V1_1::ENCRYPT_TYPE) {
-        ret = HuksAesAdapter::Encrypt(inData, outData);
-        if (ret != HKS_SUCCESS) {
-            INTELL_VOICE_LOG_ERROR("encrypt failed, ret:%{public}d", ret);
-            return -1;
-        }
-        outBuffer = CreateAshmemFromArrayBuffer(outData, "EnryptOutIntellVoiceData");
-    } else if (type == OHOS::HDI::IntelligentVoice::Engine::V1_1::DECRYPT_TYPE) {
-        ret = HuksAesAdapter::Decrypt(inData, outData);
-        if (ret != HKS_SUCCESS) {
-            INTELL_VOICE_LOG_ERROR("decrypt failed, ret:%{public}d", ret);
-            return -1;
-        }
-        outBuffer = CreateAshmemFromArrayBuffer(outData, "DeryptOutIntellVoiceData");
+    const uint8_t *inMem = static_cast<const uint8_t *>(inBuffer->ReadFromAshmem(inSize, 0));
+    if (inMem == nullptr) {
+        INTELL_VOICE_LOG_ERROR("read from ashmem failed");
+        return -1;
     }
 
-    if (outBuffer == nullptr) {
+    bool isEncrypt = (type == OHOS::HDI::IntelligentVoice::Engine::V1_1::ENCRYPT_TYPE);
+    uint32_t outSize = isEncrypt ? HuksAesAdapter::GetEncryptSize(inSize) : HuksAesAdapter::GetDecryptSize(inSize);
+    sptr<Ashmem> outAshmem = CreateOutAshmem(outSize,
+        isEncrypt ? "EnryptOutIntellVoiceData" : "DeryptOutIntellVoiceData");
+    if (outAshmem == nullptr) {
         INTELL_VOICE_LOG_ERROR("out buffer is nullptr");
         return -1;
     }
 
-    INTELL_VOICE_LOG_INFO("exit");
-    return 0;
-}
-
-std::unique_ptr<OHOS::IntellVoiceUtils::Uint8ArrayBuffer> DataOperationCallback::CreateArrayBufferFromAshmem(
-    const sptr<Ashmem> &ashmem)
-{
-    if (ashmem == nullptr) {
-        INTELL_VOICE_LOG_ERROR("ashmem is nullptr");
-        return nullptr;
-    }
-
-    uint32_t size = static_cast<uint32_t>(ashmem->GetAshmemSize());
-    if (size == 0) {
-        INTELL_VOICE_LOG_ERROR("size is zero");
-        return nullptr;
-    }
+    ON_SCOPE_EXIT_WITH_NAME(outExit) {
+        outAshmem->CloseAshmem();
+    };
 
-    if (!ashmem->MapReadOnlyAshmem()) {
-        INTELL_VOICE_LOG_ERROR("map ashmem failed");
-        return nullptr;
+    // huks reads the in buffer and writes the out buffer in place, nothing is copied
+    void *outMem = mmap(nullptr, outSize, PROT_READ | PROT_WRITE, MAP_SHARED, outAshmem->GetAshmemFd(), 0);
+    if (outMem == MAP_FAILED) {
+        INTELL_VOICE_LOG_ERROR("failed to map out buffer");
+        return -1;
     }
 
-    const uint8_t *mem = static_cast<const uint8_t *>(ashmem->ReadFromAshmem(size, 0));
-    if (mem == nullptr) {
-        INTELL_VOICE_LOG_ERROR("read from ashmem failed");
-        return nullptr;
+    struct HksBlob inData = { inSize, const_cast<uint8_t *>(inMem) };
+    struct HksBlob outData = { outSize, static_cast<uint8_t *>(outMem) };
+    int32_t ret = isEncrypt ? HuksAesAdapter::Encrypt(&inData, &outData) : HuksAesAdapter::Decrypt(&inData, &outData);
+    munmap(outMem, outSize);
+    if ((ret != HKS_SUCCESS) || (outData.size != outSize)) {
+        INTELL_VOICE_LOG_ERROR("%{public}s failed, ret:%{public}d, size:%{public}u", isEncrypt ? "encrypt" : "decrypt",
+            ret, outData.size);
+        return -1;
     }
 
-    return CreateArrayBuffer<uint8_t>(size, mem);
+    outExit.Disable();
+    outBuffer = outAshmem;
+    INTELL_VOICE_LOG_INFO("exit, size:%{public}u", outSize);
+    return 0;
 }
 
-sptr<Ashmem> DataOperationCallback::CreateAshmemFromArrayBuffer(
-    const std::unique_ptr<OHOS::IntellVoiceUtils::Uint8ArrayBuffer> &buffer, const std::string &name)
+sptr<Ashmem> DataOperationCallback::CreateOutAshmem(uint32_t size, const std::string &name)
 {
-    if (buffer == nullptr) {
-        INTELL_VOICE_LOG_ERROR("buffer is nullptr");
-        return nullptr;
-    }
-
-    if ((buffer->GetSize() == 0) || (buffer->GetData() == nullptr)) {
-        INTELL_VOICE_LOG_ERROR("data is empty");
+    if (size == 0) {
+        INTELL_VOICE_LOG_ERROR("size is zero");
         return nullptr;
     }
 
-    sptr<Ashmem> ashmem = OHOS::Ashmem::CreateAshmem(name.c_str(), buffer->GetSize() * sizeof(uint8_t));
+    sptr<Ashmem> ashmem = OHOS::Ashmem::CreateAshmem(name.c_str(), size);
     if (ashmem == nullptr) {
         INTELL_VOICE_LOG_ERROR("failed to create ashmem");
         return nullptr;
     }
-
-    ON_SCOPE_EXIT {
-        ashmem->UnmapAshmem();
-        ashmem->CloseAshmem();
-        ashmem = nullptr;
-    };
-
-    if (!ashmem->MapReadAndWriteAshmem()) {
-        INTELL_VOICE_LOG_ERROR("failed to map ashmem");
-        return nullptr;
-    }
-
-    if (!ashmem->WriteToAshmem(buffer->GetData(), buffer->GetSize() * sizeof(uint8_t), 0)) {
-        INTELL_VOICE_LOG_ERROR("failed to write ashmem");
-        return nullptr;
-    }
-
-    CANCEL_SCOPE_EXIT;
-    INTELL_VOICE_LOG_INFO("create ashmem success, size:%{public}u",
-        static_cast<uint32_t>(buffer->GetSize() * sizeof(uint8_t)));
     return ashmem;
 }
 }
@@ -19,7 +19,6 @@
 #include <memory>
 #include <string>
 #include "v1_1/iintell_voice_data_opr_callback.h"
-#include "array_buffer_util.h"
 
 namespace OHOS {
 namespace IntellVoiceEngine {
@@ -34,9 +33,7 @@ public:
         sptr<Ashmem> &outBuffer) override;
 
 private:
-    std::unique_ptr<OHOS::IntellVoiceUtils::Uint8ArrayBuffer> CreateArrayBufferFromAshmem(const sptr<Ashmem> &ashmem);
-    sptr<Ashmem> CreateAshmemFromArrayBuffer(const std::unique_ptr<OHOS::IntellVoiceUtils::Uint8ArrayBuffer> &buffer,
-        const std::string &name);
+    sptr<Ashmem> CreateOutAshmem(uint32_t size, const std::string &name);
 };
 }
 }
@@ -26,6 +26,12 @@ int32_t EngineBase::Read(std::vector<uint8_t> & /* data */)
     return 0;
 }
 
+int32_t EngineBase::ReadFrame(std::vector<uint8_t> &data, AudioFrameInfo &info)
+{
+    info = AudioFrameInfo();
+    return Read(data);
+}
+
 int32_t EngineBase::StopCapturer()
 {
     return 0;
@@ -34,6 +34,9 @@ namespace OHOS {
 namespace IntellVoiceEngine {
 static const std::string LANGUAGE_TEXT = "language=";
 static const std::string AREA_TEXT = "area=";
+static const std::string AUDIO_BATCH_MAX_LATENCY_MS = "audio_batch_max_latency_ms";
+static constexpr uint32_t MS_PER_S = 1000;
+static constexpr uint32_t BITS_PER_BYTE = 8;
 static const int32_t INTELL_VOICE_SERVICE_UID = 1042;
 
 EngineUtil::EngineUtil()
@@ -47,6 +50,8 @@ int32_t EngineUtil::SetParameter(const std::string &keyValueList)
         INTELL_VOICE_LOG_ERROR("adapter is nullptr");
         return -1;
     }
+    // keep parameters such as end_of_pcm ordered after the audio already written
+    audioBatcher_.Flush(adapter_);
     return adapter_->SetParameter(keyValueList);
 }
 
@@ -74,8 +79,43 @@ int32_t EngineUtil::WriteAudio(const uint8_t *buffer, uint32_t size)
         return -1;
     }
 
-    std::vector<uint8_t> audioBuff(&buffer[0], &buffer[size]);
-    return adapter_->WriteAudio(audioBuff);
+    return audioBatcher_.Write(adapter_, buffer, size);
+}
+
+int32_t EngineUtil::WriteAudio(const std::vector<uint8_t> &frame)
+{
+    if (adapter_ == nullptr) {
+        INTELL_VOICE_LOG_ERROR("adapter is nullptr");
+        return -1;
+    }
+    return audioBatcher_.Write(adapter_, frame);
+}
+
+int32_t EngineUtil::WriteAudioPlanes(const std::vector<std::vector<uint8_t>> &planes, uint32_t planeCnt)
+{
+    if (adapter_ == nullptr) {
+        INTELL_VOICE_LOG_ERROR("adapter is nullptr");
+        return -1;
+    }
+    return audioBatcher_.WritePlanes(adapter_, planes, planeCnt);
+}
+
+int32_t EngineUtil::FlushAudio()
+{
+    return audioBatcher_.Flush(adapter_);
+}
+
+void EngineUtil::NegotiateAudioBatch(const IntellVoiceEngineAdapterInfo &info)
+{
+    uint32_t bytesPerMs = static_cast<uint32_t>(info.sampleRate) / MS_PER_S *
+        static_cast<uint32_t>(info.bitsPerSample) / BITS_PER_BYTE * static_cast<uint32_t>(info.sampleChannels);
+    // adapters that do not know the key leave the value empty and keep per-frame submission
+    int32_t maxLatencyMs = 0;
+    std::string value = GetParameter(AUDIO_BATCH_MAX_LATENCY_MS);
+    if (value.empty() || !StringUtil::StringToInt(value, maxLatencyMs) || (maxLatencyMs < 0)) {
+        maxLatencyMs = 0;
+    }
+    audioBatcher_.Configure(static_cast<uint32_t>(maxLatencyMs), bytesPerMs);
 }
 
 int32_t EngineUtil::Stop()
@@ -84,6 +124,7 @@ int32_t EngineUtil::Stop()
         INTELL_VOICE_LOG_ERROR("adapter is nullptr");
         return -1;
     }
+    audioBatcher_.Reset();
     return adapter_->Stop();
 }
 
@@ -25,6 +25,7 @@
 #include "v1_0/iintell_voice_engine_adapter.h"
 #include "v1_0/iintell_voice_engine_callback.h"
 #include "audio_system_manager.h"
+#include "audio_write_batcher.h"
 
 namespace OHOS {
 namespace IntellVoiceEngine {
@@ -59,6 +60,7 @@ struct SetListenerMsg {
 
 struct CapturerData {
     std::vector<uint8_t> data;
+    AudioFrameInfo info;
 };
 
 struct StringParam {
@@ -88,6 +90,10 @@ public:
     int32_t SetParameter(const std::string &keyValueList);
     std::string GetParameter(const std::string &key);
     int32_t WriteAudio(const uint8_t *buffer, uint32_t size);
+    int32_t WriteAudio(const std::vector<uint8_t> &frame);
+    int32_t WriteAudioPlanes(const std::vector<std::vector<uint8_t>> &planes, uint32_t planeCnt);
+    int32_t FlushAudio();
+    void NegotiateAudioBatch(const OHOS::HDI::IntelligentVoice::Engine::V1_0::IntellVoiceEngineAdapterInfo &info);
     int32_t Stop();
     int32_t GetWakeupPcm(std::vector<uint8_t> &data);
     int32_t Evaluate(const std::string &word, EvaluationResultInfo &info);
@@ -107,6 +113,8 @@ protected:
     OHOS::HDI::IntelligentVoice::Engine::V1_0::IntellVoiceEngineAdapterDescriptor desc_;
 
 private:
+    AudioWriteBatcher audioBatcher_;
+
     static void WriteBufferFromAshmem(uint8_t *&buffer, uint32_t size, sptr<OHOS::Ashmem> ashmem);
 };
 }
@@ -16,9 +16,12 @@
 #include "intell_voice_engine_stub.h"
 #include "securec.h"
 #include "intell_voice_log.h"
+#include "audio_codec.h"
 
 #define LOG_TAG "IntellVoiceEngineStub"
 
+using namespace OHOS::IntellVoiceUtils;
+
 namespace OHOS {
 namespace IntellVoiceEngine {
 IntellVoiceEngineStub::IntellVoiceEngineStub()
@@ -162,16 +165,34 @@ int32_t IntellVoiceEngineStub::StartCapturerInner(MessageParcel &data, MessagePa
 
 int32_t IntellVoiceEngineStub::ReadInner(MessageParcel &data, MessageParcel &reply)
 {
+    // an older proxy sends no codec, which reads as pcm
+    int32_t codec = data.ReadInt32();
     std::vector<uint8_t> pcmData;
-    int32_t ret = Read(pcmData);
+    AudioFrameInfo info;
+    int32_t ret = ReadFrame(pcmData, info);
     reply.WriteInt32(ret);
     if (ret != 0) {
         INTELL_VOICE_LOG_ERROR("failed to read wakeup pcm, ret:%{public}d", ret);
         return ret;
     }
 
+    if (codec != AUDIO_CODEC_PCM) {
+        std::vector<uint8_t> encoded;
+        if (AudioCodec::Encode(codec, pcmData, encoded)) {
+            pcmData.swap(encoded);
+        } else {
+            codec = AUDIO_CODEC_PCM;
+        }
+    }
+
     reply.WriteUint32(pcmData.size());
     reply.WriteBuffer(pcmData.data(), pcmData.size());
+    // frame info and codec trail the pcm so that the reply layout of older fields is unchanged
+    reply.WriteUint64(info.sequence);
+    reply.WriteInt64(info.captureTimeUs);
+    reply.WriteUint64(info.droppedFrames);
+    reply.WriteUint64(info.gapCnt);
+    reply.WriteInt32(codec);
     return ret;
 }
 
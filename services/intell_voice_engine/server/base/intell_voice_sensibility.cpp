@@ -16,6 +16,8 @@
 
 #include <fstream>
 #include <algorithm>
+#include <cerrno>
+#include <sys/stat.h>
 
 #include "history_info_mgr.h"
 #include "intell_voice_log.h"
@@ -33,8 +35,12 @@ static constexpr int32_t MIN_SENSIBILITY_VALUE = 1;
 static constexpr int32_t MAX_SENSIBILITY_VALUE = 3;
 static constexpr int32_t THRESH_OFFST = 3;
 static constexpr uint32_t HAL_FEATURE_KWS_NODES_900 = 0x2;
+static constexpr int64_t NS_PER_S = 1000000000;
 static const std::string WAKEUP_CONF_DEFAULPHRASE = "DefaultPhrase";
 
+std::mutex IntellVoiceSensibility::tableMutex_;
+IntellVoiceSensibility::SensibilityTable IntellVoiceSensibility::table_;
+
 std::string IntellVoiceSensibility::GetDspSensibility(const std::string &sensibility, const std::string &dspFeature,
     const std::string &configPath)
 {
@@ -53,16 +59,63 @@ std::string IntellVoiceSensibility::GetDspSensibility(const std::string &sensibi
         return "";
     }
     int32_t index = (IsSupportNodes800(dspFeature) ? (value + THRESH_OFFST - 1) : (value - 1));
-    return ParseWakeupConfigDspSensibility(wakeupPhrase, static_cast<uint32_t>(index), configPath);
+    return LookupDspSensibility(wakeupPhrase, static_cast<uint32_t>(index), configPath);
 }
 
-std::string IntellVoiceSensibility::ParseWakeupConfigDspSensibility(const std::string &wakeupPhrase, uint32_t index,
+std::string IntellVoiceSensibility::LookupDspSensibility(const std::string &wakeupPhrase, uint32_t index,
     const std::string &configPath)
+{
+    std::lock_guard<std::mutex> lock(tableMutex_);
+    if (!RefreshTableLocked(configPath)) {
+        return "";
+    }
+
+    auto it = table_.phraseThresholds.find(wakeupPhrase);
+    if (it != table_.phraseThresholds.end()) {
+        return GetThreshold(it->second, index);
+    }
+
+    if (IsDefaltPhrase(table_, wakeupPhrase)) {
+        return GetThreshold(table_.defaultThresholds, index);
+    }
+    // the user defined slot only has to be valid, the threshold itself comes from Default
+    if (GetThreshold(table_.userThresholds, index).empty()) {
+        return "";
+    }
+    return GetThreshold(table_.defaultThresholds, index);
+}
+
+bool IntellVoiceSensibility::RefreshTableLocked(const std::string &configPath)
+{
+    struct stat fileStat;
+    if (stat(configPath.c_str(), &fileStat) != 0) {
+        INTELL_VOICE_LOG_ERROR("failed to stat config, errno:%{public}d", errno);
+        return false;
+    }
+
+    int64_t mtimeNs = static_cast<int64_t>(fileStat.st_mtim.tv_sec) * NS_PER_S +
+        static_cast<int64_t>(fileStat.st_mtim.tv_nsec);
+    if ((table_.configPath == configPath) && (table_.mtimeNs == mtimeNs)) {
+        return true;
+    }
+
+    SensibilityTable table;
+    if (!LoadTable(configPath, table)) {
+        return false;
+    }
+    table.configPath = configPath;
+    table.mtimeNs = mtimeNs;
+    table_ = std::move(table);
+    INTELL_VOICE_LOG_INFO("sensibility table loaded, phrase num:%{public}zu", table_.phraseThresholds.size());
+    return true;
+}
+
+bool IntellVoiceSensibility::LoadTable(const std::string &configPath, SensibilityTable &table)
 {
     std::ifstream jsonStrm(configPath);
     if (!jsonStrm.is_open()) {
         INTELL_VOICE_LOG_ERROR("open file faile!");
-        return "";
+        return false;
     }
     Json::Value wakeupJson;
     Json::CharReaderBuilder reader;
@@ -70,77 +123,64 @@ std::string IntellVoiceSensibility::ParseWakeupConfigDspSensibility(const std::s
     std::string errs;
     if (!parseFromStream(reader, jsonStrm, &wakeupJson, &errs)) {
         INTELL_VOICE_LOG_ERROR("parseFromStream json faile!");
-        return "";
-    }
-
-    if (IsDefaltPhrase(wakeupJson, wakeupPhrase)) {
-        return ParseDefaultDspSensibility(wakeupJson, wakeupPhrase, index);
+        return false;
     }
 
-    return ParseUserDspSensibility(wakeupJson, index);
-}
-
-std::string IntellVoiceSensibility::ParseDefaultDspSensibility(const Json::Value &wakeupJson,
-    const std::string &wakeupPhrase, uint32_t index)
-{
-    if ((wakeupJson.isMember(WAKEUP_CONF_DEFAULPHRASE)) &&
-        (wakeupJson[WAKEUP_CONF_DEFAULPHRASE].isMember(wakeupPhrase))) {
-        Json::Value sensibilityArray = wakeupJson[WAKEUP_CONF_DEFAULPHRASE][wakeupPhrase];
-        if ((sensibilityArray.isArray()) && (sensibilityArray.size() > index) && (sensibilityArray[index].isInt())) {
-            return std::to_string(sensibilityArray[index].asInt());
+    if (wakeupJson.isMember(WAKEUP_CONF_DEFAULPHRASE) && wakeupJson[WAKEUP_CONF_DEFAULPHRASE].isObject()) {
+        table.hasDefaultPhraseNode = true;
+        const Json::Value &phrases = wakeupJson[WAKEUP_CONF_DEFAULPHRASE];
+        for (const auto &phrase : phrases.getMemberNames()) {
+            ParseThresholds(phrases[phrase], table.phraseThresholds[phrase]);
         }
-        INTELL_VOICE_LOG_WARN("index:%{public}u, default sensibility is invalid", index);
-        return "";
     }
+
     if ((!wakeupJson.isMember("SensibilityParams")) ||
         (!wakeupJson["SensibilityParams"].isMember("DspSentenceThresholds"))) {
         INTELL_VOICE_LOG_WARN("no sensiblity param");
-        return "";
+        return true;
     }
 
-    Json::Value sensibilityParam = wakeupJson["SensibilityParams"]["DspSentenceThresholds"];
-    if ((sensibilityParam.isMember("Default")) && (sensibilityParam["Default"].isArray()) &&
-        (sensibilityParam["Default"].size() > index) && sensibilityParam["Default"][index].isInt()) {
-        return std::to_string(sensibilityParam["Default"][index].asInt());
+    const Json::Value &sensibilityParam = wakeupJson["SensibilityParams"]["DspSentenceThresholds"];
+    if (sensibilityParam.isMember("Default")) {
+        ParseThresholds(sensibilityParam["Default"], table.defaultThresholds);
     }
-
-    INTELL_VOICE_LOG_WARN("index:%{public}u, default sensibility param is invalid", index);
-    return "";
+    if (sensibilityParam.isMember("UserDefined")) {
+        ParseThresholds(sensibilityParam["UserDefined"], table.userThresholds);
+    }
+    return true;
 }
 
-std::string IntellVoiceSensibility::ParseUserDspSensibility(const Json::Value &wakeupJson, uint32_t index)
+void IntellVoiceSensibility::ParseThresholds(const Json::Value &array, std::vector<std::string> &thresholds)
 {
-    if ((!wakeupJson.isMember("SensibilityParams")) ||
-        (!wakeupJson["SensibilityParams"].isMember("DspSentenceThresholds"))) {
-        INTELL_VOICE_LOG_WARN("no sensiblity param");
-        return "";
+    if (!array.isArray()) {
+        return;
     }
 
-    Json::Value sensibilityParam = wakeupJson["SensibilityParams"]["DspSentenceThresholds"];
-    if ((sensibilityParam.isMember("UserDefined")) && (sensibilityParam["UserDefined"].isArray()) &&
-        (sensibilityParam["UserDefined"].size() > index) && sensibilityParam["UserDefined"][index].isInt()) {
-        return std::to_string(sensibilityParam["Default"][index].asInt());
+    thresholds.reserve(array.size());
+    for (Json::ArrayIndex i = 0; i < array.size(); i++) {
+        // keep the slot for invalid items so indexes still line up with the config
+        thresholds.emplace_back(array[i].isInt() ? std::to_string(array[i].asInt()) : "");
     }
+}
 
-    INTELL_VOICE_LOG_WARN("index:%{public}u, default sensibility param is invalid", index);
-    return "";
+std::string IntellVoiceSensibility::GetThreshold(const std::vector<std::string> &thresholds, uint32_t index)
+{
+    if ((index >= thresholds.size()) || thresholds[index].empty()) {
+        INTELL_VOICE_LOG_WARN("index:%{public}u, sensibility param is invalid", index);
+        return "";
+    }
+    return thresholds[index];
 }
 
-bool IntellVoiceSensibility::IsDefaltPhrase(const Json::Value &wakeupJson, const std::string &wakeupPhrase)
+bool IntellVoiceSensibility::IsDefaltPhrase(const SensibilityTable &table, const std::string &wakeupPhrase)
 {
     const std::vector<std::string> defaultPhrases = {"你好小E", "你好小易", "你好华为", "小艺小艺", "你好悠悠"};
-    if (wakeupJson.isMember(WAKEUP_CONF_DEFAULPHRASE)) {
-        if (wakeupJson[WAKEUP_CONF_DEFAULPHRASE].isMember(wakeupPhrase)) {
-            return true;
-        }
-    } else {
-        auto it = std::find(defaultPhrases.begin(), defaultPhrases.end(), wakeupPhrase);
-        if (it != defaultPhrases.end()) {
-            return true;
-        }
+    if (table.hasDefaultPhraseNode) {
+        return table.phraseThresholds.count(wakeupPhrase) != 0;
     }
 
-    return false;
+    auto it = std::find(defaultPhrases.begin(), defaultPhrases.end(), wakeupPhrase);
+    return it != defaultPhrases.end();
 }
 
 bool IntellVoiceSensibility::IsSupportNodes800(const std::string &dspFeature)
@@ -15,7 +15,10 @@
 #ifndef INTELL_VOICE_SENSIBILITY
 #define INTELL_VOICE_SENSIBILITY
 
+#include <map>
+#include <mutex>
 #include <string>
+#include <vector>
 #include "json/json.h"
 
 namespace OHOS {
@@ -27,14 +30,28 @@ public:
         const std::string &configPath);
 
 private:
-    static std::string ParseDefaultDspSensibility(const Json::Value &wakeupJson, const std::string &wakeupPhrase,
-        uint32_t index);
-    static std::string ParseUserDspSensibility(const Json::Value &wakeupJson, uint32_t index);
-    static std::string ParseWakeupConfigDspSensibility(const std::string &wakeupPhrase, uint32_t index,
+    // thresholds of the wakeup config, indexed by (sensibility - 1) plus the node 800 offset
+    struct SensibilityTable {
+        std::string configPath;
+        int64_t mtimeNs = -1;
+        bool hasDefaultPhraseNode = false;
+        std::map<std::string, std::vector<std::string>> phraseThresholds;
+        std::vector<std::string> defaultThresholds;
+        std::vector<std::string> userThresholds;
+    };
+
+    static std::string LookupDspSensibility(const std::string &wakeupPhrase, uint32_t index,
         const std::string &configPath);
-    static bool IsDefaltPhrase(const Json::Value &wakeupJson, const std::string &wakeupPhrase);
+    static bool RefreshTableLocked(const std::string &configPath);
+    static bool LoadTable(const std::string &configPath, SensibilityTable &table);
+    static void ParseThresholds(const Json::Value &array, std::vector<std::string> &thresholds);
+    static std::string GetThreshold(const std::vector<std::string> &thresholds, uint32_t index);
+    static bool IsDefaltPhrase(const SensibilityTable &table, const std::string &wakeupPhrase);
     static bool IsSupportNodes800(const std::string &dspFeature);
+
+    static std::mutex tableMutex_;
+    static SensibilityTable table_;
 };
 }
 }
-#endif
\ No newline at end of file
+#endif
@@ -52,9 +52,37 @@ EnrollEngine::EnrollEngine() : TaskExecutor(ENROLL_THREAD_NAME, MAX_ENROLL_TASK_
     capturerOptions_.streamInfo.channels = AudioChannel::MONO;
     capturerOptions_.capturerInfo.sourceType = SourceType::SOURCE_TYPE_VOICE_RECOGNITION;
     capturerOptions_.capturerInfo.capturerFlags = 0;
+    InitParamDispatcher();
     TaskExecutor::StartThread();
 }
 
+void EnrollEngine::InitParamDispatcher()
+{
+    paramDispatcher_.Register(PARAM_KEY_WAKEUP_BUNDLE_NAME, [this](std::string_view value) {
+        std::string str(value);
+        INTELL_VOICE_LOG_INFO("set wakeup bundle name:%{public}s", str.c_str());
+        HistoryInfoMgr::GetInstance().SetStringKVPair(KEY_WAKEUP_ENGINE_BUNDLE_NAME, str);
+        isInnerParam_ = true;
+    }).Register(PARAM_KEY_WAKEUP_ABILITY_NAME, [this](std::string_view value) {
+        std::string str(value);
+        INTELL_VOICE_LOG_INFO("set wakeup ability name:%{public}s", str.c_str());
+        HistoryInfoMgr::GetInstance().SetStringKVPair(KEY_WAKEUP_ENGINE_ABILITY_NAME, str);
+        isInnerParam_ = true;
+    }).Register(PARAM_KEY_LANGUAGE, [](std::string_view value) {
+        std::string str(value);
+        INTELL_VOICE_LOG_DEBUG("set language:%{public}s", str.c_str());
+        HistoryInfoMgr::GetInstance().SetStringKVPair(KEY_LANGUAGE, str);
+    }).Register(PARAM_KEY_AREA, [](std::string_view value) {
+        std::string str(value);
+        INTELL_VOICE_LOG_DEBUG("set area:%{public}s", str.c_str());
+        HistoryInfoMgr::GetInstance().SetStringKVPair(KEY_AREA, str);
+    }).Register(PARAM_KEY_SENSIBILITY, [](std::string_view value) {
+        std::string str(value);
+        INTELL_VOICE_LOG_INFO("set Sensibility:%{public}s", str.c_str());
+        HistoryInfoMgr::GetInstance().SetStringKVPair(KEY_SENSIBILITY, str);
+    });
+}
+
 EnrollEngine::~EnrollEngine()
 {
     INTELL_VOICE_LOG_INFO("enter");
@@ -67,7 +95,7 @@ void EnrollEngine::OnEnrollEvent(
     if (event.msgId == INTELL_VOICE_ENGINE_MSG_ENROLL_COMPLETE) {
         TaskExecutor::AddAsyncTask([this, result = event.result, info = event.info]() {
             OnEnrollComplete(result, info);
-            }, "EnrollEngine::OnEnrollEvent", false);
+            }, "EnrollEngine::OnEnrollEvent", false, TaskPriority::HIGH);
     } else if (event.msgId == INTELL_VOICE_ENGINE_MSG_COMMIT_ENROLL_COMPLETE) {
         enrollResult_.store(static_cast<int32_t>(event.result));
         IntellVoiceEngineManager::SetEnrollResult(INTELL_VOICE_ENROLL,
@@ -150,7 +178,11 @@ int32_t EnrollEngine::Attach(const IntellVoiceEngineInfo &info)
         .bitsPerSample = info.bitsPerSample,
         .sampleRate = info.sampleRate,
     };
-    return adapter_->Attach(adapterInfo);
+    if (adapter_->Attach(adapterInfo) != 0) {
+        return -1;
+    }
+    EngineUtil::NegotiateAudioBatch(adapterInfo);
+    return 0;
 }
 
 int32_t EnrollEngine::Detach(void)
@@ -243,39 +275,10 @@ int32_t EnrollEngine::SetParameter(const std::string &keyValueList)
 
 bool EnrollEngine::SetParameterInner(const std::string &keyValueList)
 {
-    HistoryInfoMgr &historyInfoMgr = HistoryInfoMgr::GetInstance();
-
-    std::map<std::string, std::string> kvpairs;
-    IntellVoiceUtil::SplitStringToKVPair(keyValueList, kvpairs);
-    for (auto it : kvpairs) {
-        if (it.first == std::string("wakeup_bundle_name")) {
-            INTELL_VOICE_LOG_INFO("set wakeup bundle name:%{public}s", it.second.c_str());
-            historyInfoMgr.SetStringKVPair(KEY_WAKEUP_ENGINE_BUNDLE_NAME, it.second);
-            return true;
-        }
-        if (it.first == std::string("wakeup_ability_name")) {
-            INTELL_VOICE_LOG_INFO("set wakeup ability name:%{public}s", it.second.c_str());
-            historyInfoMgr.SetStringKVPair(KEY_WAKEUP_ENGINE_ABILITY_NAME, it.second);
-            return true;
-        }
-        if (it.first == std::string("language")) {
-            INTELL_VOICE_LOG_DEBUG("set language:%{public}s", it.second.c_str());
-            historyInfoMgr.SetStringKVPair(KEY_LANGUAGE, it.second);
-            continue;
-        }
-        if (it.first == std::string("area")) {
-            INTELL_VOICE_LOG_DEBUG("set area:%{public}s", it.second.c_str());
-            historyInfoMgr.SetStringKVPair(KEY_AREA, it.second);
-            continue;
-        }
-        if (it.first == std::string("Sensibility")) {
-            INTELL_VOICE_LOG_INFO("set Sensibility:%{public}s", it.second.c_str());
-            historyInfoMgr.SetStringKVPair(KEY_SENSIBILITY, it.second);
-            continue;
-        }
-    }
-
-    return false;
+    // bundle and ability name are kept by the framework and not passed to the engine
+    isInnerParam_ = false;
+    paramDispatcher_.Dispatch(keyValueList);
+    return isInnerParam_;
 }
 
 std::string EnrollEngine::GetParameter(const std::string &key)
@@ -314,11 +317,11 @@ bool EnrollEngine::StartAudioSource()
 
     auto listener = std::make_unique<AudioSourceListener>([&] (uint8_t *buffer, uint32_t size, bool isEnd) {
         if ((adapter_ != nullptr) && (!isEnd)) {
-            std::vector<uint8_t> audioBuff(&buffer[0], &buffer[size]);
-            adapter_->WriteAudio(audioBuff);
+            EngineUtil::WriteAudio(buffer, size);
         }}, [&] () {
             INTELL_VOICE_LOG_INFO("end of pcm");
             if (adapter_ != nullptr) {
+                EngineUtil::FlushAudio();
                 adapter_->SetParameter("end_of_pcm=true");
             }
         });
@@ -24,6 +24,7 @@
 #include "engine_util.h"
 #include "enroll_adapter_listener.h"
 #include "task_executor.h"
+#include "param_dispatcher.h"
 
 namespace OHOS {
 namespace IntellVoiceEngine {
@@ -44,6 +45,7 @@ public:
 private:
     EnrollEngine();
     bool SetParameterInner(const std::string &keyValueList);
+    void InitParamDispatcher();
     bool StartAudioSource();
     void StopAudioSource();
     void OnEnrollEvent(const OHOS::HDI::IntelligentVoice::Engine::V1_0::IntellVoiceEngineCallBackEvent &event);
@@ -59,6 +61,8 @@ private:
     sptr<OHOS::HDI::IntelligentVoice::Engine::V1_0::IIntellVoiceEngineCallback> callback_ = nullptr;
     std::unique_ptr<AudioSource> audioSource_ = nullptr;
     std::string wakeupPhrase_;
+    bool isInnerParam_ = false;
+    OHOS::IntellVoiceUtils::ParamDispatcher paramDispatcher_;
     std::mutex mutex_;
     OHOS::AudioStandard::AudioCapturerOptions capturerOptions_;
     friend class IntellVoiceUtils::SptrFactory<EngineBase, EnrollEngine>;
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "engine_registry.h"
+
+#include "intell_voice_log.h"
+
+#define LOG_TAG "EngineRegistry"
+
+namespace OHOS {
+namespace IntellVoiceEngine {
+sptr<EngineBase> EngineRegistry::Get(IntellVoiceEngineType type) const
+{
+    int32_t slot = EngineTypeToSlot(type);
+    if (slot == INVALID_ENGINE_SLOT) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(slots_[slot].mutex);
+    return slots_[slot].engine;
+}
+
+sptr<EngineBase> EngineRegistry::GetOrCreate(IntellVoiceEngineType type,
+    const std::function<sptr<EngineBase>()> &creator)
+{
+    int32_t slot = EngineTypeToSlot(type);
+    if ((slot == INVALID_ENGINE_SLOT) || (creator == nullptr)) {
+        INTELL_VOICE_LOG_ERROR("invalid engine type:%{public}d", type);
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(slots_[slot].mutex);
+    if (slots_[slot].engine == nullptr) {
+        slots_[slot].engine = creator();
+    }
+    return slots_[slot].engine;
+}
+
+bool EngineRegistry::Detach(IntellVoiceEngineType type)
+{
+    int32_t slot = EngineTypeToSlot(type);
+    if (slot == INVALID_ENGINE_SLOT) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(slots_[slot].mutex);
+    if (slots_[slot].engine == nullptr) {
+        return false;
+    }
+
+    slots_[slot].engine->Detach();
+    slots_[slot].engine = nullptr;
+    return true;
+}
+}
+}
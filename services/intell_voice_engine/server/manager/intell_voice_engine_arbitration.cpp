@@ -22,21 +22,38 @@ using namespace std;
 
 namespace OHOS {
 namespace IntellVoiceEngine {
+using EngineRelationMatrix = std::array<std::array<EngineRelationType, ENGINE_SLOT_NUM>, ENGINE_SLOT_NUM>;
+
+// row: the engine being created, column: an existing engine; unlisted pairs are concurrent
+static constexpr EngineRelationMatrix BuildEngineRelationMatrix()
+{
+    EngineRelationMatrix matrix {};
+    matrix[EngineTypeToSlot(INTELL_VOICE_ENROLL)][EngineTypeToSlot(INTELL_VOICE_WAKEUP)] = PREEMPTION_TYPE;
+    matrix[EngineTypeToSlot(INTELL_VOICE_ENROLL)][EngineTypeToSlot(INTELL_VOICE_UPDATE)] = REPLACEMENT_TYPE;
+    matrix[EngineTypeToSlot(INTELL_VOICE_WAKEUP)][EngineTypeToSlot(INTELL_VOICE_ENROLL)] = CONCURRENCY_TYPE;
+    matrix[EngineTypeToSlot(INTELL_VOICE_UPDATE)][EngineTypeToSlot(INTELL_VOICE_ENROLL)] = REJECTION_TYPE;
+    return matrix;
+}
+
+static constexpr EngineRelationMatrix ENGINE_RELATION_MATRIX = BuildEngineRelationMatrix();
+static_assert(CONCURRENCY_TYPE == EngineRelationType {}, "unlisted engine pairs must be concurrent");
+static_assert(ENGINE_RELATION_MATRIX[EngineTypeToSlot(INTELL_VOICE_UPDATE)][EngineTypeToSlot(INTELL_VOICE_ENROLL)] ==
+    REJECTION_TYPE, "update must be rejected while enrolling");
+
 IntellVoiceEngineArbitration::IntellVoiceEngineArbitration()
 {
-    engineRelationTbl_[INTELL_VOICE_ENROLL][INTELL_VOICE_WAKEUP] = PREEMPTION_TYPE;
-    engineRelationTbl_[INTELL_VOICE_ENROLL][INTELL_VOICE_UPDATE] = REPLACEMENT_TYPE;
-    engineRelationTbl_[INTELL_VOICE_WAKEUP][INTELL_VOICE_ENROLL] = CONCURRENCY_TYPE;
-    engineRelationTbl_[INTELL_VOICE_UPDATE][INTELL_VOICE_ENROLL] = REJECTION_TYPE;
 }
 
 IntellVoiceEngineArbitration::~IntellVoiceEngineArbitration()
 {
 }
 
-ArbitrationResult IntellVoiceEngineArbitration::ApplyArbitration(IntellVoiceEngineType type,
-    std::map<IntellVoiceEngineType, sptr<EngineBase>> &engines)
+ArbitrationResult IntellVoiceEngineArbitration::ApplyArbitration(IntellVoiceEngineType type, EngineRegistry &engines)
 {
+    if (EngineTypeToSlot(type) == INVALID_ENGINE_SLOT) {
+        return ARBITRATION_OK;
+    }
+
     if (JudgeRejection(type, engines)) {
         INTELL_VOICE_LOG_INFO("reject engine, type: %{public}d", type);
         return ARBITRATION_REJECT;
@@ -48,81 +65,54 @@ ArbitrationResult IntellVoiceEngineArbitration::ApplyArbitration(IntellVoiceEngi
     return ARBITRATION_OK;
 }
 
-sptr<EngineBase> IntellVoiceEngineArbitration::GetEngine(IntellVoiceEngineType type,
-    const std::map<IntellVoiceEngineType, sptr<EngineBase>> &engines)
+sptr<EngineBase> IntellVoiceEngineArbitration::GetEngine(IntellVoiceEngineType type, const EngineRegistry &engines)
 {
-    auto it = engines.find(type);
-    if (it != engines.end() && it->second != nullptr) {
-        return it->second;
-    }
-
-    return nullptr;
+    return engines.Get(type);
 }
 
-bool IntellVoiceEngineArbitration::JudgeRejection(IntellVoiceEngineType type,
-    const std::map<IntellVoiceEngineType, sptr<EngineBase>> &engines)
+bool IntellVoiceEngineArbitration::JudgeRejection(IntellVoiceEngineType type, const EngineRegistry &engines)
 {
-    auto relation = engineRelationTbl_.find(type);
-    if (relation == engineRelationTbl_.end()) {
-        return false;
-    }
-
-    for (auto it : relation->second) {
-        if (it.second != REJECTION_TYPE) {
+    const auto &relation = ENGINE_RELATION_MATRIX[EngineTypeToSlot(type)];
+    for (int32_t slot = 0; slot < ENGINE_SLOT_NUM; ++slot) {
+        if (relation[slot] != REJECTION_TYPE) {
             continue;
         }
-        if (GetEngine(it.first, engines) != nullptr) {
+        if (GetEngine(SlotToEngineType(slot), engines) != nullptr) {
             return true;
         }
     }
     return false;
 }
 
-void IntellVoiceEngineArbitration::HandlePreemption(IntellVoiceEngineType type,
-    const std::map<IntellVoiceEngineType, sptr<EngineBase>> &engines)
+void IntellVoiceEngineArbitration::HandlePreemption(IntellVoiceEngineType type, const EngineRegistry &engines)
 {
-    auto relation = engineRelationTbl_.find(type);
-    if (relation == engineRelationTbl_.end()) {
-        return;
-    }
-
-    for (auto it : relation->second) {
-        if (it.second != PREEMPTION_TYPE) {
+    const auto &relation = ENGINE_RELATION_MATRIX[EngineTypeToSlot(type)];
+    for (int32_t slot = 0; slot < ENGINE_SLOT_NUM; ++slot) {
+        if (relation[slot] != PREEMPTION_TYPE) {
             continue;
         }
-        auto engine = GetEngine(it.first, engines);
+        auto engine = GetEngine(SlotToEngineType(slot), engines);
         if (engine == nullptr) {
             continue;
         }
 
         engine->Stop();
-        INTELL_VOICE_LOG_INFO("preemption, type: %{public}d, %{public}d", type, it.first);
+        INTELL_VOICE_LOG_INFO("preemption, type: %{public}d, %{public}d", type, SlotToEngineType(slot));
     }
 }
 
-void IntellVoiceEngineArbitration::HandleReplace(IntellVoiceEngineType type,
-    std::map<IntellVoiceEngineType, sptr<EngineBase>> &engines)
+void IntellVoiceEngineArbitration::HandleReplace(IntellVoiceEngineType type, EngineRegistry &engines)
 {
-    auto relation = engineRelationTbl_.find(type);
-    if (relation == engineRelationTbl_.end()) {
-        return;
-    }
-
-    for (auto it : relation->second) {
-        if (it.second != REPLACEMENT_TYPE) {
+    const auto &relation = ENGINE_RELATION_MATRIX[EngineTypeToSlot(type)];
+    for (int32_t slot = 0; slot < ENGINE_SLOT_NUM; ++slot) {
+        if (relation[slot] != REPLACEMENT_TYPE) {
             continue;
         }
 
-        auto engineIter = engines.find(it.first);
-        if ((engineIter == engines.end()) || (engineIter->second == nullptr)) {
-            continue;
+        if (engines.Detach(SlotToEngineType(slot))) {
+            INTELL_VOICE_LOG_INFO("replace, type: %{public}d, %{public}d", type, SlotToEngineType(slot));
         }
-
-        engineIter->second->Detach();
-        engineIter->second = nullptr;
-        engines.erase(it.first);
-        INTELL_VOICE_LOG_INFO("replace, type: %{public}d, %{public}d", type, it.first);
     }
 }
 }
-}
\ No newline at end of file
+}
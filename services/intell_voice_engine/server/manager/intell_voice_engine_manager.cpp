@@ -39,6 +39,7 @@
 #include "engine_callback_message.h"
 #include "data_operation_callback.h"
 #include "history_info_mgr.h"
+#include "audio_source.h"
 #include "intell_voice_definitions.h"
 
 #define LOG_TAG "IntellVoiceEngineManager"
@@ -90,36 +91,26 @@ sptr<IIntellVoiceEngine> IntellVoiceEngineManager::CreateEngineInner(IntellVoice
 {
     INTELL_VOICE_LOG_INFO("create engine enter, type: %{public}d", type);
     OHOS::IntellVoiceUtils::MemoryGuard memoryGuard;
-    sptr<EngineBase> engine = GetEngine(type, engines_);
-    if (engine != nullptr) {
-        return engine;
-    }
-
-    engine = EngineFactory::CreateEngineInst(type, param, reEnroll);
+    sptr<EngineBase> engine = engines_.GetOrCreate(type, [type, &param, reEnroll]() -> sptr<EngineBase> {
+        sptr<EngineBase> newEngine = EngineFactory::CreateEngineInst(type, param, reEnroll);
+        if (newEngine != nullptr) {
+            INTELL_VOICE_LOG_INFO("create engine ok");
+        }
+        return newEngine;
+    });
     if (engine == nullptr) {
         INTELL_VOICE_LOG_ERROR("create engine failed, type:%{public}d", type);
         return nullptr;
     }
-    engines_[type] = engine;
-    INTELL_VOICE_LOG_INFO("create engine ok");
     return engine;
 }
 
 int32_t IntellVoiceEngineManager::ReleaseEngineInner(IntellVoiceEngineType type)
 {
     OHOS::IntellVoiceUtils::MemoryGuard memoryGuard;
-    auto it = engines_.find(type);
-    if (it == engines_.end()) {
+    if (!engines_.Detach(type)) {
         INTELL_VOICE_LOG_WARN("there is no engine(%{public}d) in list", type);
-        return 0;
     }
-
-    if (it->second != nullptr) {
-        it->second->Detach();
-        it->second = nullptr;
-    }
-
-    engines_.erase(type);
     return 0;
 }
 
@@ -276,15 +267,13 @@ int32_t IntellVoiceEngineManager::GetUploadFiles(int numMax, std::vector<UploadF
         return ret;
     }
 
-    for (auto item : hdiFiles) {
+    files.reserve(files.size() + hdiFiles.size());
+    for (auto &item : hdiFiles) {
         UploadFilesFromHdi file;
         file.type = item.type;
-        file.filesDescription = item.filesDescription;
-        for (auto mem : item.filesContent) {
-            file.filesContent.emplace_back(mem);
-        }
-        file.type = item.type;
-        files.emplace_back(file);
+        file.filesDescription = std::move(item.filesDescription);
+        file.filesContent = std::move(item.filesContent);
+        files.emplace_back(std::move(file));
     }
     return ret;
 }
@@ -485,6 +474,8 @@ void IntellVoiceEngineManager::OnServiceStart()
 
 void IntellVoiceEngineManager::OnServiceStop()
 {
+    // release a capturer kept in standby while the audio framework is still usable
+    AudioSource::FlushStandby();
     UnloadIntellVoiceHost();
 }
 
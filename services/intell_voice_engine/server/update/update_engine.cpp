@@ -24,6 +24,7 @@
 #include "engine_callback_message.h"
 #include "history_info_mgr.h"
 #include <thread>
+#include "worker_pool.h"
 #include "update_engine_utils.h"
 #include "engine_host_manager.h"
 #include "intell_voice_definitions.h"
@@ -79,14 +80,19 @@ void UpdateEngine::OnUpdateEvent(int32_t msgId, int32_t result)
 {
     if (msgId == INTELL_VOICE_ENGINE_MSG_COMMIT_ENROLL_COMPLETE) {
         wptr<UpdateEngine> thisWptr(this);
-        std::thread([thisWptr, result]() {
+        auto task = [thisWptr, result]() {
             sptr<UpdateEngine> thisSptr = thisWptr.promote();
             if (thisSptr != nullptr) {
                 thisSptr->OnCommitEnrollComplete(result);
             } else {
                 INTELL_VOICE_LOG_WARN("updateEngine is null");
             }
-        }).detach();
+        };
+        // the update state machine waits for this completion, it must run even if the pool is full
+        if (!WorkerPool::GetInstance().Submit("UpdateEngine::CommitEnrollComplete", task)) {
+            INTELL_VOICE_LOG_WARN("failed to submit commit enroll complete, run it on a detached thread");
+            std::thread(task).detach();
+        }
     }
 }
 
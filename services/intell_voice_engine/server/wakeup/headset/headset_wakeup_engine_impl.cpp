@@ -13,6 +13,7 @@
  * limitations under the License.
  */
 #include "headset_wakeup_engine_impl.h"
+#include <chrono>
 #include "audio_system_manager.h"
 #include "adapter_callback_service.h"
 #include "intell_voice_log.h"
@@ -35,7 +36,20 @@ static constexpr int64_t RECOGNIZING_TIMEOUT_US = 10 * 1000 * 1000; //10s
 static constexpr int64_t RECOGNIZE_COMPLETE_TIMEOUT_US = 2 * 1000 * 1000; //2s
 static constexpr int64_t READ_CAPTURER_TIMEOUT_US = 10 * 1000 * 1000; //10s
 static constexpr uint32_t MAX_HEADSET_TASK_NUM = 200;
+static constexpr uint32_t HEADSET_RING_SLOT_NUM = 500;
+static constexpr size_t HEADSET_RING_SLOT_SIZE = 640;  // 20ms, 16kHz, 16bit, mono
+static constexpr int64_t HEADSET_BYTES_PER_MS = 32;  // 16kHz, 16bit, mono
+static constexpr uint32_t HEADSET_READ_WAIT_MS = 1000;
+static constexpr int32_t HEADSET_READ_CHANNEL = 0x1;  // headset stream is mono, only channel 0 exists
 static const std::string HEADSET_THREAD_NAME = "HeadsetThread";
+static const std::string WRITE_SOURCE = "_write_source0";
+static const std::string READ_SOURCE = "_read_source0";
+
+static int64_t NowUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
 
 HeadsetWakeupEngineImpl::HeadsetWakeupEngineImpl()
     : ModuleStates(State(IDLE), "HeadsetWakeupEngineImpl"), TaskExecutor(HEADSET_THREAD_NAME, MAX_HEADSET_TASK_NUM)
@@ -159,13 +173,13 @@ void HeadsetWakeupEngineImpl::OnWakeupEvent(
     INTELL_VOICE_LOG_INFO("enter, msgId:%{public}d, result:%{public}d", event.msgId, event.result);
     if (event.msgId == INTELL_VOICE_ENGINE_MSG_INIT_DONE) {
         TaskExecutor::AddAsyncTask([this, result = event.result]() { OnInitDone(result); },
-            "HeadsetWakeupEngineImpl::InitDone", false);
+            "HeadsetWakeupEngineImpl::InitDone", false, TaskPriority::HIGH);
     } else if (
         event.msgId == static_cast<OHOS::HDI::IntelligentVoice::Engine::V1_0::IntellVoiceEngineMessageType>(
             OHOS::HDI::IntelligentVoice::Engine::V1_2::INTELL_VOICE_ENGINE_MSG_HEADSET_RECOGNIZE_COMPLETE)) {
         TaskExecutor::AddAsyncTask([this, result = event.result, info = event.info]() {
             OnWakeupRecognition(result, info);
-            }, "HeadsetWakeupEngineImpl::RecgonizeComplete", false);
+            }, "HeadsetWakeupEngineImpl::RecgonizeComplete", false, TaskPriority::HIGH);
     } else {
     }
 }
@@ -273,7 +287,13 @@ void HeadsetWakeupEngineImpl::ReadThread()
 {
     bool isEnd = false;
     while (isReading_.load()) {
-        std::vector<uint8_t> audioStream;
+        // read straight into the next ring slot, the slot keeps its capacity from lap to lap
+        std::vector<uint8_t> *slot = audioRing_.AcquireWriteSlot();
+        if (slot == nullptr) {
+            INTELL_VOICE_LOG_ERROR("audio ring is not available");
+            break;
+        }
+        std::vector<uint8_t> &audioStream = *slot;
         bool hasAwakeWord = true;
         int ret = HeadsetWakeupWrapper::GetInstance().ReadHeadsetStream(audioStream, hasAwakeWord);
         if (ret != 1) {
@@ -291,8 +311,15 @@ void HeadsetWakeupEngineImpl::ReadThread()
             isEnd = true;
             adapter_->SetParameter("end_of_pcm=true");
         }
-        WakeupSourceProcess::Write({ audioStream });
+        if (!audioStream.empty()) {
+            writeDebug_.WriteData(reinterpret_cast<const char *>(audioStream.data()), audioStream.size());
+            // pace at the block size the headset really delivers, the slot size is only a reserve hint
+            jitterBuffer_.SetFrameInterval(static_cast<int64_t>(audioStream.size()) * 1000 / HEADSET_BYTES_PER_MS);
+            audioRing_.Commit();
+            jitterBuffer_.OnArrival(NowUs(), audioRing_.GetCount());
+        }
     }
+    jitterBuffer_.SetEndOfStream();
 }
 
 bool HeadsetWakeupEngineImpl::StartAudioSource()
@@ -300,7 +327,14 @@ bool HeadsetWakeupEngineImpl::StartAudioSource()
     INTELL_VOICE_LOG_INFO("enter");
     isReading_.store(true);
 
-    WakeupSourceProcess::Init(1);
+    if (!audioRing_.Init(HEADSET_RING_SLOT_NUM, HEADSET_RING_SLOT_SIZE)) {
+        INTELL_VOICE_LOG_ERROR("failed to init audio ring");
+        isReading_.store(false);
+        return false;
+    }
+    jitterBuffer_.Reset();
+    writeDebug_.CreateAudioDebugFile(WRITE_SOURCE);
+    readDebug_.CreateAudioDebugFile(READ_SOURCE);
 
     std::thread t1(std::bind(&HeadsetWakeupEngineImpl::ReadThread, this));
     readThread_ = std::move(t1);
@@ -316,7 +350,14 @@ void HeadsetWakeupEngineImpl::StopAudioSource()
     isReading_.store(false);
     readThread_.join();
     HeadsetWakeupWrapper::GetInstance().StopReadingStream();
-    WakeupSourceProcess::Release();
+    JitterBufferStats stats = jitterBuffer_.GetStats();
+    INTELL_VOICE_LOG_INFO("arrival:%{public}llu, release:%{public}llu, underrun:%{public}llu, late:%{public}llu, "
+        "target depth:%{public}u, jitter:%{public}lld us", static_cast<unsigned long long>(stats.arrivalCnt),
+        static_cast<unsigned long long>(stats.releaseCnt), static_cast<unsigned long long>(stats.underrunCnt),
+        static_cast<unsigned long long>(stats.lateCnt), stats.targetDepth, static_cast<long long>(stats.jitterUs));
+    audioRing_.Uninit();
+    writeDebug_.DestroyAudioDebugFile();
+    readDebug_.DestroyAudioDebugFile();
 }
 
 int32_t HeadsetWakeupEngineImpl::HandleStop(const StateMsg & /* msg */, State &nextState)
@@ -367,16 +408,46 @@ int32_t HeadsetWakeupEngineImpl::HandleStartCapturer(const StateMsg &msg, State
 int32_t HeadsetWakeupEngineImpl::HandleRead(const StateMsg &msg, State & /* nextState */)
 {
     CapturerData *capturerData = reinterpret_cast<CapturerData *>(msg.outMsg);
-    auto ret = WakeupSourceProcess::Read(capturerData->data, channels_);
-    if (ret != 0) {
+    if ((capturerData == nullptr) || (channels_ != HEADSET_READ_CHANNEL)) {
+        INTELL_VOICE_LOG_ERROR("invalid read, channels:%{public}d", channels_);
+        return -1;
+    }
+
+    std::vector<uint8_t> &data = capturerData->data;
+    bool isRead = WaitReleaseTime() && audioRing_.Borrow(0, [this, &data](const uint8_t *buffer, size_t size) {
+        data.insert(data.end(), buffer, buffer + size);
+        readDebug_.WriteData(reinterpret_cast<const char *>(buffer), size);
+    });
+    if (isRead) {
+        jitterBuffer_.OnRelease(NowUs(), audioRing_.GetCount());
+    } else {
         INTELL_VOICE_LOG_ERROR("read capturer data failed");
-        return ret;
+        return -1;
     }
 
     ResetTimerDelay();
     return 0;
 }
 
+// hold the read until the jitter buffer releases the next frame, bursts come out at the frame cadence
+bool HeadsetWakeupEngineImpl::WaitReleaseTime()
+{
+    int64_t deadlineUs = NowUs() + static_cast<int64_t>(HEADSET_READ_WAIT_MS) * US_PER_MS;
+    while (true) {
+        int64_t nowUs = NowUs();
+        int64_t waitUs = jitterBuffer_.Poll(nowUs, audioRing_.GetCount());
+        if (waitUs == 0) {
+            return true;
+        }
+        if (nowUs >= deadlineUs) {
+            INTELL_VOICE_LOG_WARN("wait audio time out");
+            return false;
+        }
+        // an arrival may start playout earlier, so wake on commit as well
+        audioRing_.WaitCommit(std::min(waitUs, deadlineUs - nowUs));
+    }
+}
+
 int32_t HeadsetWakeupEngineImpl::HandleStopCapturer(const StateMsg & /* msg */, State &nextState)
 {
     INTELL_VOICE_LOG_INFO("enter");
@@ -25,7 +25,9 @@
 #include "state_manager.h"
 #include "engine_util.h"
 #include "wakeup_adapter_listener.h"
-#include "wakeup_source_process.h"
+#include "audio_debug.h"
+#include "slot_ring.h"
+#include "jitter_buffer.h"
 #include "task_executor.h"
 
 namespace OHOS {
@@ -34,7 +36,7 @@ using OHOS::IntellVoiceUtils::StateMsg;
 using OHOS::IntellVoiceUtils::State;
 
 class HeadsetWakeupEngineImpl : private OHOS::IntellVoiceUtils::ModuleStates, private EngineUtil,
-    private WakeupSourceProcess, private OHOS::IntellVoiceUtils::TaskExecutor {
+    private OHOS::IntellVoiceUtils::TaskExecutor {
 public:
     HeadsetWakeupEngineImpl();
     ~HeadsetWakeupEngineImpl();
@@ -60,6 +62,7 @@ private:
     bool StartAudioSource();
     void StopAudioSource();
     void ReadThread();
+    bool WaitReleaseTime();
 
 private:
     bool InitStates();
@@ -82,6 +85,10 @@ private:
     int32_t channels_ = 0;
     std::atomic<bool> isReading_ = false;
     std::thread readThread_;
+    OHOS::IntellVoiceUtils::SlotRing audioRing_;
+    OHOS::IntellVoiceUtils::JitterBuffer jitterBuffer_;
+    AudioDebug writeDebug_;
+    AudioDebug readDebug_;
     sptr<OHOS::HDI::IntelligentVoice::Engine::V1_0::IIntellVoiceEngineCallback> callback_ = nullptr;
     std::shared_ptr<WakeupAdapterListener> adapterListener_ = nullptr;
     friend class OHOS::IntellVoiceUtils::UniquePtrFactory<HeadsetWakeupEngineImpl>;
@@ -18,6 +18,7 @@
 #include "intell_voice_log.h"
 #include "engine_callback_message.h"
 #include "intell_voice_util.h"
+#include "intell_voice_param.h"
 
 #define LOG_TAG "OnlyFirstWakeupEngine"
 
@@ -25,7 +26,6 @@ using namespace OHOS::IntellVoiceUtils;
 
 namespace OHOS {
 namespace IntellVoiceEngine {
-static const std::string SINGLE_WAKEUP_RECORD_START = "record_start";
 
 OnlyFirstWakeupEngine::OnlyFirstWakeupEngine()
 {
@@ -95,17 +95,14 @@ int32_t OnlyFirstWakeupEngine::Detach(void)
 
 int32_t OnlyFirstWakeupEngine::SetParameter(const std::string &keyValueList)
 {
-    std::map<std::string, std::string> kvpairs;
-
-    IntellVoiceUtil::SplitStringToKVPair(keyValueList, kvpairs);
-    for (auto it : kvpairs) {
-        if (it.first == SINGLE_WAKEUP_RECORD_START) {
-            ResetSingleLevelWakeup(it.second);
+    IntellVoiceParam::ForEachKVPair(keyValueList, [this](std::string_view key, std::string_view value) {
+        if (IntellVoiceParam::InternKey(key) == PARAM_KEY_RECORD_START) {
+            ResetSingleLevelWakeup(std::string(value));
         } else {
             INTELL_VOICE_LOG_INFO("no need to process, key:%{public}s, value:%{public}s",
-                it.first.c_str(), it.second.c_str());
+                std::string(key).c_str(), std::string(value).c_str());
         }
-    }
+    });
 
     return 0;
 }
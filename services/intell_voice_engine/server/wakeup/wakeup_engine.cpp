@@ -22,6 +22,7 @@
 #include "intell_voice_util.h"
 #include "ability_manager_client.h"
 #include "history_info_mgr.h"
+#include "worker_pool.h"
 
 #define LOG_TAG "WakeupEngine"
 
@@ -53,7 +54,11 @@ void WakeupEngine::OnDetected(int32_t uuid)
     }
     detectDeviceType_.store(DETECT_TYPE_PHONE);
 
-    std::thread([uuid]() { IntellVoiceUtil::StartAbility(GetEventValue(uuid)); }).detach();
+    auto task = [uuid]() { IntellVoiceUtil::StartAbility(GetEventValue(uuid)); };
+    if (!WorkerPool::GetInstance().Submit("WakeupEngine::StartAbility", task)) {
+        INTELL_VOICE_LOG_WARN("failed to submit start ability, run it on a detached thread");
+        std::thread(task).detach();
+    }
     StateMsg msg(START_RECOGNIZE, &uuid, sizeof(int32_t));
     if (ROLE(WakeupEngineImpl).Handle(msg) != 0) {
         INTELL_VOICE_LOG_WARN("start failed");
@@ -100,6 +105,12 @@ int32_t WakeupEngine::StartCapturer(int32_t channels)
 }
 
 int32_t WakeupEngine::Read(std::vector<uint8_t> &data)
+{
+    AudioFrameInfo info;
+    return ReadFrame(data, info);
+}
+
+int32_t WakeupEngine::ReadFrame(std::vector<uint8_t> &data, AudioFrameInfo &info)
 {
     CapturerData capturerData;
     StateMsg msg(READ, nullptr, 0, reinterpret_cast<void *>(&capturerData));
@@ -110,6 +121,7 @@ int32_t WakeupEngine::Read(std::vector<uint8_t> &data)
     }
 
     data.swap(capturerData.data);
+    info = capturerData.info;
     return 0;
 }
 
@@ -144,7 +156,11 @@ int32_t WakeupEngine::NotifyHeadsetWakeEvent()
         return -1;
     }
 
-    std::thread([]() { StartAbility("headset_event"); }).detach();
+    auto task = []() { StartAbility("headset_event"); };
+    if (!WorkerPool::GetInstance().Submit("WakeupEngine::StartHeadsetAbility", task)) {
+        INTELL_VOICE_LOG_WARN("failed to submit start headset ability, run it on a detached thread");
+        std::thread(task).detach();
+    }
     detectDeviceType_.store(DETECT_TYPE_HEADSET);
 
     StateMsg msg(START_RECOGNIZE);
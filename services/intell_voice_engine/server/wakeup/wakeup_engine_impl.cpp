@@ -25,6 +25,9 @@
 #include "history_info_mgr.h"
 #include "intell_voice_util.h"
 #include "string_util.h"
+#include "time_util.h"
+#include "intell_voice_param.h"
+#include "hot_log.h"
 #include "intell_voice_engine_manager.h"
 #include "engine_callback_message.h"
 #include "engine_host_manager.h"
@@ -46,11 +49,14 @@ static constexpr int32_t BITS_PER_SAMPLE = 16;
 static constexpr int32_t SAMPLE_RATE = 16000;
 static const std::string WAKEUP_SOURCE_CHANNEL = "wakeup_source_channel";
 static const std::string IS_CALLBACK_EXIST = "is_callback_exist";
+static const std::string WAKEUP_PRE_ROLL_MS = "wakeup_pre_roll_ms";
+static const std::string WAKEUP_CAPTURER_STANDBY_MS = "wakeup_capturer_standby_ms";
 static constexpr std::string_view DEFAULT_WAKEUP_PHRASE = "\xE5\xB0\x8F\xE8\x89\xBA\xE5\xB0\x8F\xE8\x89\xBA";
 static constexpr int64_t RECOGNIZING_TIMEOUT_US = 10 * 1000 * 1000; //10s
 static constexpr int64_t RECOGNIZE_COMPLETE_TIMEOUT_US = 2 * 1000 * 1000; //2s
 static constexpr int64_t READ_CAPTURER_TIMEOUT_US = 10 * 1000 * 1000; //10s
 static constexpr uint32_t MAX_WAKEUP_TASK_NUM = 200;
+static constexpr uint32_t LOG_LIMIT_INTERVAL_MS = 1000;
 static const std::string WAKEUP_THREAD_NAME = "WakeupEngThread";
 static const std::string WAKEUP_CONFORMER_EVENT_TYPE = "AUDIO_WAKEUP_1_5";
 static const std::string WAKEUP_CONFORMER_DOMAIN_ID = "7";
@@ -210,7 +216,11 @@ int32_t WakeupEngineImpl::AttachInner(const IntellVoiceEngineInfo &info)
         .bitsPerSample = info.bitsPerSample,
         .sampleRate = info.sampleRate,
     };
-    return adapter_->Attach(adapterInfo);
+    if (adapter_->Attach(adapterInfo) != 0) {
+        return -1;
+    }
+    EngineUtil::NegotiateAudioBatch(adapterInfo);
+    return 0;
 }
 
 void WakeupEngineImpl::SetParamOnAudioStart(int32_t uuid)
@@ -316,6 +326,7 @@ bool WakeupEngineImpl::StartAudioSource()
         [&]() {
             INTELL_VOICE_LOG_INFO("end of pcm");
             if (adapter_ != nullptr) {
+                EngineUtil::FlushAudio();
                 adapter_->SetParameter("end_of_pcm=true");
             }
         });
@@ -334,6 +345,7 @@ bool WakeupEngineImpl::StartAudioSource()
         return false;
     }
 
+    audioSource_->SetStandbyMs(capturerStandbyMs_);
     if (!audioSource_->Start()) {
         INTELL_VOICE_LOG_ERROR("start capturer failed");
         audioSource_ = nullptr;
@@ -355,6 +367,7 @@ void WakeupEngineImpl::StopAudioSource()
     audioSource_->Stop();
     audioSource_ = nullptr;
     WakeupSourceProcess::Release();
+    std::vector<uint8_t>().swap(wakeupPcm_);
 }
 
 void WakeupEngineImpl::OnWakeupEvent(
@@ -362,11 +375,11 @@ void WakeupEngineImpl::OnWakeupEvent(
 {
     if (event.msgId == INTELL_VOICE_ENGINE_MSG_INIT_DONE) {
         TaskExecutor::AddAsyncTask([this, result = event.result]() { OnInitDone(result); },
-            "WakeupEngineImpl::InitDone", false);
+            "WakeupEngineImpl::InitDone", false, TaskPriority::HIGH);
     } else if (event.msgId == INTELL_VOICE_ENGINE_MSG_RECOGNIZE_COMPLETE) {
         TaskExecutor::AddAsyncTask([this, result = event.result, info = event.info]() {
             OnWakeupRecognition(result, info);
-            }, "WakeupEngineImpl::RecognizeComplete", false);
+            }, "WakeupEngineImpl::RecognizeComplete", false, TaskPriority::HIGH);
     } else {
         INTELL_VOICE_LOG_WARN("invalid msg id:%{public}d", event.msgId);
     }
@@ -399,6 +412,33 @@ int32_t WakeupEngineImpl::HandleSetParam(const StateMsg &msg, State & /* nextSta
         return -1;
     }
 
+    std::string key;
+    std::string value;
+    bool isPair = StringUtil::SplitLineToPair(param->strParam, key, value);
+    if (isPair && (key == WAKEUP_PRE_ROLL_MS)) {
+        int32_t depthMs = 0;
+        if (!StringUtil::StringToInt(value, depthMs) || (depthMs <= 0)) {
+            INTELL_VOICE_LOG_ERROR("invalid pre roll depth:%{public}s", value.c_str());
+            return -1;
+        }
+        WakeupSourceProcess::SetHistoryDepth(static_cast<uint32_t>(depthMs));
+        return 0;
+    }
+
+    if (isPair && (key == WAKEUP_CAPTURER_STANDBY_MS)) {
+        int32_t standbyMs = 0;
+        if (!StringUtil::StringToInt(value, standbyMs) || (standbyMs < 0)) {
+            INTELL_VOICE_LOG_ERROR("invalid capturer standby:%{public}s", value.c_str());
+            return -1;
+        }
+        // 0 opts out: no configured capturer outlives the session
+        capturerStandbyMs_ = static_cast<uint32_t>(standbyMs);
+        if (capturerStandbyMs_ == 0) {
+            AudioSource::FlushStandby();
+        }
+        return 0;
+    }
+
     return EngineUtil::SetParameter(param->strParam);
 }
 
@@ -439,8 +479,12 @@ int32_t WakeupEngineImpl::HandleInit(const StateMsg & /* msg */, State &nextStat
         INTELL_VOICE_LOG_ERROR("failed to set callback");
         return -1;
     }
+    bool isShortWord = false;
+    bool hasShortWord = QueryShortWordSwitch(isShortWord);
     EngineUtil::SetWhisperVpr();
-    SetWakeupModel();
+    if (hasShortWord) {
+        SetWakeupModel(isShortWord);
+    }
     EngineUtil::SetLanguage();
     EngineUtil::SetArea();
     EngineUtil::SetSensibility();
@@ -460,7 +504,9 @@ int32_t WakeupEngineImpl::HandleInit(const StateMsg & /* msg */, State &nextStat
         return -1;
     }
 
-    UpdateDspModel();
+    if (hasShortWord) {
+        UpdateDspModel(isShortWord);
+    }
 
     nextState = State(INITIALIZING);
     return 0;
@@ -570,6 +616,11 @@ int32_t WakeupEngineImpl::HandleRecognizeComplete(const StateMsg &msg, State &ne
         StopAudioSource();
         nextState = State(INITIALIZED);
     } else {
+        // freeze keyword plus pre-roll now, later frames belong to the command
+        wakeupPcm_.clear();
+        if (channelId_ != CHANNEL_ID_1) {
+            WakeupSourceProcess::GetHistory(wakeupPcm_, channelId_);
+        }
         nextState = State(RECOGNIZED);
     }
     EngineUtil::Stop();
@@ -609,7 +660,7 @@ int32_t WakeupEngineImpl::HandleRead(const StateMsg &msg, State & /* nextState *
         return -1;
     }
 
-    auto ret = WakeupSourceProcess::Read(capturerData->data, channels_);
+    auto ret = WakeupSourceProcess::Read(capturerData->data, channels_, capturerData->info);
     if (ret != 0) {
         INTELL_VOICE_LOG_ERROR("read capturer data failed");
         return ret;
@@ -648,6 +699,12 @@ int32_t WakeupEngineImpl::HandleGetWakeupPcm(const StateMsg &msg, State & /* nex
         INTELL_VOICE_LOG_ERROR("capturer data is nullptr");
         return -1;
     }
+    if (!wakeupPcm_.empty()) {
+        INTELL_VOICE_LOG_INFO("serve wakeup pcm from history, size:%{public}zu", wakeupPcm_.size());
+        capturerData->data.swap(wakeupPcm_);
+        wakeupPcm_.clear();
+        return 0;
+    }
     auto ret = EngineUtil::GetWakeupPcm(capturerData->data);
     if (ret != 0) {
         INTELL_VOICE_LOG_ERROR("get wakeup pcm failed");
@@ -663,7 +720,11 @@ int32_t WakeupEngineImpl::HandleResetAdapter(const StateMsg & /* msg */, State &
         INTELL_VOICE_LOG_ERROR("failed to create adapter");
         return -1;
     }
-    SetWakeupModel();
+    bool isShortWord = false;
+    bool hasShortWord = QueryShortWordSwitch(isShortWord);
+    if (hasShortWord) {
+        SetWakeupModel(isShortWord);
+    }
     adapter_->SetCallback(callback_);
     EngineUtil::SetWhisperVpr();
     EngineUtil::SetLanguage();
@@ -684,8 +745,11 @@ int32_t WakeupEngineImpl::HandleResetAdapter(const StateMsg & /* msg */, State &
         EngineUtil::ReleaseAdapterInner(EngineHostManager::GetInstance());
         return -1;
     }
+    EngineUtil::NegotiateAudioBatch(adapterInfo);
 
-    UpdateDspModel();
+    if (hasShortWord) {
+        UpdateDspModel(isShortWord);
+    }
 
     nextState = State(INITIALIZING);
     return 0;
@@ -695,6 +759,8 @@ int32_t WakeupEngineImpl::HandleRelease(const StateMsg & /* msg */, State &nextS
 {
     DestroyWakeupSourceStopCallback();
     StopAudioSource();
+    // no later session of this engine can take the capturer, do not leave it to static destruction
+    AudioSource::FlushStandby();
     if (CurrState() == State(READ_CAPTURER)) {
         IntellVoiceUtil::RecordPermissionPrivacy(OHOS_MICROPHONE_PERMISSION, callerTokenId_,
             INTELL_VOICE_PERMISSION_STOP);
@@ -707,45 +773,35 @@ int32_t WakeupEngineImpl::HandleRelease(const StateMsg & /* msg */, State &nextS
     return 0;
 }
 
-void WakeupEngineImpl::SetWakeupModel()
+bool WakeupEngineImpl::QueryShortWordSwitch(bool &switchStatus)
 {
     auto ret = EngineCallbackMessage::CallFunc(QUERY_SWITCH_STATUS, SHORTWORD_KEY);
-    bool switchstatus = false;
-    if (ret.has_value()) {
-        try {
-            switchstatus = std::any_cast<bool>(*ret);
-        } catch (const std::bad_any_cast&) {
-            INTELL_VOICE_LOG_ERROR("msg bus bad any cast");
-            return;
-        }
-    } else {
+    if (!ret.has_value()) {
         INTELL_VOICE_LOG_ERROR("msg bus return no value");
-        return;
+        return false;
     }
-    if (switchstatus) {
-        adapter_->SetParameter("WakeupMode=1");
-    } else {
-        adapter_->SetParameter("WakeupMode=0");
+
+    try {
+        switchStatus = std::any_cast<bool>(*ret);
+    } catch (const std::bad_any_cast&) {
+        INTELL_VOICE_LOG_ERROR("msg bus bad any cast");
+        return false;
     }
+    return true;
 }
 
-void WakeupEngineImpl::UpdateDspModel()
+void WakeupEngineImpl::SetWakeupModel(bool isShortWord)
 {
-    auto ret = EngineCallbackMessage::CallFunc(QUERY_SWITCH_STATUS, SHORTWORD_KEY);
-    bool switchstatus = false;
-    if (ret.has_value()) {
-        try {
-            switchstatus = std::any_cast<bool>(*ret);
-        } catch (const std::bad_any_cast&) {
-            INTELL_VOICE_LOG_ERROR("msg bus bad any cast");
-            return;
-        }
+    if (isShortWord) {
+        adapter_->SetParameter("WakeupMode=1");
     } else {
-        INTELL_VOICE_LOG_ERROR("msg bus return no value");
-        return;
+        adapter_->SetParameter("WakeupMode=0");
     }
+}
 
-    if (switchstatus) {
+void WakeupEngineImpl::UpdateDspModel(bool isShortWord)
+{
+    if (isShortWord) {
         SubscribeSwingEvent();
         ProcDspModel(ReadDspModel(static_cast<OHOS::HDI::IntelligentVoice::Engine::V1_0::ContentType>(
             OHOS::HDI::IntelligentVoice::Engine::V1_2::SHORT_WORD_DSP_MODEL)));
@@ -798,24 +854,25 @@ std::string WakeupEngineImpl::GetWakeupPhrase()
 
 void WakeupEngineImpl::ReadBufferCallback(uint8_t *buffer, uint32_t size, bool isEnd)
 {
+    // called on the capture thread right after the capturer returned the buffer
+    int64_t captureTimeUs = TimeUtil::GetMonotonicTimeUs();
     std::vector<std::vector<uint8_t>> audioData;
     auto ret = IntellVoiceUtil::DeinterleaveAudioData(reinterpret_cast<int16_t *>(buffer),
         size / sizeof(int16_t), static_cast<int32_t>(capturerOptions_.streamInfo.channels), audioData);
     if ((!ret) || ((audioData.size() != static_cast<uint32_t>(capturerOptions_.streamInfo.channels))) ||
         (channelId_ >= audioData.size())) {
-        INTELL_VOICE_LOG_ERROR("failed to deinterleave, ret:%{public}d, id:%{public}d", ret, channelId_);
+        INTELL_VOICE_LOG_ERROR_LIMIT(LOG_LIMIT_INTERVAL_MS, "failed to deinterleave, ret:%{public}d, id:%{public}d",
+            ret, channelId_);
         return;
     }
     if ((adapter_ != nullptr) && !isEnd) {
         if (channelId_ == CHANNEL_ID_1) { // whisper wakeup, need to write channel0 and channel1 data
-            std::vector<uint8_t> data(audioData[CHANNEL_ID_0].begin(), audioData[CHANNEL_ID_0].end());
-            data.insert(data.end(), audioData[CHANNEL_ID_1].begin(), audioData[CHANNEL_ID_1].end());
-            adapter_->WriteAudio(data);
+            EngineUtil::WriteAudioPlanes(audioData, CHANNEL_ID_1 + 1);
         } else {
-            adapter_->WriteAudio(audioData[channelId_]);
+            EngineUtil::WriteAudio(audioData[channelId_]);
         }
     }
-    WakeupSourceProcess::Write(audioData);
+    WakeupSourceProcess::Write(audioData, captureTimeUs);
 }
 
 #ifdef SUPPORT_WINDOW_MANAGER
@@ -863,22 +920,21 @@ int32_t WakeupEngineImpl::GetFoldStatusInfo(bool &isFoldable, FoldStatus &status
         return -1;
     }
 
-    std::map<std::string, std::string> kvpairs;
-    IntellVoiceUtil::SplitStringToKVPair(keyValueList, kvpairs);
-    for (auto it : kvpairs) {
-        if (it.first == std::string("is_foldable")) {
-            INTELL_VOICE_LOG_INFO("audio_fold_status is_foldable:%{public}s", it.second.c_str());
-            if (it.second == "true") {
-                isFoldable = true;
-            }
+    IntellVoiceParam::ForEachKVPair(keyValueList, [&isFoldable, &status](std::string_view key,
+        std::string_view value) {
+        switch (IntellVoiceParam::InternKey(key)) {
+            case PARAM_KEY_IS_FOLDABLE:
+                isFoldable = IntellVoiceParam::ParseBool(value);
+                break;
+            case PARAM_KEY_FOLD_STATUS:
+                if (value == "fold") {
+                    status = FoldStatus::FOLDED;
+                }
+                break;
+            default:
+                break;
         }
-        if (it.first == std::string("fold_status")) {
-            INTELL_VOICE_LOG_INFO("audio_fold_status fold_status:%{public}s", it.second.c_str());
-            if (it.second == "fold") {
-                status = FoldStatus::FOLDED;
-            }
-        }
-    }
+    });
     INTELL_VOICE_LOG_INFO("audio_fold_status is_foldable:%{public}d, fold_status:%{public}d", isFoldable, status);
     return 0;
 }
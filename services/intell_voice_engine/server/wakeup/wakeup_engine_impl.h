@@ -68,8 +68,9 @@ private:
     void OnWakeupEvent(const OHOS::HDI::IntelligentVoice::Engine::V1_0::IntellVoiceEngineCallBackEvent &event);
     void OnInitDone(int32_t result);
     void OnWakeupRecognition(int32_t result, const std::string &info);
-    void UpdateDspModel();
-    void SetWakeupModel();
+    bool QueryShortWordSwitch(bool &switchStatus);
+    void UpdateDspModel(bool isShortWord);
+    void SetWakeupModel(bool isShortWord);
     OHOS::AudioStandard::AudioChannel GetWakeupSourceChannel();
     void SubscribeSwingEvent();
     void UnSubscribeSwingEvent();
@@ -104,7 +105,9 @@ private:
     bool isPcmFromExternal_ = false;
     int32_t channels_ = 0;
     uint32_t channelId_ = 0;
+    std::vector<uint8_t> wakeupPcm_;
     uint32_t callerTokenId_ = 0;
+    uint32_t capturerStandbyMs_ = 2000;
     std::atomic<bool> isSubscribeSwingEvent_ = false;
     sptr<OHOS::HDI::IntelligentVoice::Engine::V1_0::IIntellVoiceEngineCallback> callback_ = nullptr;
     std::shared_ptr<WakeupAdapterListener> adapterListener_ = nullptr;
@@ -13,7 +13,10 @@
  * limitations under the License.
  */
 #include "wakeup_source_process.h"
+#include <algorithm>
 #include "intell_voice_log.h"
+#include "time_util.h"
+#include "hot_log.h"
 
 #define LOG_TAG "WakeupSourceProc"
 
@@ -25,6 +28,8 @@ static constexpr uint32_t WAIT_TIME = 1000;  // 1000ms
 static constexpr uint32_t CHANNEL_CNT_1 = 1;
 static constexpr uint32_t CHANNEL_CNT_4 = 4;
 static constexpr uint32_t MAX_CHANNEL_CNT = 4;
+static constexpr uint32_t HISTORY_BYTES_PER_MS = 32;  // 16kHz, 16bit, per channel
+static constexpr uint32_t LOG_LIMIT_INTERVAL_MS = 1000;
 static const std::string WRITE_SOURCE = "_write_source";
 static const std::string READ_SOURCE = "_read_source";
 
@@ -39,104 +44,242 @@ void WakeupSourceProcess::Init(uint32_t channelCnt)
         INTELL_VOICE_LOG_WARN("need to release before init, channel cnt:%{public}u", channelCnt_);
         Release();
     }
-    for (uint32_t i = 0; i < channelCnt; i++) {
-        auto queue = std::make_unique<Uint8ArrayBufferQueue>();
-        if (queue == nullptr) {
-            INTELL_VOICE_LOG_ERROR("failed to create buffer queue");
-            return;
-        }
-        queue->Init();
-        bufferQueue_.push_back(std::move(queue));
+    frameQueue_ = std::make_unique<SourceFrameQueue>();
+    if (frameQueue_ == nullptr) {
+        INTELL_VOICE_LOG_ERROR("failed to create frame queue");
+        return;
     }
+    frameQueue_->Init();
     channelCnt_ = channelCnt;
+    ResetStats();
+    InitHistory(channelCnt);
     InitDebugFile(channelCnt);
 }
 
 void WakeupSourceProcess::Write(const std::vector<std::vector<uint8_t>> &audioData)
 {
-    if ((static_cast<uint32_t>(audioData.size()) != channelCnt_) ||
-        (static_cast<uint32_t>(bufferQueue_.size()) != channelCnt_)) {
-        INTELL_VOICE_LOG_ERROR("data size:%{public}u, queue size:%{public}u, channel cnt:%{public}u",
-            static_cast<uint32_t>(audioData.size()), static_cast<uint32_t>(bufferQueue_.size()), channelCnt_);
+    Write(audioData, TimeUtil::GetMonotonicTimeUs());
+}
+
+void WakeupSourceProcess::Write(const std::vector<std::vector<uint8_t>> &audioData, int64_t captureTimeUs)
+{
+    if ((static_cast<uint32_t>(audioData.size()) != channelCnt_) || (frameQueue_ == nullptr)) {
+        INTELL_VOICE_LOG_ERROR("data size:%{public}u, channel cnt:%{public}u",
+            static_cast<uint32_t>(audioData.size()), channelCnt_);
         return;
     }
 
-    if (channelCnt_ == CHANNEL_CNT_1) {
-        WriteChannelData(audioData[CHANNEL_ID_0], CHANNEL_ID_0);
-    } else if (channelCnt_ == CHANNEL_CNT_4) {
-        WriteChannelData(audioData[CHANNEL_ID_0], CHANNEL_ID_0);
-        WriteChannelData(audioData[CHANNEL_ID_1], CHANNEL_ID_1);
-        WriteChannelData(audioData[CHANNEL_ID_2], CHANNEL_ID_2);
-        WriteChannelData(audioData[CHANNEL_ID_3], CHANNEL_ID_3);
-    } else {
+    if ((channelCnt_ != CHANNEL_CNT_1) && (channelCnt_ != CHANNEL_CNT_4)) {
         INTELL_VOICE_LOG_WARN("not support channel cnt:%{public}u", channelCnt_);
+        return;
+    }
+
+    uint64_t sequence = writeSeq_++;
+    if (!WriteFrame(audioData, sequence, captureTimeUs)) {
+        droppedFrames_.fetch_add(1);
     }
 }
 
 int32_t WakeupSourceProcess::Read(std::vector<uint8_t> &data, int32_t readChannel)
+{
+    AudioFrameInfo info;
+    return Read(data, readChannel, info);
+}
+
+int32_t WakeupSourceProcess::Read(std::vector<uint8_t> &data, int32_t readChannel, AudioFrameInfo &info)
 {
     INTELL_VOICE_LOG_DEBUG("enter, read channel:%{public}d", readChannel);
-    if ((readChannel == 0) || (readChannel >= (0x1 << MAX_CHANNEL_CNT))) {
+    // reject channels the source does not have before a frame is consumed
+    if ((readChannel <= 0) || (readChannel >= (0x1 << std::min(channelCnt_, MAX_CHANNEL_CNT)))) {
+        INTELL_VOICE_LOG_ERROR("invalid read channel:%{public}d, channel cnt:%{public}u", readChannel, channelCnt_);
         return -1;
     }
 
-    for (uint32_t i = 0; i < CHANNEL_CNT_4; i++) {
-        if (!(readChannel & (0x1 << i))) {
-            continue;
-        }
-        if (!ReadChannelData(data, i)) {
-            return -1;
-        }
+    if (!ReadFrame(data, readChannel, info)) {
+        return -1;
     }
 
+    UpdateReadStats(info);
     return 0;
 }
 
+void WakeupSourceProcess::UpdateReadStats(AudioFrameInfo &info)
+{
+    if (hasRead_ && (info.sequence != lastReadSeq_ + 1)) {
+        gapCnt_++;
+        INTELL_VOICE_LOG_WARN_LIMIT(LOG_LIMIT_INTERVAL_MS, "sequence gap, last:%{public}llu, current:%{public}llu",
+            static_cast<unsigned long long>(lastReadSeq_), static_cast<unsigned long long>(info.sequence));
+    }
+    hasRead_ = true;
+    lastReadSeq_ = info.sequence;
+
+    int64_t latencyUs = TimeUtil::GetMonotonicTimeUs() - info.captureTimeUs;
+    readCnt_++;
+    totalLatencyUs_ += latencyUs;
+    maxLatencyUs_ = std::max(maxLatencyUs_, latencyUs);
+
+    info.droppedFrames = droppedFrames_.load();
+    info.gapCnt = gapCnt_;
+}
+
+void WakeupSourceProcess::ResetStats()
+{
+    if ((writeSeq_ != 0) || (readCnt_ != 0)) {
+        INTELL_VOICE_LOG_INFO("frames written:%{public}llu, read:%{public}llu, dropped:%{public}llu, "
+            "gaps:%{public}llu, avg latency:%{public}lld us, max latency:%{public}lld us",
+            static_cast<unsigned long long>(writeSeq_), static_cast<unsigned long long>(readCnt_),
+            static_cast<unsigned long long>(droppedFrames_.load()), static_cast<unsigned long long>(gapCnt_),
+            static_cast<long long>((readCnt_ == 0) ? 0 : totalLatencyUs_ / static_cast<int64_t>(readCnt_)),
+            static_cast<long long>(maxLatencyUs_));
+    }
+    writeSeq_ = 0;
+    droppedFrames_.store(0);
+    hasRead_ = false;
+    lastReadSeq_ = 0;
+    gapCnt_ = 0;
+    readCnt_ = 0;
+    totalLatencyUs_ = 0;
+    maxLatencyUs_ = 0;
+}
+
 void WakeupSourceProcess::Release()
 {
-    for (auto &queue : bufferQueue_) {
-        queue ->Uninit();
+    if (frameQueue_ != nullptr) {
+        frameQueue_->Uninit();
+        frameQueue_ = nullptr;
+    }
+    {
+        std::lock_guard<std::mutex> lock(historyMutex_);
+        std::vector<HistoryRing>().swap(history_);
     }
-    std::vector<std::unique_ptr<Uint8ArrayBufferQueue>>().swap(bufferQueue_);
     ReleaseDebugFile();
+    ResetStats();
     channelCnt_ = 0;
 }
 
-void WakeupSourceProcess::WriteChannelData(const std::vector<uint8_t> &channelData, uint32_t channelId)
+void WakeupSourceProcess::SetHistoryDepth(uint32_t depthMs)
 {
-    if ((channelId >= bufferQueue_.size()) || (bufferQueue_[channelId] == nullptr)) {
-        INTELL_VOICE_LOG_ERROR("no buffer queue, channel id:%{public}d", channelId);
-        return;
+    std::lock_guard<std::mutex> lock(historyMutex_);
+    historyDepthMs_ = std::clamp(depthMs, MIN_HISTORY_DEPTH_MS, MAX_HISTORY_DEPTH_MS);
+    INTELL_VOICE_LOG_INFO("history depth:%{public}u ms, takes effect on next init", historyDepthMs_);
+}
+
+bool WakeupSourceProcess::GetHistory(std::vector<uint8_t> &data, uint32_t channelId)
+{
+    std::lock_guard<std::mutex> lock(historyMutex_);
+    if (channelId >= history_.size()) {
+        INTELL_VOICE_LOG_ERROR("no history, channel id:%{public}u", channelId);
+        return false;
     }
 
-    auto arrayBuffer = CreateArrayBuffer<uint8_t>(channelData.size(), &channelData[0]);
-    if (arrayBuffer == nullptr) {
-        INTELL_VOICE_LOG_ERROR("failed to create array buffer");
-        return;
+    const HistoryRing &ring = history_[channelId];
+    if (!ring.isFull && (ring.writePos == 0)) {
+        INTELL_VOICE_LOG_WARN("history is empty, channel id:%{public}u", channelId);
+        return false;
+    }
+
+    // oldest bytes start at writePos once the ring has wrapped
+    data.clear();
+    if (ring.isFull) {
+        data.reserve(ring.buffer.size());
+        data.insert(data.end(), ring.buffer.begin() + ring.writePos, ring.buffer.end());
+    }
+    data.insert(data.end(), ring.buffer.begin(), ring.buffer.begin() + ring.writePos);
+    return true;
+}
+
+void WakeupSourceProcess::InitHistory(uint32_t channelCnt)
+{
+    std::lock_guard<std::mutex> lock(historyMutex_);
+    history_.resize(channelCnt);
+    for (auto &ring : history_) {
+        ring.buffer.resize(historyDepthMs_ * HISTORY_BYTES_PER_MS);
+        ring.writePos = 0;
+        ring.isFull = false;
     }
-    if (!bufferQueue_[channelId]->Push(std::move(arrayBuffer), false)) {
+}
+
+void WakeupSourceProcess::WriteHistory(const std::vector<uint8_t> &channelData, uint32_t channelId)
+{
+    std::lock_guard<std::mutex> lock(historyMutex_);
+    if ((channelId >= history_.size()) || history_[channelId].buffer.empty()) {
         return;
     }
 
-    WriteDebugData(writeDebug_, channelData, channelId);
+    HistoryRing &ring = history_[channelId];
+    size_t capacity = ring.buffer.size();
+    const uint8_t *src = channelData.data();
+    size_t size = channelData.size();
+    if (size >= capacity) {
+        src += size - capacity;
+        size = capacity;
+    }
+
+    size_t firstPart = std::min(size, capacity - ring.writePos);
+    std::copy(src, src + firstPart, ring.buffer.begin() + ring.writePos);
+    std::copy(src + firstPart, src + size, ring.buffer.begin());
+    if (ring.writePos + size >= capacity) {
+        ring.isFull = true;
+    }
+    ring.writePos = (ring.writePos + size) % capacity;
+}
+
+bool WakeupSourceProcess::WriteFrame(const std::vector<std::vector<uint8_t>> &audioData, uint64_t sequence,
+    int64_t captureTimeUs)
+{
+    // the pre-roll history keeps every frame, even one the reader is too slow to take
+    for (uint32_t i = 0; i < channelCnt_; i++) {
+        WriteHistory(audioData[i], i);
+    }
+
+    SourceFrame frame;
+    frame.channels.reserve(channelCnt_);
+    for (uint32_t i = 0; i < channelCnt_; i++) {
+        auto buffer = CreateArrayBuffer<uint8_t>(audioData[i].size(), &audioData[i][0]);
+        if (buffer == nullptr) {
+            INTELL_VOICE_LOG_ERROR("failed to create array buffer, channel id:%{public}u", i);
+            return false;
+        }
+        frame.channels.push_back(std::move(buffer));
+    }
+    frame.sequence = sequence;
+    frame.captureTimeUs = captureTimeUs;
+
+    // one push commits all channels, a reader never sees part of a frame
+    if (!frameQueue_->Push(std::move(frame), false)) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < channelCnt_; i++) {
+        WriteDebugData(writeDebug_, audioData[i].data(), audioData[i].size(), i);
+    }
+    return true;
 }
 
-bool WakeupSourceProcess::ReadChannelData(std::vector<uint8_t> &channelData, uint32_t channelId)
+bool WakeupSourceProcess::ReadFrame(std::vector<uint8_t> &data, int32_t readChannel, AudioFrameInfo &info)
 {
-    if ((channelId >= bufferQueue_.size()) || (bufferQueue_[channelId] == nullptr)) {
-        INTELL_VOICE_LOG_ERROR("no buffer queue, channel id:%{public}d", channelId);
+    if (frameQueue_ == nullptr) {
+        INTELL_VOICE_LOG_ERROR("no frame queue");
         return false;
     }
 
-    std::unique_ptr<Uint8ArrayBuffer> arrayBuffer = nullptr;
-    bufferQueue_[channelId]->PopUntilTimeout(WAIT_TIME, arrayBuffer);
-    if (arrayBuffer == nullptr) {
-        INTELL_VOICE_LOG_ERROR("failed to pop data");
+    // a single wait bounds the read, however many channels are asked for
+    SourceFrame frame;
+    if (!frameQueue_->PopUntilTimeout(WAIT_TIME, frame) || (frame.channels.size() != channelCnt_)) {
+        INTELL_VOICE_LOG_ERROR("failed to pop frame");
         return false;
     }
 
-    channelData.insert(channelData.end(), arrayBuffer->GetData(), arrayBuffer->GetData() + arrayBuffer->GetSize());
-    WriteDebugData(readDebug_, channelData, channelId);
+    info.sequence = frame.sequence;
+    info.captureTimeUs = frame.captureTimeUs;
+    for (uint32_t i = 0; i < channelCnt_; i++) {
+        if (!(static_cast<uint32_t>(readChannel) & (0x1 << i))) {
+            continue;
+        }
+        const std::unique_ptr<Uint8ArrayBuffer> &arrayBuffer = frame.channels[i];
+        data.insert(data.end(), arrayBuffer->GetData(), arrayBuffer->GetData() + arrayBuffer->GetSize());
+        WriteDebugData(readDebug_, arrayBuffer->GetData(), arrayBuffer->GetSize(), i);
+    }
     return true;
 }
 
@@ -158,14 +301,14 @@ void WakeupSourceProcess::InitDebugFile(uint32_t channelCnt)
 }
 
 void WakeupSourceProcess::WriteDebugData(const std::vector<std::shared_ptr<AudioDebug>> &debugVec,
-    const std::vector<uint8_t> &channelData, uint32_t channelId)
+    const uint8_t *channelData, size_t size, uint32_t channelId)
 {
     if ((channelId >= debugVec.size()) || (debugVec[channelId] == nullptr)) {
         INTELL_VOICE_LOG_ERROR("no debug obj, channel id:%{public}d", channelId);
         return;
     }
 
-    debugVec[channelId]->WriteData(reinterpret_cast<const char *>(channelData.data()), channelData.size());
+    debugVec[channelId]->WriteData(reinterpret_cast<const char *>(channelData), size);
 }
 
 void WakeupSourceProcess::ReleaseDebugFile()
@@ -15,17 +15,23 @@
 #ifndef WAKEUP_SOURCE_PROCESS_H
 #define WAKEUP_SOURCE_PROCESS_H
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include "queue_util.h"
 #include "audio_debug.h"
+#include "i_intell_voice_engine.h"
 
 namespace OHOS {
 namespace IntellVoiceEngine {
-using OHOS::IntellVoiceUtils::Uint8ArrayBufferQueue;
+using OHOS::IntellVoiceUtils::Uint8ArrayBuffer;
 constexpr uint32_t CHANNEL_ID_0 = 0;
 constexpr uint32_t CHANNEL_ID_1 = 1;
 constexpr uint32_t CHANNEL_ID_2 = 2;
 constexpr uint32_t CHANNEL_ID_3 = 3;
+constexpr uint32_t MIN_HISTORY_DEPTH_MS = 1000;
+constexpr uint32_t MAX_HISTORY_DEPTH_MS = 3000;
+constexpr uint32_t DEFAULT_HISTORY_DEPTH_MS = 2000;
 
 class WakeupSourceProcess {
 public:
@@ -33,20 +39,55 @@ public:
     ~WakeupSourceProcess();
     void Init(uint32_t channelCnt);
     void Write(const std::vector<std::vector<uint8_t>> &audioData);
+    void Write(const std::vector<std::vector<uint8_t>> &audioData, int64_t captureTimeUs);
     int32_t Read(std::vector<uint8_t> &data, int32_t readChannel);
+    int32_t Read(std::vector<uint8_t> &data, int32_t readChannel, AudioFrameInfo &info);
     void Release();
+    void SetHistoryDepth(uint32_t depthMs);
+    bool GetHistory(std::vector<uint8_t> &data, uint32_t channelId);
 
 private:
-    void WriteChannelData(const std::vector<uint8_t> &channelData, uint32_t channelId);
-    bool ReadChannelData(std::vector<uint8_t> &channelData, uint32_t channelId);
+    // all channels of one capture instant, queued and popped as a whole
+    struct SourceFrame {
+        std::vector<std::unique_ptr<Uint8ArrayBuffer>> channels;
+        uint64_t sequence = 0;
+        int64_t captureTimeUs = 0;
+    };
+    using SourceFrameQueue = OHOS::IntellVoiceUtils::QueueUtil<SourceFrame>;
+
+    struct HistoryRing {
+        std::vector<uint8_t> buffer;
+        size_t writePos = 0;
+        bool isFull = false;
+    };
+
+    void InitHistory(uint32_t channelCnt);
+    void WriteHistory(const std::vector<uint8_t> &channelData, uint32_t channelId);
+    bool WriteFrame(const std::vector<std::vector<uint8_t>> &audioData, uint64_t sequence, int64_t captureTimeUs);
+    bool ReadFrame(std::vector<uint8_t> &data, int32_t readChannel, AudioFrameInfo &info);
+    void UpdateReadStats(AudioFrameInfo &info);
+    void ResetStats();
     void InitDebugFile(uint32_t channelCnt);
     void WriteDebugData(const std::vector<std::shared_ptr<AudioDebug>> &debugVec,
-        const std::vector<uint8_t> &channelData, uint32_t channelId);
+        const uint8_t *channelData, size_t size, uint32_t channelId);
     void ReleaseDebugFile();
     uint32_t channelCnt_ = 0;
-    std::vector<std::unique_ptr<Uint8ArrayBufferQueue>> bufferQueue_;
+    std::unique_ptr<SourceFrameQueue> frameQueue_ = nullptr;
     std::vector<std::shared_ptr<AudioDebug>> writeDebug_;
     std::vector<std::shared_ptr<AudioDebug>> readDebug_;
+    std::mutex historyMutex_;
+    uint32_t historyDepthMs_ = DEFAULT_HISTORY_DEPTH_MS;
+    std::vector<HistoryRing> history_;
+    // written by the capture thread, read by the reading thread
+    uint64_t writeSeq_ = 0;
+    std::atomic<uint64_t> droppedFrames_ { 0 };
+    // reading thread only
+    bool hasRead_ = false;
+    uint64_t lastReadSeq_ = 0;
+    uint64_t gapCnt_ = 0;
+    uint64_t readCnt_ = 0;
+    int64_t totalLatencyUs_ = 0;
+    int64_t maxLatencyUs_ = 0;
 };
 }
 }
@@ -18,10 +18,13 @@
 #include <cstdio>
 #include <fstream>
 #include <iostream>
+#include <chrono>
+#include <vector>
 
 #include "intell_voice_log.h"
 #include "intell_voice_util.h"
 #include "huks_manager_test.h"
+#include "huks_aes_adapter.h"
 
 #define LOG_TAG "HuksManagerUnitTest"
 
@@ -75,4 +78,46 @@ HWTEST_F(HuksManagerUnitTest, HuksManagerUnitTest_001, TestSize.Level1)
 
     EXPECT_EQ(inData->GetSize(), outData2->GetSize());
     EXPECT_EQ(*(inData->GetData()), *(outData2->GetData()));
-}
\ No newline at end of file
+}
+
+/**
+ * @tc.name  : Test Template HuksManagerUnitTest
+ * @tc.number: HuksManagerUnitTest_002
+ * @tc.desc  : Test For In Place Encrypt And Decrypt Throughput Across Payload Sizes
+ */
+HWTEST_F(HuksManagerUnitTest, HuksManagerUnitTest_002, TestSize.Level1)
+{
+    const std::vector<uint32_t> payloadSizes = { 1024, 64 * 1024, 256 * 1024, 1024 * 1024, 4 * 1024 * 1024 };
+    const uint32_t loopNum = 5;
+    const double usPerSec = 1000000.0;
+
+    for (auto size : payloadSizes) {
+        std::vector<uint8_t> plain(size);
+        for (uint32_t i = 0; i < size; ++i) {
+            plain[i] = static_cast<uint8_t>(i);
+        }
+        std::vector<uint8_t> cipher(HuksAesAdapter::GetEncryptSize(size));
+        std::vector<uint8_t> result(size);
+
+        int64_t encryptUs = 0;
+        int64_t decryptUs = 0;
+        for (uint32_t loop = 0; loop < loopNum; ++loop) {
+            struct HksBlob inData = { size, plain.data() };
+            struct HksBlob cipherData = { static_cast<uint32_t>(cipher.size()), cipher.data() };
+            auto begin = std::chrono::steady_clock::now();
+            EXPECT_EQ(HuksAesAdapter::Encrypt(&inData, &cipherData), HKS_SUCCESS);
+            auto mid = std::chrono::steady_clock::now();
+            struct HksBlob outData = { size, result.data() };
+            EXPECT_EQ(HuksAesAdapter::Decrypt(&cipherData, &outData), HKS_SUCCESS);
+            auto end = std::chrono::steady_clock::now();
+            encryptUs += std::chrono::duration_cast<std::chrono::microseconds>(mid - begin).count();
+            decryptUs += std::chrono::duration_cast<std::chrono::microseconds>(end - mid).count();
+            EXPECT_EQ(outData.size, size);
+        }
+        EXPECT_EQ(plain, result);
+
+        double totalMb = static_cast<double>(size) * loopNum / (1024 * 1024);
+        INTELL_VOICE_LOG_INFO("payload %{public}u bytes, encrypt %{public}.2f MB/s, decrypt %{public}.2f MB/s", size,
+            (encryptUs > 0 ? totalMb * usPerSec / encryptUs : 0), (decryptUs > 0 ? totalMb * usPerSec / decryptUs : 0));
+    }
+}
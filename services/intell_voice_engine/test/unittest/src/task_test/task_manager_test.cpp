@@ -56,5 +56,15 @@ void TaskManagerTest::AddSyncTask(int32_t value)
         INTELL_VOICE_LOG_INFO("AddSyncTask threadId_: %{public}d", threadId_);
     });
 }
+
+void TaskManagerTest::AddHighPriorityTask(int32_t value)
+{
+    TaskExecutor::AddAsyncTask(
+        [this, value]() {
+            threadId_ = value;
+            INTELL_VOICE_LOG_INFO("AddHighPriorityTask threadId_: %{public}d", threadId_);
+        },
+        std::to_string(value), false, TaskPriority::HIGH);
+}
 }  // namespace IntellVoiceEngine
 }  // namespace OHOS
@@ -32,6 +32,8 @@ public:
 
     void AddAsyncTask(int32_t value);
     void AddSyncTask(int32_t value);
+    void AddHighPriorityTask(int32_t value);
+    using OHOS::IntellVoiceUtils::TaskExecutor::GetMetrics;
 
     int32_t threadId_ = -1;
 };
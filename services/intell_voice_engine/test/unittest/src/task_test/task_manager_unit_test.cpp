@@ -16,9 +16,13 @@
 #include <gtest/gtest.h>
 #include <unistd.h>
 #include <cstdio>
+#include <chrono>
+#include <future>
+#include <thread>
 
 #include "intell_voice_log.h"
 #include "task_manager_test.h"
+#include "startup_scheduler.h"
 
 #define LOG_TAG "TaskManagerUnitTest"
 
@@ -91,3 +95,74 @@ HWTEST_F(TaskManagerUnitTest, TaskManagerUnitTest_002, TestSize.Level1)
     EXPECT_NE(ret, taskManagerTest->threadId_);
     INTELL_VOICE_LOG_INFO("TaskManagerUnitTest_002 end");
 }
+
+
+/**
+ * @tc.name  : Test Template TaskManagerUnitTest
+ * @tc.number: TaskManagerUnitTest_003
+ * @tc.desc  : Test For StartupScheduler Stage Dependency
+ */
+HWTEST_F(TaskManagerUnitTest, TaskManagerUnitTest_003, TestSize.Level1)
+{
+    INTELL_VOICE_LOG_INFO("TaskManagerUnitTest_003 start");
+
+    StartupScheduler scheduler("StartupTest");
+    // second waits for first to start and first waits for second to finish, so they have to overlap
+    std::promise<void> firstStarted;
+    auto firstStartedFuture = firstStarted.get_future();
+    bool isFirstStarted = false;
+    bool isSecondDone = false;
+    EXPECT_TRUE(scheduler.AddStage("second", {}, [&]() {
+        isFirstStarted = (firstStartedFuture.wait_for(std::chrono::seconds(1)) == std::future_status::ready);
+    }));
+    EXPECT_TRUE(scheduler.AddStage("first", {}, [&]() {
+        firstStarted.set_value();
+        isSecondDone = scheduler.WaitStage("second", 1000);
+    }));
+    EXPECT_TRUE(scheduler.AddStage("last", { "first", "second" }, []() {}));
+    EXPECT_FALSE(scheduler.AddStage("invalid", { "unknown" }, []() {}));
+
+    // a ready inline stage runs before AddStage returns, on the calling thread
+    std::thread::id inlineThreadId;
+    EXPECT_TRUE(scheduler.AddStage("inline", {}, [&]() { inlineThreadId = std::this_thread::get_id(); }, true));
+    EXPECT_EQ(inlineThreadId, std::this_thread::get_id());
+
+    EXPECT_TRUE(scheduler.WaitStage("last", 1000));
+    scheduler.Join();
+    EXPECT_TRUE(isFirstStarted);
+    EXPECT_TRUE(isSecondDone);
+
+    auto costs = scheduler.GetStageCosts();
+    ASSERT_EQ(costs.size(), 4);
+    EXPECT_LT(costs["first"].startSeq, costs["second"].doneSeq);
+    EXPECT_GT(costs["first"].doneSeq, costs["second"].doneSeq);
+    EXPECT_GT(costs["last"].startSeq, costs["first"].doneSeq);
+    EXPECT_GT(costs["last"].startSeq, costs["second"].doneSeq);
+    INTELL_VOICE_LOG_INFO("TaskManagerUnitTest_003 end");
+}
+
+/**
+ * @tc.name  : Test Template TaskManagerUnitTest
+ * @tc.number: TaskManagerUnitTest_004
+ * @tc.desc  : Test For High Priority Task And Metrics
+ */
+HWTEST_F(TaskManagerUnitTest, TaskManagerUnitTest_004, TestSize.Level1)
+{
+    INTELL_VOICE_LOG_INFO("TaskManagerUnitTest_004 start");
+
+    auto taskManagerTest = std::make_shared<TaskManagerTest>();
+    EXPECT_NE(taskManagerTest, nullptr);
+
+    taskManagerTest->AddAsyncTask(1);
+    taskManagerTest->AddAsyncTask(2);
+    taskManagerTest->AddHighPriorityTask(3);
+    usleep(1500000);
+    EXPECT_EQ(3, taskManagerTest->threadId_);
+    sleep(1);
+    EXPECT_EQ(2, taskManagerTest->threadId_);
+
+    auto metrics = taskManagerTest->GetMetrics();
+    EXPECT_EQ(metrics.executedCnt, 3);
+    EXPECT_EQ(metrics.dropped[static_cast<uint32_t>(TaskPriority::HIGH)], 0);
+    INTELL_VOICE_LOG_INFO("TaskManagerUnitTest_004 end");
+}
@@ -46,6 +46,13 @@ struct EvaluationResult {
     int32_t resultCode;
 };
 
+struct AudioFrameInfo {
+    uint64_t sequence { 0 };        // per capture session, starts at 0
+    int64_t captureTimeUs { 0 };    // CLOCK_MONOTONIC
+    uint64_t droppedFrames { 0 };   // frames the service dropped in this session so far
+    uint64_t gapCnt { 0 };          // sequence gaps seen by reads in this session so far
+};
+
 struct IntellVoiceEngineInfo {
     std::string wakeupPhrase;
     bool isPcmFromExternal { false };
@@ -87,6 +94,9 @@ public:
     virtual int32_t WriteAudio(const uint8_t *buffer, uint32_t size) = 0;
     virtual int32_t StartCapturer(int32_t channels) = 0;
     virtual int32_t Read(std::vector<uint8_t> &data) = 0;
+    virtual int32_t ReadFrame(std::vector<uint8_t> &data, AudioFrameInfo &info) = 0;
+    // codec for the pcm of Read over ipc, the proxy decodes it again; a no-op for in-process engines
+    virtual void SetReadCodec(int32_t /* codec */) {}
     virtual int32_t StopCapturer() = 0;
     virtual int32_t GetWakeupPcm(std::vector<uint8_t> &data) = 0;
     virtual int32_t Evaluate(const std::string &word, EvaluationResult &result) = 0;
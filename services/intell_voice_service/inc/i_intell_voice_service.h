@@ -20,9 +20,15 @@
 #include "iremote_broker.h"
 #include <ashmem.h>
 #include "i_intell_voice_engine.h"
+#include "intell_voice_param.h"
 
 namespace OHOS {
 namespace IntellVoiceEngine {
+constexpr uint32_t CLONE_FILES_BATCH_SIZE_DEFAULT = 1024 * 1024; // 1M
+constexpr uint32_t CLONE_FILES_BATCH_SIZE_MAX = 16 * 1024 * 1024; // 16M
+constexpr uint32_t CLONE_FILES_BATCH_NUM_MAX = 1024;
+constexpr uint32_t PARAM_BATCH_NUM_MAX = 64;
+
 struct UploadFilesFromHdi {
     int32_t type;
     std::string filesDescription;
@@ -45,17 +51,27 @@ public:
         HDI_INTELL_VOICE_SERVICE_SEND_CLONE_FILE,
         HDI_INTELL_VOICE_SERVICE_CLONE_FOR_RESULT,
         HDI_INTELL_VOICE_SERVICE_SET_PARAMETER,
-        HDI_INTELL_VOICE_SERVICE_CLEAR_USER_DATA
+        HDI_INTELL_VOICE_SERVICE_CLEAR_USER_DATA,
+        HDI_INTELL_VOICE_SERVICE_GET_CLONE_FILES_BATCH,
+        HDI_INTELL_VOICE_SERVICE_SEND_CLONE_FILES_BATCH,
+        HDI_INTELL_VOICE_SERVICE_SET_PARAMETERS
     };
 
     virtual int32_t CreateIntellVoiceEngine(IntellVoiceEngineType type, sptr<IIntellVoiceEngine> &inst) = 0;
     virtual int32_t ReleaseIntellVoiceEngine(IntellVoiceEngineType type) = 0;
     virtual int32_t GetUploadFiles(int numMax, std::vector<UploadFilesFromHdi> &files) = 0;
     virtual int32_t SetParameter(const std::string &keyValueList) = 0;
+    // keys cross ipc as ParamKey ids, the service dispatches them without parsing a key value list
+    virtual int32_t SetParameters(const IntellVoiceUtils::ParamBatch &batch) = 0;
     virtual std::string GetParameter(const std::string &key) = 0;
     virtual int32_t GetWakeupSourceFilesList(std::vector<std::string>& cloneFiles) = 0;
     virtual int32_t GetWakeupSourceFile(const std::string &filePath, std::vector<uint8_t> &buffer) = 0;
     virtual int32_t SendWakeupFile(const std::string &filePath, const std::vector<uint8_t> &buffer) = 0;
+    // files are packed back to back into one ashmem, fileSizes gives the length of each file in order
+    virtual int32_t GetWakeupSourceFilesBatch(const std::vector<std::string> &filePaths, uint32_t maxBatchSize,
+        std::vector<uint32_t> &fileSizes, sptr<Ashmem> &ashmem) = 0;
+    virtual int32_t SendWakeupFilesBatch(const std::vector<std::string> &filePaths,
+        const std::vector<uint32_t> &fileSizes, const sptr<Ashmem> &ashmem) = 0;
     virtual int32_t EnrollWithWakeupFilesForResult(const std::string &wakeupInfo,
         const sptr<IRemoteObject> object) = 0;
     virtual int32_t ClearUserData() = 0;
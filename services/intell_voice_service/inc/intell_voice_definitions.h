@@ -35,6 +35,14 @@ const std::string KEY_SENSIBILITY = "Sensibility";
 const std::string KEY_WAKEUP_DSP_FEATURE = "WakeupDspFeature";
 const std::string KEY_WHISPER_VPR = "WhisperVpr";
 
+const std::string STAGE_TRIGGER_START = "trigger_start";
+const std::string STAGE_ENGINE_HOST = "engine_host";
+const std::string STAGE_SWITCH_PROVIDER = "switch_provider";
+const std::string STAGE_BREATH_MODEL = "breath_model";
+const std::string STAGE_SINGLE_LEVEL_MODEL = "single_level_model";
+const std::string STAGE_SILENCE_UPDATE = "silence_update";
+const std::string STAGE_SWITCH_ON = "switch_on";
+
 static const std::string WHISPER_MODEL_PATH_VDE =
     "/sys_prod/variant/region_comm/china/etc/intellvoice/wakeup/dsp/whisper_wakeup_dsp_config_vde";
 static const std::string WHISPER_VPR_CONFIG_PATH =
@@ -14,6 +14,7 @@
  */
 #include "intell_voice_service.h"
 
+#include <algorithm>
 #include <malloc.h>
 #include <fcntl.h>
 #include <cstdio>
@@ -26,6 +27,9 @@
 #include "common_event_support.h"
 #include "intell_voice_util.h"
 #include "intell_voice_info.h"
+#include "scope_guard.h"
+#include "hot_log.h"
+#include "task_executor.h"
 
 #define LOG_TAG "IntellVoiceService"
 
@@ -130,6 +134,23 @@ void IntellVoiceService::OnStop(void)
     }
 }
 
+int IntellVoiceService::Dump(int fd, const std::vector<std::u16string> &args)
+{
+    INTELL_VOICE_LOG_INFO("enter");
+    if (fd < 0) {
+        INTELL_VOICE_LOG_ERROR("invalid fd");
+        return -1;
+    }
+
+    std::string info = HotLogRing::GetInstance().Dump();
+    info += TaskExecutor::DumpAllMetrics();
+    if (write(fd, info.c_str(), info.size()) < 0) {
+        INTELL_VOICE_LOG_ERROR("failed to write dump info");
+        return -1;
+    }
+    return 0;
+}
+
 int32_t IntellVoiceService::OnIdle(const SystemAbilityOnDemandReason &idleReason)
 {
     INTELL_VOICE_LOG_INFO("enter");
@@ -205,30 +226,41 @@ void IntellVoiceService::InitIntellVoiceService()
 {
     INTELL_VOICE_LOG_INFO("enter");
     auto &manager = ServiceManagerType::GetInstance();
-    manager.CreateSwitchProvider();
-    manager.ProcBreathModel();
-    manager.ProcSingleLevelModel();
-    manager.HandleSilenceUpdate();
+    manager.AddStartupStage(STAGE_SWITCH_PROVIDER, {}, [&manager]() { manager.CreateSwitchProvider(); });
+    manager.AddStartupStage(STAGE_BREATH_MODEL, {}, [&manager]() { manager.ProcBreathModel(); });
+    // both models are written to the same trigger db, keep them in order
+    manager.AddStartupStage(STAGE_SINGLE_LEVEL_MODEL, { STAGE_BREATH_MODEL },
+        [&manager]() { manager.ProcSingleLevelModel(); });
+    manager.AddStartupStage(STAGE_SILENCE_UPDATE, {}, [&manager]() { manager.HandleSilenceUpdate(); });
+    manager.AddStartupStage(STAGE_SWITCH_ON,
+        { STAGE_SWITCH_PROVIDER, STAGE_SINGLE_LEVEL_MODEL, STAGE_SILENCE_UPDATE },
+        [&manager, reasonId = reasonId_, reasonName = reasonName_]() {
+            SwitchOnByReason(manager, reasonId, reasonName);
+        });
+    reasonId_ = -1;
+}
 
-    if (reasonId_ == static_cast<int32_t>(OHOS::OnDemandReasonId::COMMON_EVENT)) {
+void IntellVoiceService::SwitchOnByReason(ServiceManagerType &manager, int32_t reasonId,
+    const std::string &reasonName)
+{
+    if (reasonId == static_cast<int32_t>(OHOS::OnDemandReasonId::COMMON_EVENT)) {
         INTELL_VOICE_LOG_INFO("common event start");
         manager.HandleSwitchOn(true, VOICE_WAKEUP_MODEL_UUID, false);
         manager.HandleSwitchOn(true, PROXIMAL_WAKEUP_MODEL_UUID, false);
-        if (reasonName_ == std::string("usual.event.POWER_SAVE_MODE_CHANGED")) {
+        if (reasonName == std::string("usual.event.POWER_SAVE_MODE_CHANGED")) {
             INTELL_VOICE_LOG_INFO("power save mode change");
             manager.HandlePowerSaveModeChange();
         } else {
             INTELL_VOICE_LOG_INFO("power on");
             manager.HandleUnloadIntellVoiceService(true);
         }
-    } else if (reasonId_ == static_cast<int32_t>(OHOS::OnDemandReasonId::INTERFACE_CALL)) {
+    } else if (reasonId == static_cast<int32_t>(OHOS::OnDemandReasonId::INTERFACE_CALL)) {
         INTELL_VOICE_LOG_INFO("interface call start");
         manager.HandleSwitchOn(true, VOICE_WAKEUP_MODEL_UUID, false);
         manager.HandleSwitchOn(true, PROXIMAL_WAKEUP_MODEL_UUID, false);
     } else {
-        INTELL_VOICE_LOG_INFO("no need to process, reason id:%{public}d", reasonId_);
+        INTELL_VOICE_LOG_INFO("no need to process, reason id:%{public}d", reasonId);
     }
-    reasonId_ = -1;
 }
 
 void IntellVoiceService::OnReceiveCes(const OHOS::EventFwk::CommonEventData &data)
@@ -348,6 +380,17 @@ int32_t IntellVoiceService::SetParameter(const std::string &keyValueList)
     return ServiceManagerType::GetInstance().EngineSetParameter(keyValueList);
 }
 
+int32_t IntellVoiceService::SetParameters(const IntellVoiceUtils::ParamBatch &batch)
+{
+    auto ret = IntellVoiceUtil::VerifySystemPermission(OHOS_PERMISSION_INTELL_VOICE);
+    if (ret != INTELLIGENT_VOICE_SUCCESS) {
+        INTELL_VOICE_LOG_WARN("verify permission denied");
+        return ret;
+    }
+
+    return ServiceManagerType::GetInstance().EngineSetParameters(batch);
+}
+
 int32_t IntellVoiceService::GetWakeupSourceFilesList(std::vector<std::string>& cloneFiles)
 {
     auto ret = IntellVoiceUtil::VerifySystemPermission(OHOS_PERMISSION_INTELL_VOICE);
@@ -383,6 +426,142 @@ int32_t IntellVoiceService::SendWakeupFile(const std::string &filePath, const st
     return ServiceManagerType::GetInstance().SendWakeupFile(filePath, buffer);
 }
 
+int32_t IntellVoiceService::GetWakeupSourceFilesBatch(const std::vector<std::string> &filePaths,
+    uint32_t maxBatchSize, std::vector<uint32_t> &fileSizes, sptr<Ashmem> &ashmem)
+{
+    auto ret = IntellVoiceUtil::VerifySystemPermission(OHOS_PERMISSION_INTELL_VOICE);
+    if (ret != INTELLIGENT_VOICE_SUCCESS) {
+        INTELL_VOICE_LOG_WARN("verify permission denied");
+        return ret;
+    }
+
+    if ((maxBatchSize == 0) || (maxBatchSize > CLONE_FILES_BATCH_SIZE_MAX)) {
+        maxBatchSize = CLONE_FILES_BATCH_SIZE_MAX;
+    }
+
+    // a file that does not fit is left for the next batch, only a first file larger than the batch goes alone
+    std::vector<std::vector<uint8_t>> files;
+    uint32_t totalSize = 0;
+    for (const auto &filePath : filePaths) {
+        if (totalSize >= maxBatchSize) {
+            break;
+        }
+        std::vector<uint8_t> buffer;
+        ret = ServiceManagerType::GetInstance().GetWakeupSourceFile(filePath, buffer);
+        if (ret != 0) {
+            INTELL_VOICE_LOG_ERROR("get wakeup source file failed, ret:%{public}d", ret);
+            return ret;
+        }
+        if (buffer.size() > CLONE_FILES_BATCH_SIZE_MAX) {
+            INTELL_VOICE_LOG_ERROR("invalid file size %{public}zu", buffer.size());
+            return -1;
+        }
+        if (!files.empty() && (static_cast<uint64_t>(totalSize) + buffer.size() > maxBatchSize)) {
+            break;
+        }
+        totalSize += static_cast<uint32_t>(buffer.size());
+        files.emplace_back(std::move(buffer));
+    }
+
+    ashmem = CreateAshmemFromFiles(files, totalSize, fileSizes);
+    if (ashmem == nullptr) {
+        INTELL_VOICE_LOG_ERROR("failed to create files ashmem");
+        return -1;
+    }
+    INTELL_VOICE_LOG_INFO("get wakeup source files batch, num:%{public}zu, size:%{public}u", files.size(),
+        totalSize);
+    return 0;
+}
+
+sptr<Ashmem> IntellVoiceService::CreateAshmemFromFiles(std::vector<std::vector<uint8_t>> &files,
+    uint32_t totalSize, std::vector<uint32_t> &fileSizes)
+{
+    if (files.empty()) {
+        INTELL_VOICE_LOG_ERROR("no file");
+        return nullptr;
+    }
+
+    // ashmem cannot be empty, a batch of empty files still maps one byte
+    sptr<Ashmem> ashmem = Ashmem::CreateAshmem("WakeupSourceFiles", static_cast<int32_t>(std::max(totalSize, 1U)));
+    if (ashmem == nullptr) {
+        INTELL_VOICE_LOG_ERROR("failed to create ashmem");
+        return nullptr;
+    }
+
+    if (!ashmem->MapReadAndWriteAshmem()) {
+        INTELL_VOICE_LOG_ERROR("failed to map ashmem");
+        ashmem->CloseAshmem();
+        return nullptr;
+    }
+
+    uint32_t offset = 0;
+    for (auto &file : files) {
+        if (!file.empty() && !ashmem->WriteToAshmem(file.data(), file.size(), offset)) {
+            INTELL_VOICE_LOG_ERROR("failed to write ashmem");
+            ashmem->UnmapAshmem();
+            ashmem->CloseAshmem();
+            return nullptr;
+        }
+        offset += static_cast<uint32_t>(file.size());
+        fileSizes.push_back(static_cast<uint32_t>(file.size()));
+        std::vector<uint8_t>().swap(file);
+    }
+    ashmem->UnmapAshmem();
+    return ashmem;
+}
+
+int32_t IntellVoiceService::SendWakeupFilesBatch(const std::vector<std::string> &filePaths,
+    const std::vector<uint32_t> &fileSizes, const sptr<Ashmem> &ashmem)
+{
+    auto ret = IntellVoiceUtil::VerifySystemPermission(OHOS_PERMISSION_INTELL_VOICE);
+    if (ret != INTELLIGENT_VOICE_SUCCESS) {
+        INTELL_VOICE_LOG_WARN("verify permission denied");
+        return ret;
+    }
+
+    if ((ashmem == nullptr) || (filePaths.size() != fileSizes.size())) {
+        INTELL_VOICE_LOG_ERROR("invalid files batch");
+        return -1;
+    }
+
+    ON_SCOPE_EXIT {
+        ashmem->UnmapAshmem();
+        ashmem->CloseAshmem();
+    };
+
+    uint64_t totalSize = static_cast<uint64_t>(ashmem->GetAshmemSize());
+    if ((totalSize == 0) || !ashmem->MapReadOnlyAshmem()) {
+        INTELL_VOICE_LOG_ERROR("failed to map ashmem");
+        return -1;
+    }
+
+    uint64_t offset = 0;
+    for (size_t i = 0; i < filePaths.size(); i++) {
+        if (offset + fileSizes[i] > totalSize) {
+            INTELL_VOICE_LOG_ERROR("invalid file size %{public}u", fileSizes[i]);
+            return -1;
+        }
+        std::vector<uint8_t> buffer;
+        if (fileSizes[i] != 0) {
+            const uint8_t *mem = static_cast<const uint8_t *>(ashmem->ReadFromAshmem(fileSizes[i], offset));
+            if (mem == nullptr) {
+                INTELL_VOICE_LOG_ERROR("read from ashmem failed");
+                return -1;
+            }
+            buffer.assign(mem, mem + fileSizes[i]);
+        }
+        ret = ServiceManagerType::GetInstance().SendWakeupFile(filePaths[i], buffer);
+        if (ret != 0) {
+            INTELL_VOICE_LOG_ERROR("send wakeup file failed, index:%{public}zu, ret:%{public}d", i, ret);
+            return ret;
+        }
+        offset += fileSizes[i];
+    }
+
+    INTELL_VOICE_LOG_INFO("send wakeup files batch, num:%{public}zu", filePaths.size());
+    return 0;
+}
+
 int32_t IntellVoiceService::EnrollWithWakeupFilesForResult(const std::string &wakeupInfo,
     const sptr<IRemoteObject> object)
 {
@@ -21,6 +21,7 @@
 #include "system_ability.h"
 #include "intell_voice_service_stub.h"
 #include "system_event_observer.h"
+#include "service_manager_type.h"
 
 namespace OHOS {
 namespace IntellVoiceEngine {
@@ -38,12 +39,18 @@ public:
     int32_t GetUploadFiles(int numMax, std::vector<UploadFilesFromHdi> &files) override;
 
     int32_t SetParameter(const std::string &keyValueList) override;
+    int32_t SetParameters(const IntellVoiceUtils::ParamBatch &batch) override;
     std::string GetParameter(const std::string &key) override;
     int32_t GetWakeupSourceFilesList(std::vector<std::string>& cloneFiles) override;
     int32_t GetWakeupSourceFile(const std::string &filePath, std::vector<uint8_t> &buffer) override;
     int32_t SendWakeupFile(const std::string &filePath, const std::vector<uint8_t> &buffer) override;
+    int32_t GetWakeupSourceFilesBatch(const std::vector<std::string> &filePaths, uint32_t maxBatchSize,
+        std::vector<uint32_t> &fileSizes, sptr<Ashmem> &ashmem) override;
+    int32_t SendWakeupFilesBatch(const std::vector<std::string> &filePaths,
+        const std::vector<uint32_t> &fileSizes, const sptr<Ashmem> &ashmem) override;
     int32_t EnrollWithWakeupFilesForResult(const std::string &wakeupInfo, const sptr<IRemoteObject> object) override;
     int32_t ClearUserData() override;
+    int Dump(int fd, const std::vector<std::u16string> &args) override;
 
     class PerStateChangeCbCustomizeCallback : public Security::AccessToken::PermStateChangeCallbackCustomize {
     public:
@@ -67,7 +74,10 @@ private:
     void OnCommonEventServiceChange(bool isAdded);
     void OnDistributedKvDataServiceChange(bool isAdded);
     void InitIntellVoiceService();
+    static void SwitchOnByReason(ServiceManagerType &manager, int32_t reasonId, const std::string &reasonName);
     void OnReceiveCes(const OHOS::EventFwk::CommonEventData &data);
+    static sptr<Ashmem> CreateAshmemFromFiles(std::vector<std::vector<uint8_t>> &files, uint32_t totalSize,
+        std::vector<uint32_t> &fileSizes);
 
 private:
     int32_t reasonId_ = -1;
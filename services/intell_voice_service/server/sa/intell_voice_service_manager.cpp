@@ -26,6 +26,7 @@
 #include "memory_guard.h"
 #include "string_util.h"
 #include "history_info_mgr.h"
+#include "worker_pool.h"
 
 #define LOG_TAG "IntellVoiceServiceManager"
 
@@ -39,11 +40,17 @@ static constexpr int32_t WAIT_AUDIO_HAL_INTERVAL = 500; //500ms
 static constexpr uint32_t MAX_TASK_NUM = 2048;
 static constexpr uint32_t WAIT_SWICTH_ON_TIME = 2000;  // 2000ms
 static constexpr uint32_t WAIT_RECORD_START_TIME = 10000; // 10s
+static constexpr uint32_t ON_IDLE_TIMEOUT_MS = 3000;
+static constexpr uint32_t WAIT_ENGINE_HOST_TIME = 5000; // 5s
+static constexpr int64_t SWITCH_RECONCILE_INTERVAL_MS = 60000; // 60s
 static const std::string STOP_ALL_RECOGNITION = "stop_all_recognition";
 static const std::string SHORT_WORD_SWITCH = "short_word_switch";
 template<typename T, typename E>
-IntellVoiceServiceManager<T, E>::IntellVoiceServiceManager() : TaskExecutor("ServMgrThread", MAX_TASK_NUM)
+IntellVoiceServiceManager<T, E>::IntellVoiceServiceManager() : TaskExecutor("ServMgrThread", MAX_TASK_NUM),
+    startupScheduler_("ServiceStartup")
 {
+    ResetSwitchCache();
+    InitParamDispatcher();
     TaskExecutor::StartThread();
 #if defined(ENGINE_ENABLE) || defined(FIRST_STAGE_ONESHOT_ENABLE)
     RegisterEngineCallbacks();
@@ -65,6 +72,7 @@ IntellVoiceServiceManager<T, E>::~IntellVoiceServiceManager()
         taskQueue_.reset();
     }
 #endif
+    switchReconcileTimer_.Stop();
     TaskExecutor::StopThread();
 }
 
@@ -72,15 +80,26 @@ template<typename T, typename E>
 void IntellVoiceServiceManager<T, E>::CreateSwitchProvider()
 {
     INTELL_VOICE_LOG_INFO("enter");
-    std::lock_guard<std::mutex> lock(switchMutex_);
-    switchProvider_ = UniquePtrFactory<SwitchProvider>::CreateInstance();
-    if (switchProvider_ == nullptr) {
-        INTELL_VOICE_LOG_ERROR("switchProvider_ is nullptr");
-        return;
+    {
+        std::lock_guard<std::mutex> lock(switchMutex_);
+        switchProvider_ = UniquePtrFactory<SwitchProvider>::CreateInstance();
+        if (switchProvider_ == nullptr) {
+            INTELL_VOICE_LOG_ERROR("switchProvider_ is nullptr");
+            return;
+        }
+        RegisterObserver(WAKEUP_KEY);
+        RegisterObserver(WHISPER_KEY);
+        RegisterObserver(SHORTWORD_KEY);
+
+        for (const auto &key : GetSwitchKeys()) {
+            bool status = false;
+            RefreshSwitchStatusLocked(key, status);
+            INTELL_VOICE_LOG_INFO("switch %{public}s is %{public}d", key.c_str(), status);
+        }
     }
-    RegisterObserver(WAKEUP_KEY);
-    RegisterObserver(WHISPER_KEY);
-    RegisterObserver(SHORTWORD_KEY);
+
+    switchReconcileTimer_.Start("SwitchReconcile", this);
+    switchReconcileTimer_.SetTimer(0, SWITCH_RECONCILE_INTERVAL_MS * US_PER_MS);
 }
 
 template<typename T, typename E>
@@ -92,6 +111,8 @@ void IntellVoiceServiceManager<T, E>::RegisterObserver(const std::string &switch
         return;
     }
     switchObserver_[switchKey]->SetUpdateFunc([this, switchKey]() {
+        bool status = false;
+        RefreshSwitchStatus(switchKey, status);
         OnSwitchChange(switchKey);
     });
 
@@ -101,18 +122,71 @@ void IntellVoiceServiceManager<T, E>::RegisterObserver(const std::string &switch
 template<typename T, typename E>
 void IntellVoiceServiceManager<T, E>::ReleaseSwitchProvider()
 {
+    // the reconcile timer takes switchMutex_, stop it before holding the lock
+    switchReconcileTimer_.Stop();
+
     std::lock_guard<std::mutex> lock(switchMutex_);
     if (switchProvider_ == nullptr) {
         INTELL_VOICE_LOG_ERROR("switchProvider_ is nullptr");
         return;
     }
 
-    for (auto it : switchObserver_) {
+    for (const auto &it : switchObserver_) {
         if (it.second != nullptr) {
             switchProvider_->UnregisterObserver(it.second, it.first);
         }
     }
     switchProvider_ = nullptr;
+    ResetSwitchCache();
+}
+
+template<typename T, typename E>
+void IntellVoiceServiceManager<T, E>::ResetSwitchCache()
+{
+    for (auto &state : switchCache_) {
+        state.store(SWITCH_STATE_UNKNOWN, std::memory_order_release);
+    }
+}
+
+template<typename T, typename E>
+bool IntellVoiceServiceManager<T, E>::RefreshSwitchStatus(const std::string &key, bool &status)
+{
+    std::lock_guard<std::mutex> lock(switchMutex_);
+    return RefreshSwitchStatusLocked(key, status);
+}
+
+template<typename T, typename E>
+bool IntellVoiceServiceManager<T, E>::RefreshSwitchStatusLocked(const std::string &key, bool &status)
+{
+    status = false;
+    int32_t index = GetSwitchKeyIndex(key);
+    if (index < 0) {
+        INTELL_VOICE_LOG_ERROR("invalid key :%{public}s", key.c_str());
+        return false;
+    }
+
+    if (switchProvider_ == nullptr) {
+        INTELL_VOICE_LOG_ERROR("switchProvider_ is nullptr");
+        return false;
+    }
+
+    status = switchProvider_->QuerySwitchStatus(key);
+    int32_t state = status ? SWITCH_STATE_ON : SWITCH_STATE_OFF;
+    int32_t oldState = switchCache_[index].exchange(state, std::memory_order_acq_rel);
+    return (oldState != SWITCH_STATE_UNKNOWN) && (oldState != state);
+}
+
+template<typename T, typename E>
+void IntellVoiceServiceManager<T, E>::OnTimerEvent(TimerEvent & /* info */)
+{
+    for (const auto &key : GetSwitchKeys()) {
+        bool status = false;
+        if (RefreshSwitchStatus(key, status)) {
+            INTELL_VOICE_LOG_WARN("missed change of %{public}s, status:%{public}d", key.c_str(), status);
+            OnSwitchChange(key);
+        }
+    }
+    switchReconcileTimer_.SetTimer(0, SWITCH_RECONCILE_INTERVAL_MS * US_PER_MS);
 }
 
 template<typename T, typename E>
@@ -149,17 +223,20 @@ void IntellVoiceServiceManager<T, E>::StopDetection(int32_t uuid)
 template<typename T, typename E>
 bool IntellVoiceServiceManager<T, E>::QuerySwitchStatus(const std::string &key)
 {
-    std::lock_guard<std::mutex> lock(switchMutex_);
-    if (!IsSwitchKeyValid(key)) {
+    int32_t index = GetSwitchKeyIndex(key);
+    if (index < 0) {
         INTELL_VOICE_LOG_ERROR("invalid key :%{public}s", key.c_str());
         return false;
     }
 
-    if (switchProvider_ == nullptr) {
-        INTELL_VOICE_LOG_ERROR("switchProvider_ is nullptr");
-        return false;
+    int32_t state = switchCache_[index].load(std::memory_order_acquire);
+    if (state != SWITCH_STATE_UNKNOWN) {
+        return state == SWITCH_STATE_ON;
     }
-    return switchProvider_->QuerySwitchStatus(key);
+
+    bool status = false;
+    RefreshSwitchStatus(key, status);
+    return status;
 }
 
 template<typename T, typename E>
@@ -275,7 +352,7 @@ int32_t IntellVoiceServiceManager<T, E>::UnloadIntellVoiceService()
         return 0;
     }
 
-    std::thread([]() {
+    auto task = []() {
         auto systemAbilityMgr = SystemAbilityManagerClient::GetInstance().GetSystemAbilityManager();
         if (systemAbilityMgr == nullptr) {
             INTELL_VOICE_LOG_ERROR("failed to get systemabilitymanager");
@@ -288,7 +365,11 @@ int32_t IntellVoiceServiceManager<T, E>::UnloadIntellVoiceService()
             return;
         }
         INTELL_VOICE_LOG_INFO("success to notify samgr to unload intell voice service");
-    }).detach();
+    };
+    if (!WorkerPool::GetInstance().Submit("IntellVoiceServiceManager::UnloadSystemAbility", task)) {
+        INTELL_VOICE_LOG_WARN("failed to submit unload system ability, run it on a detached thread");
+        std::thread(task).detach();
+    }
 
     return 0;
 }
@@ -307,7 +388,9 @@ void IntellVoiceServiceManager<T, E>::HandleUnloadIntellVoiceService(bool isAsyn
 template<typename T, typename E>
 bool IntellVoiceServiceManager<T, E>::HandleOnIdle()
 {
-    return TaskExecutor::AddSyncTask([this]() -> bool { return IsNeedToUnloadService(); });
+    // a busy ServMgrThread means the service is in use, keep it loaded instead of blocking samgr
+    return TaskExecutor::AddSyncTaskWithTimeout(ON_IDLE_TIMEOUT_MS,
+        [this]() -> bool { return IsNeedToUnloadService(); }).value_or(false);
 }
 
 template<typename T, typename E>
@@ -609,6 +692,7 @@ void IntellVoiceServiceManager<T, E>::HandleCloseWakeupSource(bool isNeedStop)
 template<typename T, typename E>
 void IntellVoiceServiceManager<T, E>::HandleServiceStop()
 {
+    startupScheduler_.Join();
     TaskExecutor::AddSyncTask([this]() -> int32_t {
         return E::ServiceStopProc();
     });
@@ -727,17 +811,34 @@ void IntellVoiceServiceManager<T, E>::OnServiceStart(std::map<int32_t, std::func
     saChangeFuncMap[DISPLAY_MANAGER_SERVICE_ID] = [this](bool isAdded) {
         T::OnDisplayManagerServiceChange(isAdded);
     };
-    T::OnServiceStart();
-    E::OnServiceStart();
+    startupScheduler_.AddStage(STAGE_TRIGGER_START, {}, [this]() { T::OnServiceStart(); }, true);
+    startupScheduler_.AddStage(STAGE_ENGINE_HOST, {}, [this]() { E::OnServiceStart(); });
+    // tasks queued on ServMgrThread touch the engine host, hold them until the host is loaded
+    TaskExecutor::AddAsyncTask([this]() { WaitEngineHostReady(); }, "IntellVoiceServiceManager::WaitEngineHost");
 }
 
 template<typename T, typename E>
 void IntellVoiceServiceManager<T, E>::OnServiceStop()
 {
+    startupScheduler_.Clear();
+    WorkerPool::GetInstance().Shutdown();
     T::OnServiceStop();
     E::OnServiceStop();
 }
 
+template<typename T, typename E>
+bool IntellVoiceServiceManager<T, E>::AddStartupStage(const std::string &name, const std::vector<std::string> &deps,
+    std::function<void()> func)
+{
+    return startupScheduler_.AddStage(name, deps, std::move(func));
+}
+
+template<typename T, typename E>
+bool IntellVoiceServiceManager<T, E>::WaitEngineHostReady()
+{
+    return startupScheduler_.WaitStage(STAGE_ENGINE_HOST, WAIT_ENGINE_HOST_TIME);
+}
+
 template<typename T, typename E>
 std::string IntellVoiceServiceManager<T, E>::TriggerGetParameter(const std::string &key)
 {
@@ -773,57 +874,75 @@ bool IntellVoiceServiceManager<T, E>::DeregisterProxyDeathRecipient(IntellVoiceE
 template<typename T, typename E>
 int32_t IntellVoiceServiceManager<T, E>::GetUploadFiles(int numMax, std::vector<UploadFilesFromHdi> &files)
 {
+    WaitEngineHostReady();
     return E::GetUploadFiles(numMax, files);
 }
 
 template<typename T, typename E>
-int32_t IntellVoiceServiceManager<T, E>::EngineSetParameter(const std::string &keyValueList)
+void IntellVoiceServiceManager<T, E>::InitParamDispatcher()
 {
-    INTELL_VOICE_LOG_INFO("enter");
-    HistoryInfoMgr &historyInfoMgr = HistoryInfoMgr::GetInstance();
-    std::map<std::string, std::string> kvpairs;
-    IntellVoiceUtil::SplitStringToKVPair(keyValueList, kvpairs);
-    for (auto it : kvpairs) {
-        if (it.first == std::string("Sensibility")) {
-            INTELL_VOICE_LOG_INFO("set Sensibility:%{public}s", it.second.c_str());
-            std::string sensibility = it.second;
-            historyInfoMgr.SetStringKVPair(KEY_SENSIBILITY, sensibility);
-            TaskExecutor::AddSyncTask([this, sensibility]() -> int32_t {
-                E::SetDspSensibility(sensibility);
-                return E::SetParameter(sensibility);
-            });
-        } else if (it.first == std::string("wakeup_bundle_name")) {
-            INTELL_VOICE_LOG_INFO("set wakeup bundle name:%{public}s", it.second.c_str());
-            historyInfoMgr.SetStringKVPair(KEY_WAKEUP_ENGINE_BUNDLE_NAME, it.second);
-        } else if (it.first == std::string("wakeup_ability_name")) {
-            INTELL_VOICE_LOG_INFO("set wakeup ability name:%{public}s", it.second.c_str());
-            historyInfoMgr.SetStringKVPair(KEY_WAKEUP_ENGINE_ABILITY_NAME, it.second);
+    paramDispatcher_.Register(PARAM_KEY_SENSIBILITY, [this](std::string_view value) {
+        std::string sensibility(value);
+        INTELL_VOICE_LOG_INFO("set Sensibility:%{public}s", sensibility.c_str());
+        HistoryInfoMgr::GetInstance().SetStringKVPair(KEY_SENSIBILITY, sensibility);
+        TaskExecutor::AddSyncTask([this, sensibility]() -> int32_t {
+            E::SetDspSensibility(sensibility);
+            return E::SetParameter(sensibility);
+        });
+    }).Register(PARAM_KEY_WAKEUP_BUNDLE_NAME, [](std::string_view value) {
+        std::string str(value);
+        INTELL_VOICE_LOG_INFO("set wakeup bundle name:%{public}s", str.c_str());
+        HistoryInfoMgr::GetInstance().SetStringKVPair(KEY_WAKEUP_ENGINE_BUNDLE_NAME, str);
+    }).Register(PARAM_KEY_WAKEUP_ABILITY_NAME, [](std::string_view value) {
+        std::string str(value);
+        INTELL_VOICE_LOG_INFO("set wakeup ability name:%{public}s", str.c_str());
+        HistoryInfoMgr::GetInstance().SetStringKVPair(KEY_WAKEUP_ENGINE_ABILITY_NAME, str);
+    });
 #ifdef ONLY_FIRST_STAGE
-        } else if (it.first == std::string("record_start")) {
+    paramDispatcher_.Register(PARAM_KEY_RECORD_START, [this](std::string_view value) {
 #ifndef FIRST_STAGE_ONESHOT_ENABLE
-            ResetSingleLevelWakeup(it.second);
+        ResetSingleLevelWakeup(std::string(value));
 #else
-            std::string keyValue = it.first;
-            keyValue.append("=").append(it.second);
-            E::SetParameter(keyValue);
+        std::string keyValue(IntellVoiceParam::KeyName(PARAM_KEY_RECORD_START));
+        keyValue.append("=").append(value);
+        E::SetParameter(keyValue);
 #endif
+    });
 #endif
-        } else {
-            INTELL_VOICE_LOG_INFO("no need to process, key:%{public}s", it.first.c_str());
-        }
-    }
+    paramDispatcher_.SetUnknownHandler([](std::string_view key, std::string_view) {
+        INTELL_VOICE_LOG_INFO("no need to process, key:%{public}s", std::string(key).c_str());
+    });
+}
+
+template<typename T, typename E>
+int32_t IntellVoiceServiceManager<T, E>::EngineSetParameter(const std::string &keyValueList)
+{
+    INTELL_VOICE_LOG_INFO("enter");
+    WaitEngineHostReady();
+    paramDispatcher_.Dispatch(keyValueList);
+    return 0;
+}
+
+template<typename T, typename E>
+int32_t IntellVoiceServiceManager<T, E>::EngineSetParameters(const ParamBatch &batch)
+{
+    INTELL_VOICE_LOG_INFO("enter, num:%{public}zu", batch.Entries().size());
+    WaitEngineHostReady();
+    paramDispatcher_.Dispatch(batch);
     return 0;
 }
 
 template<typename T, typename E>
 std::string IntellVoiceServiceManager<T, E>::EngineGetParameter(const std::string &key)
 {
+    WaitEngineHostReady();
     return E::GetParameter(key);
 }
 
 template<typename T, typename E>
 int32_t IntellVoiceServiceManager<T, E>::GetWakeupSourceFilesList(std::vector<std::string>& cloneFiles)
 {
+    WaitEngineHostReady();
     return E::GetWakeupSourceFilesList(cloneFiles);
 }
 
@@ -831,6 +950,7 @@ template<typename T, typename E>
 int32_t IntellVoiceServiceManager<T, E>::GetWakeupSourceFile(const std::string &filePath,
     std::vector<uint8_t> &buffer)
 {
+    WaitEngineHostReady();
     return E::GetWakeupSourceFile(filePath, buffer);
 }
 
@@ -838,6 +958,7 @@ template<typename T, typename E>
 int32_t IntellVoiceServiceManager<T, E>::SendWakeupFile(const std::string &filePath,
     const std::vector<uint8_t> &buffer)
 {
+    WaitEngineHostReady();
     return E::SendWakeupFile(filePath, buffer);
 }
 
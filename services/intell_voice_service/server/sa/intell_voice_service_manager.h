@@ -16,10 +16,14 @@
 #define SERVICE_MANAGER_H
 #include <mutex>
 #include <map>
+#include <array>
 #include <atomic>
 #include "switch_observer.h"
 #include "switch_provider.h"
 #include "task_executor.h"
+#include "timer_mgr.h"
+#include "startup_scheduler.h"
+#include "param_dispatcher.h"
 #include "intell_voice_definitions.h"
 #include "intell_voice_engine_registrar.h"
 #include "intell_voice_trigger_registrar.h"
@@ -30,7 +34,8 @@ namespace IntellVoiceEngine {
 
 template<typename T, typename E>
 class IntellVoiceServiceManager : private OHOS::IntellVoiceUtils::TaskExecutor, private T, private E,
-    private IntellVoiceTriggerRegistrar, private IntellVoiceEngineRegistrar {
+    private IntellVoiceTriggerRegistrar, private IntellVoiceEngineRegistrar,
+    private OHOS::IntellVoiceUtils::ITimerObserver {
 public:
     ~IntellVoiceServiceManager() override;
     static IntellVoiceServiceManager &GetInstance()
@@ -56,6 +61,7 @@ public:
     bool DeregisterProxyDeathRecipient(IntellVoiceEngineType type);
     int32_t GetUploadFiles(int numMax, std::vector<UploadFilesFromHdi> &files);
     int32_t EngineSetParameter(const std::string &keyValueList);
+    int32_t EngineSetParameters(const IntellVoiceUtils::ParamBatch &batch);
     std::string EngineGetParameter(const std::string &key);
     int32_t GetWakeupSourceFilesList(std::vector<std::string>& cloneFiles);
     int32_t GetWakeupSourceFile(const std::string &filePath, std::vector<uint8_t> &buffer);
@@ -72,6 +78,7 @@ public:
     int32_t ClearUserData();
     void OnServiceStart(std::map<int32_t, std::function<void(bool)>> &saChangeFuncMap);
     void OnServiceStop();
+    bool AddStartupStage(const std::string &name, const std::vector<std::string> &deps, std::function<void()> func);
 
     using TaskExecutor::AddAsyncTask;
     using TaskExecutor::AddSyncTask;
@@ -91,12 +98,28 @@ private:
 
 private:
     IntellVoiceServiceManager();
-    static bool IsSwitchKeyValid(const std::string &key)
+    static constexpr size_t SWITCH_KEY_NUM = 3;
+    enum SwitchCacheState : int32_t {
+        SWITCH_STATE_UNKNOWN = -1,
+        SWITCH_STATE_OFF = 0,
+        SWITCH_STATE_ON = 1,
+    };
+
+    static const std::array<std::string, SWITCH_KEY_NUM> &GetSwitchKeys()
     {
-        if ((key == WAKEUP_KEY) || (key == WHISPER_KEY) || (key == SHORTWORD_KEY)) {
-            return true;
+        static const std::array<std::string, SWITCH_KEY_NUM> keys = { WAKEUP_KEY, WHISPER_KEY, SHORTWORD_KEY };
+        return keys;
+    }
+
+    static int32_t GetSwitchKeyIndex(const std::string &key)
+    {
+        const auto &keys = GetSwitchKeys();
+        for (size_t i = 0; i < keys.size(); ++i) {
+            if (keys[i] == key) {
+                return static_cast<int32_t>(i);
+            }
         }
-        return false;
+        return -1;
     }
 
     bool QuerySwitchByUuid(int32_t uuid)
@@ -113,6 +136,10 @@ private:
     }
     void OnSwitchChange(const std::string &switchKey);
     void RegisterObserver(const std::string &switchKey);
+    bool RefreshSwitchStatus(const std::string &key, bool &status);
+    bool RefreshSwitchStatusLocked(const std::string &key, bool &status);
+    void ResetSwitchCache();
+    void OnTimerEvent(OHOS::IntellVoiceUtils::TimerEvent &info) override;
     bool IsNeedToUnloadService();
     int32_t UnloadIntellVoiceService();
     void NoiftySwitchOnToPowerChange();
@@ -132,6 +159,8 @@ private:
     void HandleRecordStartInfoChange();
     void OnTriggerConnectServiceStart() override;
     void SetShortWordStatus();
+    bool WaitEngineHostReady();
+    void InitParamDispatcher();
 
 private:
     bool notifyPowerModeChange_ = false;
@@ -141,11 +170,16 @@ private:
     std::map<const std::string, sptr<SwitchObserver>> switchObserver_;
     IntellVoiceUtils::UniqueProductType<SwitchProvider> switchProvider_ =
         IntellVoiceUtils::UniqueProductType<SwitchProvider> {nullptr, nullptr};
+    // read without switchMutex_, written from observer callbacks and the reconcile timer
+    std::array<std::atomic<int32_t>, SWITCH_KEY_NUM> switchCache_;
+    IntellVoiceUtils::TimerMgr switchReconcileTimer_;
     std::map<int32_t, bool> isStarted_;
     int32_t recordStart_ = -1;
     bool notifyRecordStartInfoChange_ = false;
     std::mutex recordStartInfoChangeMutex_;
     std::condition_variable recordStartInfoChangeCv_;
+    IntellVoiceUtils::StartupScheduler startupScheduler_;
+    IntellVoiceUtils::ParamDispatcher paramDispatcher_;
 #ifdef USE_FFRT
     std::shared_ptr<ffrt::queue> taskQueue_ = nullptr;
     std::map<int32_t, ffrt::task_handle> taskHandle_;
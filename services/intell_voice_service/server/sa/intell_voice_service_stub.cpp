@@ -42,6 +42,12 @@ IntellVoiceServiceStub::IntellVoiceServiceStub()
         MessageParcel &reply) -> int32_t { return this->SetParameterInner(data, reply); };
     processServiceFuncMap_[HDI_INTELL_VOICE_SERVICE_CLEAR_USER_DATA] = [this](MessageParcel &data,
         MessageParcel &reply) -> int32_t { return this->ClearUserDataInner(data, reply); };
+    processServiceFuncMap_[HDI_INTELL_VOICE_SERVICE_GET_CLONE_FILES_BATCH] = [this](MessageParcel &data,
+        MessageParcel &reply) -> int32_t { return this->GetCloneFilesBatchInner(data, reply); };
+    processServiceFuncMap_[HDI_INTELL_VOICE_SERVICE_SEND_CLONE_FILES_BATCH] = [this](MessageParcel &data,
+        MessageParcel &reply) -> int32_t { return this->SendCloneFilesBatchInner(data, reply); };
+    processServiceFuncMap_[HDI_INTELL_VOICE_SERVICE_SET_PARAMETERS] = [this](MessageParcel &data,
+        MessageParcel &reply) -> int32_t { return this->SetParametersInner(data, reply); };
 }
 
 IntellVoiceServiceStub::~IntellVoiceServiceStub()
@@ -101,11 +107,11 @@ int32_t IntellVoiceServiceStub::GetReportedFilesInner(MessageParcel &data, Messa
     if (size <= 0) {
         return -1;
     }
-    for (auto file : Files) {
+    for (const auto &file : Files) {
         reply.WriteInt32(file.type);
         reply.WriteString(file.filesDescription);
         reply.WriteInt32(file.filesContent.size());
-        for (auto ashmem : file.filesContent) {
+        for (const auto &ashmem : file.filesContent) {
             reply.WriteAshmem(ashmem);
         }
     }
@@ -127,6 +133,30 @@ int32_t IntellVoiceServiceStub::SetParameterInner(MessageParcel &data, MessagePa
     return ret;
 }
 
+int32_t IntellVoiceServiceStub::SetParametersInner(MessageParcel &data, MessageParcel &reply)
+{
+    uint32_t count = data.ReadUint32();
+    if (count == 0 || count > PARAM_BATCH_NUM_MAX) {
+        INTELL_VOICE_LOG_ERROR("invalid parameter num %{public}u", count);
+        return -1;
+    }
+
+    IntellVoiceUtils::ParamBatch batch;
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t key = data.ReadUint32();
+        std::string value = data.ReadString();
+        if (key >= IntellVoiceUtils::PARAM_KEY_NUM) {
+            INTELL_VOICE_LOG_ERROR("invalid parameter key %{public}u", key);
+            return -1;
+        }
+        batch.Set(static_cast<IntellVoiceUtils::ParamKey>(key), value);
+    }
+
+    int32_t ret = SetParameters(batch);
+    reply.WriteInt32(ret);
+    return ret;
+}
+
 int32_t IntellVoiceServiceStub::GetCloneFileListInner(MessageParcel &data, MessageParcel &reply)
 {
     int32_t ret = 0;
@@ -185,6 +215,66 @@ int32_t IntellVoiceServiceStub::SendCloneFileInner(MessageParcel &data, MessageP
     return ret;
 }
 
+int32_t IntellVoiceServiceStub::GetCloneFilesBatchInner(MessageParcel &data, MessageParcel &reply)
+{
+    uint32_t maxBatchSize = data.ReadUint32();
+    uint32_t count = data.ReadUint32();
+    if (count == 0 || count > CLONE_FILES_BATCH_NUM_MAX) {
+        INTELL_VOICE_LOG_ERROR("invalid file count %{public}u", count);
+        return -1;
+    }
+
+    std::vector<std::string> filePaths;
+    filePaths.reserve(count);
+    for (uint32_t i = 0; i < count; i++) {
+        filePaths.push_back(data.ReadString());
+    }
+
+    std::vector<uint32_t> fileSizes;
+    sptr<Ashmem> ashmem = nullptr;
+    int32_t ret = GetWakeupSourceFilesBatch(filePaths, maxBatchSize, fileSizes, ashmem);
+    reply.WriteInt32(ret);
+    if (ret != 0) {
+        INTELL_VOICE_LOG_ERROR("get clone files batch failed, ret:%{public}d", ret);
+        return ret;
+    }
+
+    reply.WriteUint32(fileSizes.size());
+    for (auto size : fileSizes) {
+        reply.WriteUint32(size);
+    }
+    reply.WriteAshmem(ashmem);
+    return ret;
+}
+
+int32_t IntellVoiceServiceStub::SendCloneFilesBatchInner(MessageParcel &data, MessageParcel &reply)
+{
+    uint32_t count = data.ReadUint32();
+    if (count == 0 || count > CLONE_FILES_BATCH_NUM_MAX) {
+        INTELL_VOICE_LOG_ERROR("invalid file count %{public}u", count);
+        return -1;
+    }
+
+    std::vector<std::string> filePaths;
+    std::vector<uint32_t> fileSizes;
+    filePaths.reserve(count);
+    fileSizes.reserve(count);
+    for (uint32_t i = 0; i < count; i++) {
+        filePaths.push_back(data.ReadString());
+        fileSizes.push_back(data.ReadUint32());
+    }
+
+    sptr<Ashmem> ashmem = data.ReadAshmem();
+    if (ashmem == nullptr) {
+        INTELL_VOICE_LOG_ERROR("ashmem is nullptr");
+        return -1;
+    }
+
+    int32_t ret = SendWakeupFilesBatch(filePaths, fileSizes, ashmem);
+    reply.WriteInt32(ret);
+    return ret;
+}
+
 int32_t IntellVoiceServiceStub::CloneForResultInner(MessageParcel &data, MessageParcel &reply)
 {
     int32_t ret = 0;
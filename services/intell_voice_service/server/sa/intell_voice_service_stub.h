@@ -37,11 +37,14 @@ private:
     int32_t CreateEngineInner(MessageParcel &data, MessageParcel &reply);
     int32_t ReleaseEngineInner(MessageParcel &data, MessageParcel &reply);
     int32_t SetParameterInner(MessageParcel &data, MessageParcel &reply);
+    int32_t SetParametersInner(MessageParcel &data, MessageParcel &reply);
     int32_t GetParameterInner(MessageParcel &data, MessageParcel &reply);
     int32_t GetReportedFilesInner(MessageParcel &data, MessageParcel &reply);
     int32_t GetCloneFileListInner(MessageParcel &data, MessageParcel &reply);
     int32_t GetCloneFileInner(MessageParcel &data, MessageParcel &reply);
     int32_t SendCloneFileInner(MessageParcel &data, MessageParcel &reply);
+    int32_t GetCloneFilesBatchInner(MessageParcel &data, MessageParcel &reply);
+    int32_t SendCloneFilesBatchInner(MessageParcel &data, MessageParcel &reply);
     int32_t CloneForResultInner(MessageParcel &data, MessageParcel &reply);
     int32_t ClearUserDataInner(MessageParcel &data, MessageParcel &reply);
 };
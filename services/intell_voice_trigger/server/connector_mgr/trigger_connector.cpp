@@ -244,7 +244,8 @@ void TriggerConnector::TriggerSession::HandleRecognitionHdiEvent(
 {
     std::function<void()> func = std::bind(
         &TriggerConnector::TriggerSession::ProcessRecognitionHdiEvent, this, event, modelHandle);
-    TaskExecutor::AddAsyncTask(func, "TriggerSession::HandleRecognitionHdiEvent", false);
+    TaskExecutor::AddAsyncTask(std::move(func), "TriggerSession::HandleRecognitionHdiEvent", false,
+        TaskPriority::HIGH);
 }
 
 void TriggerConnector::TriggerSession::ProcessRecognitionHdiEvent(
@@ -0,0 +1,289 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "intell_voice_log.h"
+#include "wakeup_source_process.h"
+#include "intell_voice_engine_stub.h"
+#include "intell_voice_engine_proxy.h"
+
+#define LOG_TAG "WakeupSourceProcessTest"
+
+using namespace OHOS;
+using namespace OHOS::IntellVoiceEngine;
+using namespace testing::ext;
+
+static constexpr uint32_t FRAME_SIZE = 640;  // 20ms, 16kHz, 16bit
+static constexpr uint32_t QUEUE_CAPACITY = 500;
+static constexpr uint32_t OVERFLOW_FRAME_NUM = 5;
+static constexpr uint32_t CHANNEL_CNT_4 = 4;
+static constexpr uint32_t CONCURRENT_FRAME_NUM = 400;
+static constexpr int64_t WAIT_TIME_MS = 1000;  // read timeout of WakeupSourceProcess
+static constexpr int64_t WAIT_TIME_MARGIN_MS = 300;
+
+// answers every read with the same canned frame, the rest of the interface is not used here
+class FakeEngineStub : public IntellVoiceEngineStub {
+public:
+    FakeEngineStub(const std::vector<uint8_t> &pcm, const AudioFrameInfo &info) : pcm_(pcm), info_(info) {}
+    ~FakeEngineStub() = default;
+
+    void SetCallback(sptr<IRemoteObject> /* object */) override {}
+    int32_t Attach(const IntellVoiceEngineInfo & /* info */) override
+    {
+        return 0;
+    }
+    int32_t Detach(void) override
+    {
+        return 0;
+    }
+    int32_t SetParameter(const std::string & /* keyValueList */) override
+    {
+        return 0;
+    }
+    std::string GetParameter(const std::string & /* key */) override
+    {
+        return "";
+    }
+    int32_t Start(bool /* isLast */) override
+    {
+        return 0;
+    }
+    int32_t Stop(void) override
+    {
+        return 0;
+    }
+    int32_t WriteAudio(const uint8_t * /* buffer */, uint32_t /* size */) override
+    {
+        return 0;
+    }
+    int32_t StartCapturer(int32_t /* channels */) override
+    {
+        return 0;
+    }
+    int32_t Read(std::vector<uint8_t> &data) override
+    {
+        AudioFrameInfo info;
+        return ReadFrame(data, info);
+    }
+    int32_t ReadFrame(std::vector<uint8_t> &data, AudioFrameInfo &info) override
+    {
+        data = pcm_;
+        info = info_;
+        return 0;
+    }
+    int32_t StopCapturer() override
+    {
+        return 0;
+    }
+    int32_t GetWakeupPcm(std::vector<uint8_t> & /* data */) override
+    {
+        return 0;
+    }
+    int32_t Evaluate(const std::string & /* word */, EvaluationResult & /* result */) override
+    {
+        return 0;
+    }
+    int32_t NotifyHeadsetWakeEvent() override
+    {
+        return 0;
+    }
+    int32_t NotifyHeadsetHostEvent(HeadsetHostEventType /* event */) override
+    {
+        return 0;
+    }
+
+private:
+    std::vector<uint8_t> pcm_;
+    AudioFrameInfo info_;
+};
+
+class WakeupSourceProcessTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+    void WriteFrames(uint32_t frameNum);
+    // every channel of a frame is filled with the frame index, so mixed frames are easy to spot
+    void WriteFourChannelFrame(uint8_t value);
+
+    WakeupSourceProcess process_;
+};
+
+void WakeupSourceProcessTest::SetUpTestCase(void)
+{}
+
+void WakeupSourceProcessTest::TearDownTestCase(void)
+{}
+
+void WakeupSourceProcessTest::SetUp(void)
+{}
+
+void WakeupSourceProcessTest::TearDown(void)
+{
+    process_.Release();
+}
+
+void WakeupSourceProcessTest::WriteFrames(uint32_t frameNum)
+{
+    std::vector<std::vector<uint8_t>> audioData(1, std::vector<uint8_t>(FRAME_SIZE));
+    for (uint32_t i = 0; i < frameNum; ++i) {
+        audioData[0].assign(FRAME_SIZE, static_cast<uint8_t>(i));
+        process_.Write(audioData);
+    }
+}
+
+void WakeupSourceProcessTest::WriteFourChannelFrame(uint8_t value)
+{
+    std::vector<std::vector<uint8_t>> audioData(CHANNEL_CNT_4, std::vector<uint8_t>(FRAME_SIZE, value));
+    process_.Write(audioData);
+}
+
+/**
+ * @tc.name  : Test Template WakeupSourceProcessTest
+ * @tc.number: WakeupSourceProcessTest_001
+ * @tc.desc  : Test the dropped frames and the sequence gap after the queue overflows
+ */
+HWTEST_F(WakeupSourceProcessTest, WakeupSourceProcessTest_001, TestSize.Level1)
+{
+    process_.Init(1);
+    WriteFrames(QUEUE_CAPACITY + OVERFLOW_FRAME_NUM);
+
+    std::vector<uint8_t> data;
+    AudioFrameInfo info;
+    for (uint32_t i = 0; i < QUEUE_CAPACITY; ++i) {
+        data.clear();
+        ASSERT_EQ(0, process_.Read(data, 0x1, info));
+        EXPECT_EQ(static_cast<uint64_t>(i), info.sequence);
+    }
+    EXPECT_EQ(static_cast<uint64_t>(OVERFLOW_FRAME_NUM), info.droppedFrames);
+    EXPECT_EQ(0u, info.gapCnt);
+
+    // the overflowed frames never reach the reader, the next one is reported as a single gap
+    WriteFrames(1);
+    data.clear();
+    ASSERT_EQ(0, process_.Read(data, 0x1, info));
+    EXPECT_EQ(static_cast<uint64_t>(QUEUE_CAPACITY + OVERFLOW_FRAME_NUM), info.sequence);
+    EXPECT_EQ(static_cast<uint64_t>(OVERFLOW_FRAME_NUM), info.droppedFrames);
+    EXPECT_EQ(1u, info.gapCnt);
+    EXPECT_EQ(static_cast<size_t>(FRAME_SIZE), data.size());
+}
+
+/**
+ * @tc.name  : Test Template WakeupSourceProcessTest
+ * @tc.number: WakeupSourceProcessTest_002
+ * @tc.desc  : Test the frame info trailing the pcm in the read reply
+ */
+HWTEST_F(WakeupSourceProcessTest, WakeupSourceProcessTest_002, TestSize.Level1)
+{
+    std::vector<uint8_t> pcm(FRAME_SIZE);
+    for (uint32_t i = 0; i < FRAME_SIZE; ++i) {
+        pcm[i] = static_cast<uint8_t>(i);
+    }
+    AudioFrameInfo expected;
+    expected.sequence = 0x123456789;
+    expected.captureTimeUs = 987654321;
+    expected.droppedFrames = 7;
+    expected.gapCnt = 3;
+
+    sptr<FakeEngineStub> stub = new (std::nothrow) FakeEngineStub(pcm, expected);
+    ASSERT_NE(stub, nullptr);
+    sptr<IntellVoiceEngineProxy> proxy = new (std::nothrow) IntellVoiceEngineProxy(stub->AsObject());
+    ASSERT_NE(proxy, nullptr);
+
+    std::vector<uint8_t> data;
+    AudioFrameInfo info;
+    ASSERT_EQ(0, proxy->ReadFrame(data, info));
+    EXPECT_EQ(pcm, data);
+    EXPECT_EQ(expected.sequence, info.sequence);
+    EXPECT_EQ(expected.captureTimeUs, info.captureTimeUs);
+    EXPECT_EQ(expected.droppedFrames, info.droppedFrames);
+    EXPECT_EQ(expected.gapCnt, info.gapCnt);
+}
+
+/**
+ * @tc.name  : Test Template WakeupSourceProcessTest
+ * @tc.number: WakeupSourceProcessTest_003
+ * @tc.desc  : Test that an invalid read channel does not consume a frame
+ */
+HWTEST_F(WakeupSourceProcessTest, WakeupSourceProcessTest_003, TestSize.Level1)
+{
+    process_.Init(CHANNEL_CNT_4);
+    WriteFourChannelFrame(1);
+
+    std::vector<uint8_t> data;
+    AudioFrameInfo info;
+    EXPECT_EQ(-1, process_.Read(data, 0, info));
+    EXPECT_EQ(-1, process_.Read(data, 0x10, info));
+    EXPECT_TRUE(data.empty());
+
+    ASSERT_EQ(0, process_.Read(data, 0xF, info));
+    EXPECT_EQ(0u, info.sequence);
+    EXPECT_EQ(static_cast<size_t>(FRAME_SIZE * CHANNEL_CNT_4), data.size());
+}
+
+/**
+ * @tc.name  : Test Template WakeupSourceProcessTest
+ * @tc.number: WakeupSourceProcessTest_004
+ * @tc.desc  : Test that a partial channel read under a concurrent writer never mixes frames
+ */
+HWTEST_F(WakeupSourceProcessTest, WakeupSourceProcessTest_004, TestSize.Level1)
+{
+    process_.Init(CHANNEL_CNT_4);
+    std::thread writer([this]() {
+        for (uint32_t i = 0; i < CONCURRENT_FRAME_NUM; ++i) {
+            WriteFourChannelFrame(static_cast<uint8_t>(i));
+            if ((i % 10) == 0) {
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+            }
+        }
+    });
+
+    std::vector<uint8_t> data;
+    AudioFrameInfo info;
+    for (uint32_t i = 0; i < CONCURRENT_FRAME_NUM; ++i) {
+        data.clear();
+        ASSERT_EQ(0, process_.Read(data, 0b1010, info));
+        ASSERT_EQ(static_cast<size_t>(FRAME_SIZE * 2), data.size());
+        EXPECT_EQ(static_cast<uint64_t>(i), info.sequence);
+        for (auto value : data) {
+            ASSERT_EQ(static_cast<uint8_t>(i), value);
+        }
+    }
+    writer.join();
+    EXPECT_EQ(0u, info.gapCnt);
+}
+
+/**
+ * @tc.name  : Test Template WakeupSourceProcessTest
+ * @tc.number: WakeupSourceProcessTest_005
+ * @tc.desc  : Test that an empty four channel read gives up after a single wait
+ */
+HWTEST_F(WakeupSourceProcessTest, WakeupSourceProcessTest_005, TestSize.Level1)
+{
+    process_.Init(CHANNEL_CNT_4);
+
+    std::vector<uint8_t> data;
+    AudioFrameInfo info;
+    auto begin = std::chrono::steady_clock::now();
+    EXPECT_EQ(-1, process_.Read(data, 0xF, info));
+    auto costMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - begin);
+    EXPECT_LT(costMs.count(), WAIT_TIME_MS + WAIT_TIME_MARGIN_MS);
+    EXPECT_TRUE(data.empty());
+}
@@ -0,0 +1,401 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "audio_codec.h"
+
+#include <algorithm>
+#include "intell_voice_log.h"
+
+#define LOG_TAG "AudioCodec"
+
+namespace OHOS {
+namespace IntellVoiceUtils {
+static constexpr uint32_t HEADER_SIZE = 4;  // sample count, little endian
+static constexpr uint32_t MAX_SAMPLE_CNT = 1 << 20;
+static constexpr uint32_t BITS_PER_BYTE = 8;
+
+static constexpr uint32_t RICE_BLOCK_SIZE = 256;
+static constexpr uint32_t RICE_PARAM_BITS = 5;
+static constexpr uint32_t RICE_MAX_PARAM = 20;
+// a quotient this long is replaced by the raw value, order 2 residuals of 16-bit pcm fit in 18 bits zigzagged
+static constexpr uint32_t RICE_ESCAPE = 16;
+static constexpr uint32_t RICE_RAW_BITS = 18;
+
+static constexpr uint32_t ADPCM_BLOCK_SIZE = 256;
+static constexpr uint32_t ADPCM_HEADER_SIZE = 4;  // predictor, step index, reserved
+static constexpr int32_t ADPCM_MAX_INDEX = 88;
+static constexpr int32_t ADPCM_STEP_TABLE[ADPCM_MAX_INDEX + 1] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97,
+    107, 118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796,
+    876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871,
+    5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623,
+    27086, 29794, 32767
+};
+static constexpr int32_t ADPCM_INDEX_TABLE[16] = { -1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8 };
+
+static inline uint64_t LowMask(uint32_t bits)
+{
+    return (static_cast<uint64_t>(1) << bits) - 1;
+}
+
+static inline uint32_t ZigZag(int32_t value)
+{
+    return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+}
+
+static inline int32_t UnZigZag(uint32_t value)
+{
+    return static_cast<int32_t>(value >> 1) ^ -static_cast<int32_t>(value & 1);
+}
+
+class BitWriter {
+public:
+    explicit BitWriter(std::vector<uint8_t> &out) : out_(out) {}
+    void Put(uint32_t value, uint32_t bits)
+    {
+        acc_ = (acc_ << bits) | (value & LowMask(bits));
+        accBits_ += bits;
+        while (accBits_ >= BITS_PER_BYTE) {
+            accBits_ -= BITS_PER_BYTE;
+            out_.push_back(static_cast<uint8_t>(acc_ >> accBits_));
+        }
+        acc_ &= LowMask(accBits_);
+    }
+    void Flush()
+    {
+        if (accBits_ != 0) {
+            out_.push_back(static_cast<uint8_t>(acc_ << (BITS_PER_BYTE - accBits_)));
+        }
+        acc_ = 0;
+        accBits_ = 0;
+    }
+
+private:
+    std::vector<uint8_t> &out_;
+    uint64_t acc_ = 0;
+    uint32_t accBits_ = 0;
+};
+
+class BitReader {
+public:
+    BitReader(const uint8_t *data, size_t size) : data_(data), size_(size) {}
+    bool Get(uint32_t bits, uint32_t &value)
+    {
+        if ((accBits_ < bits) && (!Refill() || (accBits_ < bits))) {
+            return false;
+        }
+        accBits_ -= bits;
+        value = static_cast<uint32_t>((acc_ >> accBits_) & LowMask(bits));
+        acc_ &= LowMask(accBits_);
+        return true;
+    }
+    // counts ones up to the terminating zero, stops without one at limit
+    bool GetUnary(uint32_t limit, uint32_t &count)
+    {
+        count = 0;
+        while (count < limit) {
+            if ((accBits_ == 0) && !Refill()) {
+                return false;
+            }
+            // the highest set bit of the inverted window is the first zero in the stream
+            uint64_t zeros = ~acc_ & LowMask(accBits_);
+            uint32_t run = (zeros == 0) ? accBits_ : (accBits_ - 1 - (63 - __builtin_clzll(zeros)));
+            if (count + run >= limit) {
+                accBits_ -= limit - count;
+                acc_ &= LowMask(accBits_);
+                count = limit;
+                return true;
+            }
+            count += run;
+            if (zeros != 0) {
+                accBits_ -= run + 1;
+                acc_ &= LowMask(accBits_);
+                return true;
+            }
+            accBits_ = 0;
+            acc_ = 0;
+        }
+        return true;
+    }
+
+private:
+    bool Refill()
+    {
+        while ((accBits_ + BITS_PER_BYTE < MAX_ACC_BITS) && (pos_ < size_)) {
+            acc_ = (acc_ << BITS_PER_BYTE) | data_[pos_++];
+            accBits_ += BITS_PER_BYTE;
+        }
+        return accBits_ != 0;
+    }
+
+    static constexpr uint32_t MAX_ACC_BITS = 64;
+    const uint8_t *data_ = nullptr;
+    size_t size_ = 0;
+    size_t pos_ = 0;
+    uint64_t acc_ = 0;
+    uint32_t accBits_ = 0;
+};
+
+bool AudioCodec::IsSupported(int32_t codec)
+{
+    return (codec >= AUDIO_CODEC_PCM) && (codec < AUDIO_CODEC_BUT);
+}
+
+bool AudioCodec::Encode(int32_t codec, const std::vector<uint8_t> &pcm, std::vector<uint8_t> &out)
+{
+    if (!IsSupported(codec) || ((pcm.size() % sizeof(int16_t)) != 0) ||
+        (pcm.size() / sizeof(int16_t) > MAX_SAMPLE_CNT)) {
+        INTELL_VOICE_LOG_ERROR("invalid codec:%{public}d or pcm size:%{public}zu", codec, pcm.size());
+        return false;
+    }
+
+    if (codec == AUDIO_CODEC_PCM) {
+        out = pcm;
+        return true;
+    }
+
+    uint32_t count = static_cast<uint32_t>(pcm.size() / sizeof(int16_t));
+    out.clear();
+    out.reserve(HEADER_SIZE + pcm.size());
+    for (uint32_t i = 0; i < HEADER_SIZE; ++i) {
+        out.push_back(static_cast<uint8_t>(count >> (i * BITS_PER_BYTE)));
+    }
+
+    const int16_t *samples = reinterpret_cast<const int16_t *>(pcm.data());
+    if (codec == AUDIO_CODEC_RICE) {
+        RiceEncode(samples, count, out);
+    } else {
+        AdpcmEncode(samples, count, out);
+    }
+    return true;
+}
+
+bool AudioCodec::Decode(int32_t codec, const uint8_t *data, size_t size, std::vector<uint8_t> &pcm)
+{
+    if (!IsSupported(codec) || (data == nullptr)) {
+        INTELL_VOICE_LOG_ERROR("invalid codec:%{public}d", codec);
+        return false;
+    }
+
+    if (codec == AUDIO_CODEC_PCM) {
+        pcm.assign(data, data + size);
+        return true;
+    }
+
+    if (size < HEADER_SIZE) {
+        INTELL_VOICE_LOG_ERROR("stream is too short:%{public}zu", size);
+        return false;
+    }
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < HEADER_SIZE; ++i) {
+        count |= static_cast<uint32_t>(data[i]) << (i * BITS_PER_BYTE);
+    }
+    if (count > MAX_SAMPLE_CNT) {
+        INTELL_VOICE_LOG_ERROR("invalid sample count:%{public}u", count);
+        return false;
+    }
+
+    pcm.resize(count * sizeof(int16_t));
+    int16_t *samples = reinterpret_cast<int16_t *>(pcm.data());
+    bool ret = (codec == AUDIO_CODEC_RICE) ? RiceDecode(data + HEADER_SIZE, size - HEADER_SIZE, count, samples) :
+        AdpcmDecode(data + HEADER_SIZE, size - HEADER_SIZE, count, samples);
+    if (!ret) {
+        INTELL_VOICE_LOG_ERROR("corrupted stream, codec:%{public}d", codec);
+        pcm.clear();
+    }
+    return ret;
+}
+
+void AudioCodec::RiceEncode(const int16_t *samples, uint32_t count, std::vector<uint8_t> &out)
+{
+    BitWriter writer(out);
+    uint32_t residual[RICE_BLOCK_SIZE];
+    for (uint32_t begin = 0; begin < count; begin += RICE_BLOCK_SIZE) {
+        uint32_t num = std::min(RICE_BLOCK_SIZE, count - begin);
+        uint32_t end = begin + num;
+
+        // the predictor order ramps up over the first two samples of the stream
+        uint32_t j = begin;
+        if (begin == 0) {
+            residual[0] = ZigZag(samples[0]);
+            if (num > 1) {
+                residual[1] = ZigZag(static_cast<int32_t>(samples[1]) - samples[0]);
+            }
+            j = std::min(num, 2U);
+        }
+        // no branch and no carried state, the compiler vectorizes this loop
+        for (; j < end; ++j) {
+            int32_t predict = 2 * static_cast<int32_t>(samples[j - 1]) - samples[j - 2];
+            residual[j - begin] = ZigZag(samples[j] - predict);
+        }
+
+        uint64_t sum = 0;
+        uint32_t i = 0;
+        for (; i < num; ++i) {
+            sum += residual[i];
+        }
+        uint32_t param = 0;
+        while ((param < RICE_MAX_PARAM) && ((static_cast<uint64_t>(num) << (param + 1)) <= sum)) {
+            param++;
+        }
+
+        writer.Put(param, RICE_PARAM_BITS);
+        for (i = 0; i < num; ++i) {
+            uint32_t quotient = residual[i] >> param;
+            if (quotient >= RICE_ESCAPE) {
+                writer.Put(static_cast<uint32_t>(LowMask(RICE_ESCAPE)), RICE_ESCAPE);
+                writer.Put(residual[i], RICE_RAW_BITS);
+                continue;
+            }
+            writer.Put(static_cast<uint32_t>(LowMask(quotient) << 1), quotient + 1);
+            if (param != 0) {
+                writer.Put(residual[i], param);
+            }
+        }
+    }
+    writer.Flush();
+}
+
+bool AudioCodec::RiceDecode(const uint8_t *data, size_t size, uint32_t count, int16_t *samples)
+{
+    BitReader reader(data, size);
+    for (uint32_t begin = 0; begin < count; begin += RICE_BLOCK_SIZE) {
+        uint32_t num = std::min(RICE_BLOCK_SIZE, count - begin);
+        uint32_t param = 0;
+        if (!reader.Get(RICE_PARAM_BITS, param) || (param > RICE_MAX_PARAM)) {
+            return false;
+        }
+
+        for (uint32_t i = begin; i < begin + num; ++i) {
+            uint32_t quotient = 0;
+            uint32_t value = 0;
+            if (!reader.GetUnary(RICE_ESCAPE, quotient)) {
+                return false;
+            }
+            if (quotient == RICE_ESCAPE) {
+                if (!reader.Get(RICE_RAW_BITS, value)) {
+                    return false;
+                }
+            } else {
+                uint32_t remainder = 0;
+                if ((param != 0) && !reader.Get(param, remainder)) {
+                    return false;
+                }
+                value = (quotient << param) | remainder;
+            }
+
+            int32_t predict = 0;
+            if (i == 1) {
+                predict = samples[0];
+            } else if (i > 1) {
+                predict = 2 * static_cast<int32_t>(samples[i - 1]) - samples[i - 2];
+            }
+            int32_t sample = UnZigZag(value) + predict;
+            if ((sample < INT16_MIN) || (sample > INT16_MAX)) {
+                return false;
+            }
+            samples[i] = static_cast<int16_t>(sample);
+        }
+    }
+    return true;
+}
+
+void AudioCodec::AdpcmEncode(const int16_t *samples, uint32_t count, std::vector<uint8_t> &out)
+{
+    int32_t index = 0;
+    for (uint32_t begin = 0; begin < count; begin += ADPCM_BLOCK_SIZE) {
+        uint32_t num = std::min(ADPCM_BLOCK_SIZE, count - begin);
+        int32_t predict = samples[begin];
+        uint16_t header = static_cast<uint16_t>(samples[begin]);
+        out.push_back(static_cast<uint8_t>(header));
+        out.push_back(static_cast<uint8_t>(header >> BITS_PER_BYTE));
+        out.push_back(static_cast<uint8_t>(index));
+        out.push_back(0);
+
+        uint8_t packed = 0;
+        for (uint32_t i = 0; i < num; ++i) {
+            int32_t diff = samples[begin + i] - predict;
+            int32_t step = ADPCM_STEP_TABLE[index];
+            uint8_t code = 0;
+            if (diff < 0) {
+                code = 0x8;
+                diff = -diff;
+            }
+            int32_t delta = step >> 3;
+            for (uint8_t bit = 0x4; bit != 0; bit >>= 1) {
+                if (diff >= step) {
+                    code |= bit;
+                    diff -= step;
+                    delta += step;
+                }
+                step >>= 1;
+            }
+            predict += (code & 0x8) ? -delta : delta;
+            predict = std::clamp<int32_t>(predict, INT16_MIN, INT16_MAX);
+            index = std::clamp<int32_t>(index + ADPCM_INDEX_TABLE[code], 0, ADPCM_MAX_INDEX);
+
+            // low nibble first
+            if ((i & 1) == 0) {
+                packed = code;
+            } else {
+                out.push_back(static_cast<uint8_t>(packed | (code << 4)));
+            }
+        }
+        if ((num & 1) != 0) {
+            out.push_back(packed);
+        }
+    }
+}
+
+bool AudioCodec::AdpcmDecode(const uint8_t *data, size_t size, uint32_t count, int16_t *samples)
+{
+    size_t pos = 0;
+    for (uint32_t begin = 0; begin < count; begin += ADPCM_BLOCK_SIZE) {
+        uint32_t num = std::min(ADPCM_BLOCK_SIZE, count - begin);
+        if (size - pos < ADPCM_HEADER_SIZE + (num + 1) / 2) {
+            return false;
+        }
+        int32_t predict = static_cast<int16_t>(data[pos] | (data[pos + 1] << BITS_PER_BYTE));
+        int32_t index = data[pos + 2];
+        if (index > ADPCM_MAX_INDEX) {
+            return false;
+        }
+        pos += ADPCM_HEADER_SIZE;
+
+        for (uint32_t i = 0; i < num; ++i) {
+            uint8_t code = ((i & 1) == 0) ? (data[pos] & 0xf) : (data[pos++] >> 4);
+            int32_t step = ADPCM_STEP_TABLE[index];
+            int32_t delta = step >> 3;
+            if (code & 0x4) {
+                delta += step;
+            }
+            if (code & 0x2) {
+                delta += step >> 1;
+            }
+            if (code & 0x1) {
+                delta += step >> 2;
+            }
+            predict += (code & 0x8) ? -delta : delta;
+            predict = std::clamp<int32_t>(predict, INT16_MIN, INT16_MAX);
+            index = std::clamp<int32_t>(index + ADPCM_INDEX_TABLE[code], 0, ADPCM_MAX_INDEX);
+            samples[begin + i] = static_cast<int16_t>(predict);
+        }
+        if ((num & 1) != 0) {
+            pos++;
+        }
+    }
+    return true;
+}
+}
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef INTELL_VOICE_AUDIO_CODEC_H
+#define INTELL_VOICE_AUDIO_CODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace OHOS {
+namespace IntellVoiceUtils {
+enum AudioCodecType : int32_t {
+    AUDIO_CODEC_PCM = 0,
+    // lossless: fixed second order predictor, residuals Rice coded per block
+    AUDIO_CODEC_RICE = 1,
+    // lossy 4:1: IMA-ADPCM, one header per block
+    AUDIO_CODEC_ADPCM = 2,
+    AUDIO_CODEC_BUT,
+};
+
+/*
+ * Codecs for 16-bit pcm frames sent over ipc. The encoded stream starts with the sample count, so
+ * a decoder needs nothing but the codec type.
+ */
+class AudioCodec {
+public:
+    static bool IsSupported(int32_t codec);
+    // pcm holds 16-bit little endian samples, out is replaced
+    static bool Encode(int32_t codec, const std::vector<uint8_t> &pcm, std::vector<uint8_t> &out);
+    static bool Decode(int32_t codec, const uint8_t *data, size_t size, std::vector<uint8_t> &pcm);
+
+private:
+    static void RiceEncode(const int16_t *samples, uint32_t count, std::vector<uint8_t> &out);
+    static bool RiceDecode(const uint8_t *data, size_t size, uint32_t count, int16_t *samples);
+    static void AdpcmEncode(const int16_t *samples, uint32_t count, std::vector<uint8_t> &out);
+    static bool AdpcmDecode(const uint8_t *data, size_t size, uint32_t count, int16_t *samples);
+};
+}
+}
+#endif
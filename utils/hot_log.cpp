@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "hot_log.h"
+
+#include <string>
+#include <sstream>
+
+#define LOG_TAG "HotLog"
+
+namespace OHOS {
+namespace IntellVoiceUtils {
+static_assert((HotLogRing::RING_SIZE & (HotLogRing::RING_SIZE - 1)) == 0, "ring size must be power of 2");
+
+HotLogRing &HotLogRing::GetInstance()
+{
+    static HotLogRing instance;
+    return instance;
+}
+
+void HotLogRing::Record(const char *event, std::initializer_list<int64_t> args)
+{
+    uint64_t index = head_.fetch_add(1, std::memory_order_relaxed);
+    Slot &slot = slots_[index & (RING_SIZE - 1)];
+    // odd sequence marks the slot as being written
+    slot.seq.store(index * 2 + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.entry.timeUs = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    slot.entry.event = event;
+    slot.entry.argNum = 0;
+    for (auto arg : args) {
+        if (slot.entry.argNum >= MAX_ARG_NUM) {
+            break;
+        }
+        slot.entry.args[slot.entry.argNum++] = arg;
+    }
+
+    slot.seq.store(index * 2 + 2, std::memory_order_release);
+}
+
+std::string HotLogRing::Dump()
+{
+    uint64_t head = head_.load(std::memory_order_acquire);
+    uint64_t begin = (head > RING_SIZE) ? (head - RING_SIZE) : 0;
+    std::ostringstream oss;
+    uint32_t dropped = 0;
+
+    for (uint64_t index = begin; index < head; ++index) {
+        Slot &slot = slots_[index & (RING_SIZE - 1)];
+        uint64_t seq = slot.seq.load(std::memory_order_acquire);
+        HotLogEntry entry = slot.entry;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        // skip slots being written or already reused by a newer record
+        if ((seq != index * 2 + 2) || (slot.seq.load(std::memory_order_relaxed) != seq) ||
+            (entry.event == nullptr)) {
+            ++dropped;
+            continue;
+        }
+
+        oss << entry.timeUs << " " << entry.event;
+        for (uint32_t i = 0; i < entry.argNum && i < MAX_ARG_NUM; ++i) {
+            oss << (i == 0 ? ": " : ", ") << entry.args[i];
+        }
+        oss << "\n";
+    }
+
+    oss << "total:" << head << ", skipped:" << dropped << "\n";
+    return oss.str();
+}
+}
+}
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HOT_LOG_H
+#define HOT_LOG_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include "intell_voice_log.h"
+
+#define INTELL_VOICE_HOT_LOG_LEVEL_DEBUG 0
+#define INTELL_VOICE_HOT_LOG_LEVEL_INFO 1
+#define INTELL_VOICE_HOT_LOG_LEVEL_NONE 2
+
+#ifndef INTELL_VOICE_HOT_LOG_LEVEL
+#ifdef INTELL_VOICE_BUILD_VARIANT_ROOT
+#define INTELL_VOICE_HOT_LOG_LEVEL INTELL_VOICE_HOT_LOG_LEVEL_DEBUG
+#else
+#define INTELL_VOICE_HOT_LOG_LEVEL INTELL_VOICE_HOT_LOG_LEVEL_INFO
+#endif
+#endif
+
+// logs on per frame or per call paths, filtered at compile time so the arguments are not evaluated
+#if INTELL_VOICE_HOT_LOG_LEVEL <= INTELL_VOICE_HOT_LOG_LEVEL_DEBUG
+#define INTELL_VOICE_HOT_LOG_DEBUG(fmt, ...) INTELL_VOICE_LOG_DEBUG(fmt, ##__VA_ARGS__)
+#else
+#define INTELL_VOICE_HOT_LOG_DEBUG(fmt, ...) do {} while (0)
+#endif
+
+#if INTELL_VOICE_HOT_LOG_LEVEL <= INTELL_VOICE_HOT_LOG_LEVEL_INFO
+#define INTELL_VOICE_HOT_LOG_INFO(fmt, ...) INTELL_VOICE_LOG_INFO(fmt, ##__VA_ARGS__)
+#else
+#define INTELL_VOICE_HOT_LOG_INFO(fmt, ...) do {} while (0)
+#endif
+
+// at most one log per interval for each call site, the number of dropped logs is appended
+#define INTELL_VOICE_LOG_LIMIT(level, intervalMs, fmt, ...)                                        \
+    do {                                                                                           \
+        static OHOS::IntellVoiceUtils::LogRateLimiter hotLogLimiter(intervalMs);                   \
+        uint32_t hotLogSuppressed = 0;                                                             \
+        if (hotLogLimiter.Allow(hotLogSuppressed)) {                                               \
+            INTELL_VOICE_LOG_##level(fmt " (suppressed %{public}u)", ##__VA_ARGS__, hotLogSuppressed); \
+        }                                                                                          \
+    } while (0)
+
+#define INTELL_VOICE_LOG_INFO_LIMIT(intervalMs, fmt, ...) INTELL_VOICE_LOG_LIMIT(INFO, intervalMs, fmt, ##__VA_ARGS__)
+#define INTELL_VOICE_LOG_WARN_LIMIT(intervalMs, fmt, ...) INTELL_VOICE_LOG_LIMIT(WARN, intervalMs, fmt, ##__VA_ARGS__)
+#define INTELL_VOICE_LOG_ERROR_LIMIT(intervalMs, fmt, ...) \
+    INTELL_VOICE_LOG_LIMIT(ERROR, intervalMs, fmt, ##__VA_ARGS__)
+
+// stores the event in the in-memory ring, it is formatted only when the ring is dumped
+#define INTELL_VOICE_HOT_RECORD(event, ...) \
+    OHOS::IntellVoiceUtils::HotLogRing::GetInstance().Record(event, { __VA_ARGS__ })
+
+namespace OHOS {
+namespace IntellVoiceUtils {
+class LogRateLimiter {
+public:
+    explicit LogRateLimiter(uint32_t intervalMs) : intervalMs_(intervalMs) {}
+    ~LogRateLimiter() = default;
+
+    bool Allow(uint32_t &suppressed)
+    {
+        int64_t nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        int64_t nextMs = nextMs_.load(std::memory_order_relaxed);
+        if ((nowMs < nextMs) ||
+            !nextMs_.compare_exchange_strong(nextMs, nowMs + intervalMs_, std::memory_order_relaxed)) {
+            suppressed_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        suppressed = suppressed_.exchange(0, std::memory_order_relaxed);
+        return true;
+    }
+
+private:
+    uint32_t intervalMs_ = 0;
+    std::atomic<int64_t> nextMs_ { 0 };
+    std::atomic<uint32_t> suppressed_ { 0 };
+};
+
+struct HotLogEntry {
+    int64_t timeUs = 0;
+    const char *event = nullptr;
+    uint32_t argNum = 0;
+    int64_t args[4] = { 0 };
+};
+
+/*
+ * Fixed size lock-free ring of hot path events. Writers claim a slot with one atomic increment and
+ * publish it with a per-slot sequence, so recording never blocks and never formats. The event name
+ * must be a string literal. Dump() formats the entries that are still complete, oldest first.
+ */
+class HotLogRing {
+public:
+    static constexpr uint32_t RING_SIZE = 1024;
+    static constexpr uint32_t MAX_ARG_NUM = 4;
+
+    static HotLogRing &GetInstance();
+    void Record(const char *event, std::initializer_list<int64_t> args);
+    std::string Dump();
+
+private:
+    HotLogRing() = default;
+    ~HotLogRing() = default;
+
+    struct Slot {
+        std::atomic<uint64_t> seq { 0 };
+        HotLogEntry entry;
+    };
+
+    std::atomic<uint64_t> head_ { 0 };
+    Slot slots_[RING_SIZE];
+};
+}
+}
+#endif
@@ -15,6 +15,9 @@
 #include "huks_aes_adapter.h"
 
 #include <string>
+#include <mutex>
+#include <vector>
+#include <algorithm>
 #include "hks_api.h"
 #include "securec.h"
 #include "intell_voice_log.h"
@@ -31,9 +34,16 @@ static char g_aadValue[] = "IntelligentVoiceAAD";
 
 static constexpr uint32_t MAX_UPDATE_SIZE = 64 * 1024;
 static constexpr uint32_t MAX_OUTDATA_SIZE = 128 * 1024;
+static constexpr uint32_t NONCE_SIZE = HuksAesAdapter::NONCE_SIZE;
+static constexpr uint32_t AEAD_SIZE = HuksAesAdapter::AEAD_SIZE;
 
-static constexpr uint32_t NONCE_SIZE = 12;
-static constexpr uint32_t AEAD_SIZE = 16;
+// the key state and the fixed param sets are kept for the process lifetime
+static std::mutex g_keyMutex;
+static bool g_isKeyReady = false;
+static struct HksParamSet *g_existParamSet = nullptr;
+static struct HksParamSet *g_genParamSet = nullptr;
+// tail of a segmented operation when the caller buffer has no room for the tag
+static thread_local std::vector<uint8_t> g_finishBuffer;
 
 static struct HksParam g_existParams[] = {
     {
@@ -173,18 +183,51 @@ int32_t HuksAesAdapter::Encrypt(std::unique_ptr<Uint8ArrayBuffer> &inBuffer,
 {
     CHECK_CONDITION_RETURN_RET(((inBuffer == nullptr) || (inBuffer->GetSize() == 0)), HKS_ERROR_INVALID_ARGUMENT,
         "invalid arguments");
-    struct HksBlob keyAlias = { static_cast<uint32_t>(strlen(g_aliasName)), reinterpret_cast<uint8_t *>(g_aliasName) };
-    bool isExist = false;
-    int32_t ret = IsKeyExist(&keyAlias, isExist);
-    CHECK_CONDITION_RETURN_RET((ret != HKS_SUCCESS), ret, "key exist failed");
-    if (!isExist) {
-        ret = GenerateKey(&keyAlias);
-        CHECK_CONDITION_RETURN_RET((ret != HKS_SUCCESS), ret, "generate key failed");
+    auto encryptData = CreateArrayBuffer<uint8_t>(GetEncryptSize(inBuffer->GetSize()));
+    CHECK_CONDITION_RETURN_RET((encryptData == nullptr), HKS_ERROR_MALLOC_FAIL, "encryptData is nullptr");
+
+    struct HksBlob inData = { inBuffer->GetSize(), inBuffer->GetData() };
+    struct HksBlob outData = { encryptData->GetSize(), encryptData->GetData() };
+    int32_t ret = Encrypt(&inData, &outData);
+    CHECK_CONDITION_RETURN_RET((ret != HKS_SUCCESS), ret, "encrypt failed");
+    CHECK_CONDITION_RETURN_RET((outData.size != encryptData->GetSize()), HKS_FAILURE, "invalid encrypt size");
+
+    outBuffer = std::move(encryptData);
+    return HKS_SUCCESS;
+}
+
+int32_t HuksAesAdapter::Decrypt(std::unique_ptr<Uint8ArrayBuffer> &inBuffer,
+    std::unique_ptr<Uint8ArrayBuffer> &outBuffer)
+{
+    if ((inBuffer == nullptr) || (inBuffer->GetSize() <= (NONCE_SIZE + AEAD_SIZE))) {
+        return HKS_ERROR_INVALID_ARGUMENT;
     }
 
+    auto decryptData = CreateArrayBuffer<uint8_t>(GetDecryptSize(inBuffer->GetSize()));
+    CHECK_CONDITION_RETURN_RET((decryptData == nullptr), HKS_ERROR_MALLOC_FAIL, "decryptData is nullptr");
+
+    struct HksBlob inData = { inBuffer->GetSize(), inBuffer->GetData() };
+    struct HksBlob outData = { decryptData->GetSize(), decryptData->GetData() };
+    int32_t ret = Decrypt(&inData, &outData);
+    CHECK_CONDITION_RETURN_RET((ret != HKS_SUCCESS), ret, "decrypt failed");
+    CHECK_CONDITION_RETURN_RET((outData.size != decryptData->GetSize()), HKS_FAILURE, "invalid decrypt size");
+
+    outBuffer = std::move(decryptData);
+    return HKS_SUCCESS;
+}
+
+int32_t HuksAesAdapter::Encrypt(const struct HksBlob *inData, struct HksBlob *outData)
+{
+    CHECK_CONDITION_RETURN_RET(((inData == nullptr) || (inData->data == nullptr) || (inData->size == 0) ||
+        (outData == nullptr) || (outData->data == nullptr) || (outData->size < GetEncryptSize(inData->size))),
+        HKS_ERROR_INVALID_ARGUMENT, "invalid arguments");
+    struct HksBlob keyAlias = { static_cast<uint32_t>(strlen(g_aliasName)), reinterpret_cast<uint8_t *>(g_aliasName) };
+    int32_t ret = PrepareKey(&keyAlias, true);
+    CHECK_CONDITION_RETURN_RET((ret != HKS_SUCCESS), ret, "prepare key failed");
+
+    // the nonce is generated into the head of the output directly
     struct HksParamSet *encryptParamSet = nullptr;
-    uint8_t nonceValue[NONCE_SIZE] = { 0 };
-    struct HksBlob encryptNonce = { NONCE_SIZE, nonceValue};
+    struct HksBlob encryptNonce = { NONCE_SIZE, outData->data };
     ret = CreateEncryptParamSet(&encryptParamSet, &encryptNonce);
     CHECK_CONDITION_RETURN_RET((ret != HKS_SUCCESS), ret, "create encrypt param set failed");
 
@@ -197,43 +240,31 @@ int32_t HuksAesAdapter::Encrypt(std::unique_ptr<Uint8ArrayBuffer> &inBuffer,
     ret = HksInit(&keyAlias, encryptParamSet, &handleEncrypt, nullptr);
     if (ret != HKS_SUCCESS) {
         INTELL_VOICE_LOG_ERROR("huks init failed, ret:%{public}d", ret);
+        InvalidateKey();
         return ret;
     }
 
-    struct HksBlob inData = { inBuffer->GetSize() * sizeof(uint8_t), inBuffer->GetData() };
-    auto encryptData = std::make_unique<uint8_t[]>(inBuffer->GetSize() * sizeof(uint8_t) + NONCE_SIZE + AEAD_SIZE);
-    CHECK_CONDITION_RETURN_RET((encryptData == nullptr), HKS_ERROR_MALLOC_FAIL, "encryptData is nullptr");
-
-    struct HksBlob outData = { inBuffer->GetSize() * sizeof(uint8_t) + AEAD_SIZE, encryptData.get() + NONCE_SIZE };
-
-    ret = UpdateAndFinish(&handleEncrypt, encryptParamSet, &inData, &outData);
+    struct HksBlob cipherData = { outData->size - NONCE_SIZE, outData->data + NONCE_SIZE };
+    ret = UpdateAndFinish(&handleEncrypt, encryptParamSet, inData, &cipherData);
     CHECK_CONDITION_RETURN_RET((ret != HKS_SUCCESS), ret, "update and finish failed");
 
-    (void)memcpy_s(encryptData.get(), NONCE_SIZE, encryptNonce.data, encryptNonce.size);
-    outBuffer = CreateArrayBuffer<uint8_t>(outData.size + NONCE_SIZE, encryptData.get());
-    if (outBuffer == nullptr) {
-        INTELL_VOICE_LOG_ERROR("allocate out buffer failed, size:%{public}u", outData.size);
-        return HKS_ERROR_MALLOC_FAIL;
-    }
+    outData->size = cipherData.size + NONCE_SIZE;
     return HKS_SUCCESS;
 }
 
-int32_t HuksAesAdapter::Decrypt(std::unique_ptr<Uint8ArrayBuffer> &inBuffer,
-    std::unique_ptr<Uint8ArrayBuffer> &outBuffer)
+int32_t HuksAesAdapter::Decrypt(const struct HksBlob *inData, struct HksBlob *outData)
 {
-    if ((inBuffer == nullptr) || (inBuffer->GetSize() <= (NONCE_SIZE + AEAD_SIZE))) {
-        return HKS_ERROR_INVALID_ARGUMENT;
-    }
+    CHECK_CONDITION_RETURN_RET(((inData == nullptr) || (inData->data == nullptr) ||
+        (inData->size <= (NONCE_SIZE + AEAD_SIZE)) || (outData == nullptr) || (outData->data == nullptr) ||
+        (outData->size < GetDecryptSize(inData->size))), HKS_ERROR_INVALID_ARGUMENT, "invalid arguments");
 
     struct HksBlob keyAlias = { static_cast<uint32_t>(strlen(g_aliasName)), reinterpret_cast<uint8_t *>(g_aliasName) };
-    bool isExist = false;
-    int32_t ret = IsKeyExist(&keyAlias, isExist);
-    CHECK_CONDITION_RETURN_RET((ret != HKS_SUCCESS), ret, "key exist failed");
-    CHECK_CONDITION_RETURN_RET((!isExist), HKS_FAILURE, "key is not exist");
+    int32_t ret = PrepareKey(&keyAlias, false);
+    CHECK_CONDITION_RETURN_RET((ret != HKS_SUCCESS), ret, "prepare key failed");
 
     struct HksParamSet *decryptParamSet = nullptr;
-    struct HksBlob decryptNonce = { NONCE_SIZE, inBuffer->GetData() };
-    struct HksBlob decryptAead = { AEAD_SIZE, inBuffer->GetData() + inBuffer->GetSize() * sizeof(uint8_t) - AEAD_SIZE};
+    struct HksBlob decryptNonce = { NONCE_SIZE, inData->data };
+    struct HksBlob decryptAead = { AEAD_SIZE, inData->data + inData->size - AEAD_SIZE };
     ret = CreateDecryptParamSet(&decryptParamSet, &decryptNonce, &decryptAead);
     CHECK_CONDITION_RETURN_RET((ret != HKS_SUCCESS), ret, "create decrypt param set failed");
 
@@ -246,66 +277,80 @@ int32_t HuksAesAdapter::Decrypt(std::unique_ptr<Uint8ArrayBuffer> &inBuffer,
     ret = HksInit(&keyAlias, decryptParamSet, &handleDecrypt, nullptr);
     if (ret != HKS_SUCCESS) {
         INTELL_VOICE_LOG_ERROR("huks init failed, ret:%{public}d", ret);
+        InvalidateKey();
         return ret;
     }
 
-    auto decryptData = std::make_unique<uint8_t[]>(inBuffer->GetSize() * sizeof(uint8_t) - NONCE_SIZE - AEAD_SIZE);
-    CHECK_CONDITION_RETURN_RET((decryptData == nullptr), HKS_ERROR_MALLOC_FAIL, "decryptData is nullptr");
-
-    struct HksBlob inData = { inBuffer->GetSize() * sizeof(uint8_t) - NONCE_SIZE - AEAD_SIZE,
-        inBuffer->GetData() + NONCE_SIZE };
-    struct HksBlob outData = { inBuffer->GetSize() * sizeof(uint8_t) - NONCE_SIZE - AEAD_SIZE, decryptData.get() };
-
-    ret = UpdateAndFinish(&handleDecrypt, decryptParamSet, &inData, &outData);
+    struct HksBlob cipherData = { GetDecryptSize(inData->size), inData->data + NONCE_SIZE };
+    ret = UpdateAndFinish(&handleDecrypt, decryptParamSet, &cipherData, outData);
     if (ret != HKS_SUCCESS) {
-        INTELL_VOICE_LOG_ERROR("update and finish failed, size:%{public}u", outData.size);
+        INTELL_VOICE_LOG_ERROR("update and finish failed, size:%{public}u", outData->size);
         return ret;
     }
+    return HKS_SUCCESS;
+}
 
-    outBuffer = CreateArrayBuffer<uint8_t>(outData.size, outData.data);
-    if (outBuffer == nullptr) {
-        INTELL_VOICE_LOG_ERROR("allocate out buffer failed, size:%{public}u", outData.size);
-        return HKS_ERROR_MALLOC_FAIL;
+int32_t HuksAesAdapter::PrepareKey(struct HksBlob *keyAlias, bool needGenerate)
+{
+    std::lock_guard<std::mutex> lock(g_keyMutex);
+    if (g_isKeyReady) {
+        return HKS_SUCCESS;
     }
+
+    bool isExist = false;
+    int32_t ret = IsKeyExist(keyAlias, isExist);
+    CHECK_CONDITION_RETURN_RET((ret != HKS_SUCCESS), ret, "key exist failed");
+    if (!isExist) {
+        CHECK_CONDITION_RETURN_RET((!needGenerate), HKS_FAILURE, "key is not exist");
+        ret = GenerateKey(keyAlias);
+        CHECK_CONDITION_RETURN_RET((ret != HKS_SUCCESS), ret, "generate key failed");
+    }
+
+    g_isKeyReady = true;
     return HKS_SUCCESS;
 }
 
+void HuksAesAdapter::InvalidateKey()
+{
+    std::lock_guard<std::mutex> lock(g_keyMutex);
+    g_isKeyReady = false;
+}
+
 int32_t HuksAesAdapter::IsKeyExist(struct HksBlob *keyAlias, bool &isExist)
 {
-    struct HksParamSet *existParamSet = nullptr;
-    int32_t ret = ConstructParamSet(&existParamSet, g_existParams, sizeof(g_existParams) / sizeof(struct HksParam));
-    if (ret != HKS_SUCCESS) {
-        INTELL_VOICE_LOG_ERROR("constuct exist param set failed");
-        return ret;
+    if (g_existParamSet == nullptr) {
+        int32_t ret = ConstructParamSet(&g_existParamSet, g_existParams,
+            sizeof(g_existParams) / sizeof(struct HksParam));
+        if (ret != HKS_SUCCESS) {
+            INTELL_VOICE_LOG_ERROR("constuct exist param set failed");
+            return ret;
+        }
     }
 
-    if (HksKeyExist(keyAlias, existParamSet) == HKS_SUCCESS) {
+    if (HksKeyExist(keyAlias, g_existParamSet) == HKS_SUCCESS) {
         INTELL_VOICE_LOG_INFO("key is already exist");
         isExist = true;
     } else {
         INTELL_VOICE_LOG_INFO("key is not exist");
         isExist = false;
     }
-
-    HksFreeParamSet(&existParamSet);
     return HKS_SUCCESS;
 }
 
 int32_t HuksAesAdapter::GenerateKey(struct HksBlob *keyAlias)
 {
-    struct HksParamSet *genParamSet = nullptr;
-    int32_t ret = ConstructParamSet(&genParamSet, g_genParams, sizeof(g_genParams) / sizeof(struct HksParam));
-    if (ret != HKS_SUCCESS) {
-        INTELL_VOICE_LOG_ERROR("constuct gen param set failed");
-        return ret;
+    if (g_genParamSet == nullptr) {
+        int32_t ret = ConstructParamSet(&g_genParamSet, g_genParams, sizeof(g_genParams) / sizeof(struct HksParam));
+        if (ret != HKS_SUCCESS) {
+            INTELL_VOICE_LOG_ERROR("constuct gen param set failed");
+            return ret;
+        }
     }
 
-    ret = HksGenerateKey(keyAlias, genParamSet, nullptr);
+    int32_t ret = HksGenerateKey(keyAlias, g_genParamSet, nullptr);
     if (ret != HKS_SUCCESS) {
         INTELL_VOICE_LOG_ERROR("generate key failed, ret:%{public}d", ret);
     }
-
-    HksFreeParamSet(&genParamSet);
     return ret;
 }
 
@@ -342,22 +387,14 @@ int32_t HuksAesAdapter::UpdateAndFinish(const struct HksBlob *handle, const stru
     const struct HksBlob *inData, struct HksBlob *outData)
 {
     struct HksBlob inDataSeg = { MAX_UPDATE_SIZE, inData->data };
-    struct HksBlob outDataSeg = { MAX_OUTDATA_SIZE, nullptr };
     uint32_t inUpdateSize = 0;
-    uint8_t *outDataAddr = outData->data;
     uint32_t outUpdateSize = 0;
     int32_t ret = HKS_SUCCESS;
 
-    while (inUpdateSize < inData->size) {
-        if (inUpdateSize + MAX_UPDATE_SIZE >= inData->size) {
-            inDataSeg.size = inData->size - inUpdateSize;
-            break;
-        }
-
-        std::unique_ptr<Uint8ArrayBuffer> tmpUpdateBuff= CreateArrayBuffer<uint8_t>(outDataSeg.size);
-        CHECK_CONDITION_RETURN_RET((tmpUpdateBuff == nullptr), HKS_FAILURE, "tmpUpdateBuff is nullptr");
-        outDataSeg.data = tmpUpdateBuff->GetData();
-
+    // every segment is written to the caller buffer in place
+    while (inData->size - inUpdateSize > MAX_UPDATE_SIZE) {
+        struct HksBlob outDataSeg = { std::min(outData->size - outUpdateSize, MAX_OUTDATA_SIZE),
+            outData->data + outUpdateSize };
         ret = HksUpdate(handle, paramSet, &inDataSeg, &outDataSeg);
         if (ret != HKS_SUCCESS) {
             INTELL_VOICE_LOG_ERROR("Hks update failed, ret:%{public}d", ret);
@@ -369,29 +406,33 @@ int32_t HuksAesAdapter::UpdateAndFinish(const struct HksBlob *handle, const stru
             return HKS_FAILURE;
         }
 
-        (void)memcpy_s(outDataAddr, outData->size - outUpdateSize, outDataSeg.data, outDataSeg.size);
-        outDataAddr += outDataSeg.size;
         outUpdateSize += outDataSeg.size;
-        tmpUpdateBuff = nullptr;
         inUpdateSize += MAX_UPDATE_SIZE;
         inDataSeg.data = inData->data + inUpdateSize;
     }
+    inDataSeg.size = inData->size - inUpdateSize;
 
-    std::unique_ptr<Uint8ArrayBuffer> tmpFinishBuff= CreateArrayBuffer<uint8_t>(inDataSeg.size + AEAD_SIZE);
-    CHECK_CONDITION_RETURN_RET((tmpFinishBuff == nullptr), HKS_FAILURE, "tmpFinishBuff is nullptr");
+    uint32_t remainSize = outData->size - outUpdateSize;
+    bool isInPlace = (remainSize >= inDataSeg.size + AEAD_SIZE);
+    if (!isInPlace && (g_finishBuffer.size() < MAX_UPDATE_SIZE + AEAD_SIZE)) {
+        g_finishBuffer.resize(MAX_UPDATE_SIZE + AEAD_SIZE);
+    }
 
-    struct HksBlob outDataFinish = { tmpFinishBuff->GetSize() * sizeof(uint8_t), tmpFinishBuff->GetData() };
+    struct HksBlob outDataFinish = { isInPlace ? remainSize : (inDataSeg.size + AEAD_SIZE),
+        isInPlace ? (outData->data + outUpdateSize) : g_finishBuffer.data() };
     ret = HksFinish(handle, paramSet, &inDataSeg, &outDataFinish);
     if (ret != HKS_SUCCESS) {
         INTELL_VOICE_LOG_ERROR("Hks finish failed, ret:%{public}d", ret);
         return HKS_FAILURE;
     }
 
-    if (outUpdateSize + outDataFinish.size > outData->size) {
+    if (outDataFinish.size > remainSize) {
         INTELL_VOICE_LOG_ERROR("%{public}u, %{public}u, %{public}u", outUpdateSize, outDataFinish.size, outData->size);
         return HKS_FAILURE;
     }
-    (void)memcpy_s(outDataAddr, outData->size - outUpdateSize, outDataFinish.data, outDataFinish.size);
+    if (!isInPlace) {
+        (void)memcpy_s(outData->data + outUpdateSize, remainSize, outDataFinish.data, outDataFinish.size);
+    }
     outData->size = outUpdateSize + outDataFinish.size;
 
     return HKS_SUCCESS;
@@ -15,6 +15,7 @@
 #ifndef HUKS_AES_ADAPTER_H
 #define HUKS_AES_ADAPTER_H
 
+#include <memory>
 #include "hks_param.h"
 #include "hks_type.h"
 #include "array_buffer_util.h"
@@ -26,10 +27,30 @@ public:
     HuksAesAdapter() = default;
     ~HuksAesAdapter() = default;
 
+    static constexpr uint32_t NONCE_SIZE = 12;
+    static constexpr uint32_t AEAD_SIZE = 16;
+
     static int32_t Encrypt(std::unique_ptr<Uint8ArrayBuffer> &inBuffer, std::unique_ptr<Uint8ArrayBuffer> &outBuffer);
     static int32_t Decrypt(std::unique_ptr<Uint8ArrayBuffer> &inBuffer, std::unique_ptr<Uint8ArrayBuffer> &outBuffer);
-private:
+    /*
+     * Encrypt and decrypt between caller owned buffers, e.g. mapped ashmem, without intermediate copies.
+     * outData->size is the capacity on input and the produced size on output. Encrypted data is laid out
+     * as nonce | cipher text | tag, use GetEncryptSize/GetDecryptSize for the output capacity.
+     */
+    static int32_t Encrypt(const struct HksBlob *inData, struct HksBlob *outData);
+    static int32_t Decrypt(const struct HksBlob *inData, struct HksBlob *outData);
+    static uint32_t GetEncryptSize(uint32_t plainSize)
+    {
+        return (plainSize == 0) ? 0 : (plainSize + NONCE_SIZE + AEAD_SIZE);
+    }
+    static uint32_t GetDecryptSize(uint32_t cipherSize)
+    {
+        return (cipherSize <= NONCE_SIZE + AEAD_SIZE) ? 0 : (cipherSize - NONCE_SIZE - AEAD_SIZE);
+    }
 
+private:
+    static int32_t PrepareKey(struct HksBlob *keyAlias, bool needGenerate);
+    static void InvalidateKey();
     static int32_t IsKeyExist(struct HksBlob *keyAlias, bool &isExist);
     static int32_t GenerateKey(struct HksBlob *keyAlias);
     static int32_t ConstructParamSet(struct HksParamSet **paramSet, const struct HksParam *params,
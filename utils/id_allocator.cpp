@@ -14,6 +14,7 @@
  */
 
 #include "id_allocator.h"
+#include <algorithm>
 #include "intell_voice_log.h"
 
 using namespace std;
@@ -24,38 +25,85 @@ namespace OHOS {
 namespace IntellVoiceUtils {
 IdAllocator::IdAllocator(int maxTimerNum)
 {
-    for (int i = 0; i < maxTimerNum; i++) {
-        idFlags.push_back(false);
+    // slot INDEX_MASK with generation 0 would collide with INVALID_ID
+    capacity_ = (maxTimerNum <= 0) ? 0 : std::min(static_cast<uint32_t>(maxTimerNum), INDEX_MASK);
+    uint32_t wordNum = (capacity_ + WORD_BITS - 1) / WORD_BITS;
+    freeBits_.resize(wordNum, 0);
+    summaryBits_.resize((wordNum + WORD_BITS - 1) / WORD_BITS, 0);
+    generations_.resize(capacity_, 0);
+    for (uint32_t i = 0; i < capacity_; i++) {
+        MarkFree(i);
     }
 }
 
 int IdAllocator::AllocId()
 {
-    for (unsigned int i = 0; i < idFlags.size(); i++) {
-        if (!idFlags[i]) {
-            idFlags[i] = true;
-            return i;
+    for (uint32_t i = 0; i < summaryBits_.size(); i++) {
+        if (summaryBits_[i] == 0) {
+            continue;
         }
+        uint32_t word = i * WORD_BITS + static_cast<uint32_t>(__builtin_ctzll(summaryBits_[i]));
+        uint32_t bit = static_cast<uint32_t>(__builtin_ctzll(freeBits_[word]));
+        freeBits_[word] &= ~(1ULL << bit);
+        if (freeBits_[word] == 0) {
+            summaryBits_[i] &= ~(1ULL << (word % WORD_BITS));
+        }
+        uint32_t index = word * WORD_BITS + bit;
+        return static_cast<int>((static_cast<uint32_t>(generations_[index]) << INDEX_BITS) | index);
     }
 
     return INVALID_ID;
 }
 
-void IdAllocator::ReleaseId(unsigned int id)
+bool IdAllocator::ReleaseId(int id)
 {
-    if (id >= idFlags.size()) {
-        INTELL_VOICE_LOG_ERROR("try to release invalid id %d", id);
-        return;
+    uint32_t index = 0;
+    if (!DecodeId(id, index)) {
+        INTELL_VOICE_LOG_WARN("try to release invalid or stale id %{public}d", id);
+        return false;
     }
-    INTELL_VOICE_LOG_INFO("release id %u", id);
-    idFlags[id] = false;
+
+    generations_[index] = static_cast<uint16_t>((generations_[index] + 1) & GENERATION_MASK);
+    MarkFree(index);
+    return true;
+}
+
+bool IdAllocator::IsAllocated(int id) const
+{
+    uint32_t index = 0;
+    return DecodeId(id, index);
 }
 
 void IdAllocator::ClearId()
 {
-    for (unsigned int i = 0; i < idFlags.size(); i++) {
-        idFlags[i] = false;
+    for (uint32_t i = 0; i < capacity_; i++) {
+        if ((freeBits_[i / WORD_BITS] & (1ULL << (i % WORD_BITS))) == 0) {
+            generations_[i] = static_cast<uint16_t>((generations_[i] + 1) & GENERATION_MASK);
+            MarkFree(i);
+        }
+    }
+}
+
+bool IdAllocator::DecodeId(int id, uint32_t &index) const
+{
+    if ((id < 0) || (id == INVALID_ID)) {
+        return false;
+    }
+
+    index = static_cast<uint32_t>(id) & INDEX_MASK;
+    uint32_t generation = static_cast<uint32_t>(id) >> INDEX_BITS;
+    if ((index >= capacity_) || (generation != generations_[index])) {
+        return false;
     }
+    // a free slot has no owner, whatever the generation
+    return (freeBits_[index / WORD_BITS] & (1ULL << (index % WORD_BITS))) == 0;
+}
+
+void IdAllocator::MarkFree(uint32_t index)
+{
+    uint32_t word = index / WORD_BITS;
+    freeBits_[word] |= (1ULL << (index % WORD_BITS));
+    summaryBits_[word / WORD_BITS] |= (1ULL << (word % WORD_BITS));
+}
 }
 }
-}
\ No newline at end of file
@@ -15,20 +15,39 @@
 #ifndef ID_ALLOCTOR_H
 #define ID_ALLOCTOR_H
 
+#include <cstdint>
 #include <vector>
 
 namespace OHOS {
 namespace IntellVoiceUtils {
 constexpr int INVALID_ID = 0xffff;
 
+/*
+ * Slot allocator for timer ids. Free slots are kept in a word-packed bitset plus a summary word per
+ * 64 words, so finding a free slot is two count-trailing-zeros for up to 4096 slots.
+ * The returned id is (generation << 16) | slot; the generation of a slot changes on every release,
+ * so a stale id held after its timer fired or was killed never matches the slot's next owner.
+ */
 struct IdAllocator {
     explicit IdAllocator(int maxTimerNum = 100);
     virtual ~IdAllocator(){};
     int AllocId();
-    void ReleaseId(unsigned int id);
+    bool ReleaseId(int id);
+    bool IsAllocated(int id) const;
     void ClearId();
 private:
-    std::vector<bool> idFlags;
+    static constexpr uint32_t INDEX_BITS = 16;
+    static constexpr uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1;
+    static constexpr uint32_t GENERATION_MASK = 0x7fff;
+    static constexpr uint32_t WORD_BITS = 64;
+
+    bool DecodeId(int id, uint32_t &index) const;
+    void MarkFree(uint32_t index);
+
+    uint32_t capacity_ = 0;
+    std::vector<uint64_t> freeBits_;
+    std::vector<uint64_t> summaryBits_;
+    std::vector<uint16_t> generations_;
 };
 }
 }
@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef INTELL_VOICE_PARAM_H
+#define INTELL_VOICE_PARAM_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace OHOS {
+namespace IntellVoiceUtils {
+// the ids are written to the SET_PARAMETERS parcel, never renumber them and only append new keys
+enum ParamKey : uint32_t {
+    PARAM_KEY_SENSIBILITY = 0,
+    PARAM_KEY_WAKEUP_BUNDLE_NAME = 1,
+    PARAM_KEY_WAKEUP_ABILITY_NAME = 2,
+    PARAM_KEY_LANGUAGE = 3,
+    PARAM_KEY_AREA = 4,
+    PARAM_KEY_RECORD_START = 5,
+    PARAM_KEY_IS_FOLDABLE = 6,
+    PARAM_KEY_FOLD_STATUS = 7,
+    PARAM_KEY_NUM = 8,
+    PARAM_KEY_UNKNOWN = PARAM_KEY_NUM,
+};
+
+inline constexpr std::string_view PARAM_KEY_NAMES[PARAM_KEY_NUM] = {
+    "Sensibility",
+    "wakeup_bundle_name",
+    "wakeup_ability_name",
+    "language",
+    "area",
+    "record_start",
+    "is_foldable",
+    "fold_status",
+};
+
+/*
+ * Parses "key=value;key=value" lists in place. Keys and values are views into the input, so nothing
+ * is allocated; segments without '=' or with an empty key or value are skipped, spaces are trimmed.
+ */
+class IntellVoiceParam {
+public:
+    static constexpr ParamKey InternKey(std::string_view key)
+    {
+        for (uint32_t i = 0; i < PARAM_KEY_NUM; ++i) {
+            if (PARAM_KEY_NAMES[i] == key) {
+                return static_cast<ParamKey>(i);
+            }
+        }
+        return PARAM_KEY_UNKNOWN;
+    }
+
+    static constexpr std::string_view KeyName(ParamKey key)
+    {
+        return (key < PARAM_KEY_NUM) ? PARAM_KEY_NAMES[key] : std::string_view();
+    }
+
+    static constexpr std::string_view Trim(std::string_view str)
+    {
+        size_t begin = str.find_first_not_of(' ');
+        if (begin == std::string_view::npos) {
+            return std::string_view();
+        }
+        size_t end = str.find_last_not_of(' ');
+        return str.substr(begin, end - begin + 1);
+    }
+
+    static constexpr bool SplitPair(std::string_view pair, std::string_view &key, std::string_view &value)
+    {
+        size_t pos = pair.find('=');
+        if (pos == std::string_view::npos) {
+            return false;
+        }
+        key = Trim(pair.substr(0, pos));
+        value = Trim(pair.substr(pos + 1));
+        return !key.empty() && !value.empty();
+    }
+
+    // func(std::string_view key, std::string_view value) is called for each valid pair, returns the count
+    template<typename Func>
+    static uint32_t ForEachKVPair(std::string_view keyValueList, Func &&func)
+    {
+        uint32_t count = 0;
+        while (!keyValueList.empty()) {
+            size_t pos = keyValueList.find(';');
+            std::string_view pair = keyValueList.substr(0, pos);
+            keyValueList = (pos == std::string_view::npos) ? std::string_view() : keyValueList.substr(pos + 1);
+
+            std::string_view key;
+            std::string_view value;
+            if (SplitPair(pair, key, value)) {
+                func(key, value);
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    static bool ParseBool(std::string_view value)
+    {
+        return value == "true";
+    }
+};
+
+// a wire id must keep its key name, the service looks the name up by id
+static_assert(IntellVoiceParam::InternKey("Sensibility") == PARAM_KEY_SENSIBILITY, "wire id changed");
+static_assert(IntellVoiceParam::InternKey("wakeup_bundle_name") == PARAM_KEY_WAKEUP_BUNDLE_NAME, "wire id changed");
+static_assert(IntellVoiceParam::InternKey("wakeup_ability_name") == PARAM_KEY_WAKEUP_ABILITY_NAME, "wire id changed");
+static_assert(IntellVoiceParam::InternKey("language") == PARAM_KEY_LANGUAGE, "wire id changed");
+static_assert(IntellVoiceParam::InternKey("area") == PARAM_KEY_AREA, "wire id changed");
+static_assert(IntellVoiceParam::InternKey("record_start") == PARAM_KEY_RECORD_START, "wire id changed");
+static_assert(IntellVoiceParam::InternKey("is_foldable") == PARAM_KEY_IS_FOLDABLE, "wire id changed");
+static_assert(IntellVoiceParam::InternKey("fold_status") == PARAM_KEY_FOLD_STATUS, "wire id changed");
+
+/*
+ * Typed parameters set together. Entries cross IPC as key ids and the service's ParamDispatcher
+ * dispatches them directly without parsing; ToString() gives the "key=value;..." form for logs and
+ * the string based SetParameter.
+ */
+class ParamBatch {
+public:
+    ParamBatch &Set(ParamKey key, std::string_view value)
+    {
+        if (key < PARAM_KEY_NUM) {
+            entries_.emplace_back(key, std::string(value));
+        }
+        return *this;
+    }
+
+    ParamBatch &Set(ParamKey key, const char *value)
+    {
+        return Set(key, std::string_view(value));
+    }
+
+    ParamBatch &Set(ParamKey key, bool value)
+    {
+        return Set(key, value ? std::string_view("true") : std::string_view("false"));
+    }
+
+    ParamBatch &Set(ParamKey key, int32_t value)
+    {
+        return Set(key, std::string_view(std::to_string(value)));
+    }
+
+    bool Empty() const
+    {
+        return entries_.empty();
+    }
+
+    const std::vector<std::pair<ParamKey, std::string>> &Entries() const
+    {
+        return entries_;
+    }
+
+    std::string ToString() const
+    {
+        std::string result;
+        for (const auto &entry : entries_) {
+            if (!result.empty()) {
+                result.append(";");
+            }
+            result.append(IntellVoiceParam::KeyName(entry.first)).append("=").append(entry.second);
+        }
+        return result;
+    }
+
+private:
+    std::vector<std::pair<ParamKey, std::string>> entries_;
+};
+}
+}
+#endif
@@ -104,7 +104,7 @@ void IntellVoiceUtil::SplitStringToKVPair(const std::string &inputStr, std::map<
         std::string value;
         if (StringUtil::SplitLineToPair(it, key, value)) {
             kvpairs[key] = value;
-            INTELL_VOICE_LOG_INFO("key:%{public}s, value:%{public}s", key.c_str(), value.c_str());
+            INTELL_VOICE_LOG_DEBUG("key:%{public}s, value:%{public}s", key.c_str(), value.c_str());
         }
     }
 }
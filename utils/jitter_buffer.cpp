@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "jitter_buffer.h"
+
+#include <algorithm>
+#include <cmath>
+#include "intell_voice_log.h"
+
+#define LOG_TAG "JitterBuffer"
+
+namespace OHOS {
+namespace IntellVoiceUtils {
+static constexpr double INTERVAL_SMOOTH_FACTOR = 1.0 / 16;  // same weight as the RFC 3550 jitter estimate
+static constexpr double JITTER_STDDEV_FACTOR = 2.0;
+static constexpr uint32_t SHRINK_HOLD_ARRIVALS = 50;
+static constexpr uint32_t DRAIN_DEPTH_FACTOR = 2;
+static constexpr int64_t DRAIN_INTERVAL_NUM = 3;
+static constexpr int64_t DRAIN_INTERVAL_DEN = 4;
+
+JitterBuffer::JitterBuffer(const JitterBufferConfig &config) : config_(config)
+{
+    config_.frameIntervalUs = std::max<int64_t>(config_.frameIntervalUs, 1);
+    config_.minDepth = std::max<uint32_t>(config_.minDepth, 1);
+    config_.maxDepth = std::max(config_.maxDepth, config_.minDepth);
+    Reset();
+}
+
+void JitterBuffer::Reset()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    isPlaying_ = false;
+    isStarved_ = false;
+    isEndOfStream_ = false;
+    hasArrival_ = false;
+    lastArrivalUs_ = 0;
+    nextReleaseUs_ = 0;
+    meanIntervalUs_ = static_cast<double>(config_.frameIntervalUs);
+    varIntervalUs_ = 0;
+    targetDepth_ = config_.minDepth;
+    shrinkHold_ = 0;
+    stats_ = JitterBufferStats();
+}
+
+void JitterBuffer::SetFrameInterval(int64_t frameIntervalUs)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    frameIntervalUs = std::max<int64_t>(frameIntervalUs, 1);
+    if (frameIntervalUs == config_.frameIntervalUs) {
+        return;
+    }
+    INTELL_VOICE_LOG_INFO("frame interval:%{public}lld us", static_cast<long long>(frameIntervalUs));
+    config_.frameIntervalUs = frameIntervalUs;
+    // before the first interval is measured the estimate is only the nominal one
+    if (stats_.arrivalCnt <= 1) {
+        meanIntervalUs_ = static_cast<double>(frameIntervalUs);
+    }
+}
+
+int64_t JitterBuffer::GetFrameInterval()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return config_.frameIntervalUs;
+}
+
+void JitterBuffer::OnArrival(int64_t nowUs, uint32_t depth)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.arrivalCnt++;
+
+    // the reader already found the queue empty, or its release slot has passed with nothing queued
+    bool isLate = isStarved_ || (isPlaying_ && (depth <= 1) && (nowUs > nextReleaseUs_));
+    if (isLate) {
+        stats_.lateCnt++;
+        isStarved_ = false;
+    }
+
+    if (!hasArrival_) {
+        hasArrival_ = true;
+        lastArrivalUs_ = nowUs;
+        return;
+    }
+
+    double interval = static_cast<double>(nowUs - lastArrivalUs_);
+    lastArrivalUs_ = nowUs;
+    double diff = interval - meanIntervalUs_;
+    meanIntervalUs_ += diff * INTERVAL_SMOOTH_FACTOR;
+    varIntervalUs_ += (diff * diff - varIntervalUs_) * INTERVAL_SMOOTH_FACTOR;
+
+    // enough frames to ride out a gap of mean + 2 stddev, underruns add more on top
+    double coverUs = meanIntervalUs_ + JITTER_STDDEV_FACTOR * std::sqrt(varIntervalUs_);
+    uint32_t desiredDepth = static_cast<uint32_t>(std::ceil(coverUs / config_.frameIntervalUs));
+    UpdateTargetDepth(desiredDepth);
+}
+
+void JitterBuffer::UpdateTargetDepth(uint32_t desiredDepth)
+{
+    desiredDepth = std::clamp(desiredDepth, config_.minDepth, config_.maxDepth);
+    if (desiredDepth > targetDepth_) {
+        targetDepth_ = desiredDepth;
+        shrinkHold_ = 0;
+        return;
+    }
+
+    // grow at once, shrink one frame at a time after the jitter has stayed low for a while
+    if ((desiredDepth < targetDepth_) && (++shrinkHold_ >= SHRINK_HOLD_ARRIVALS)) {
+        targetDepth_--;
+        shrinkHold_ = 0;
+    } else if (desiredDepth == targetDepth_) {
+        shrinkHold_ = 0;
+    }
+}
+
+void JitterBuffer::StartPlaying(int64_t nowUs)
+{
+    isPlaying_ = true;
+    nextReleaseUs_ = nowUs;
+}
+
+int64_t JitterBuffer::Poll(int64_t nowUs, uint32_t depth)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (depth >= config_.maxDepth) {
+        if (!isPlaying_) {
+            StartPlaying(nowUs);
+        }
+        return 0;
+    }
+
+    if (!isPlaying_) {
+        if ((depth == 0) || ((depth < targetDepth_) && !isEndOfStream_)) {
+            return config_.frameIntervalUs;
+        }
+        StartPlaying(nowUs);
+        return 0;
+    }
+
+    if (nowUs < nextReleaseUs_) {
+        return nextReleaseUs_ - nowUs;
+    }
+
+    if ((depth == 0) && isEndOfStream_) {
+        isPlaying_ = false;
+        return config_.frameIntervalUs;
+    }
+
+    if (depth == 0) {
+        stats_.underrunCnt++;
+        isPlaying_ = false;
+        isStarved_ = true;
+        targetDepth_ = std::min(targetDepth_ + 1, config_.maxDepth);
+        shrinkHold_ = 0;
+        INTELL_VOICE_LOG_DEBUG("underrun, target depth:%{public}u", targetDepth_);
+        return config_.frameIntervalUs;
+    }
+    return 0;
+}
+
+void JitterBuffer::OnRelease(int64_t nowUs, uint32_t depth)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.releaseCnt++;
+    if (!isPlaying_) {
+        return;
+    }
+
+    // well above target: shorten the cadence to win back latency instead of flushing
+    int64_t interval = config_.frameIntervalUs;
+    if (depth > targetDepth_ * DRAIN_DEPTH_FACTOR) {
+        interval = interval * DRAIN_INTERVAL_NUM / DRAIN_INTERVAL_DEN;
+    }
+    // a reader that falls behind gets at most one extra frame, not a flood
+    nextReleaseUs_ = std::max(nextReleaseUs_, nowUs - interval) + interval;
+}
+
+void JitterBuffer::SetEndOfStream()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    isEndOfStream_ = true;
+}
+
+JitterBufferStats JitterBuffer::GetStats()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    JitterBufferStats stats = stats_;
+    stats.targetDepth = targetDepth_;
+    stats.meanIntervalUs = static_cast<int64_t>(meanIntervalUs_);
+    stats.jitterUs = static_cast<int64_t>(std::sqrt(varIntervalUs_));
+    return stats;
+}
+}
+}
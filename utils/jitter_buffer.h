@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef INTELL_VOICE_JITTER_BUFFER_H
+#define INTELL_VOICE_JITTER_BUFFER_H
+
+#include <cstdint>
+#include <mutex>
+#include "nocopyable.h"
+
+namespace OHOS {
+namespace IntellVoiceUtils {
+struct JitterBufferConfig {
+    int64_t frameIntervalUs = 20000;
+    uint32_t minDepth = 2;
+    uint32_t maxDepth = 16;
+};
+
+struct JitterBufferStats {
+    uint32_t targetDepth = 0;
+    int64_t meanIntervalUs = 0;
+    int64_t jitterUs = 0;
+    uint64_t arrivalCnt = 0;
+    uint64_t releaseCnt = 0;
+    uint64_t underrunCnt = 0;
+    uint64_t lateCnt = 0;
+};
+
+/*
+ * Playout policy for frames that arrive in bursts. It keeps a running mean and variance of the
+ * inter-arrival time, derives a target depth from them, and paces releases at the frame interval
+ * once that depth is buffered. The frames themselves stay in the caller's queue; every call takes
+ * the current time and queue depth, so the policy is deterministic under a replayed clock.
+ * An underrun is a due release that finds the queue empty, a late frame is one that arrives after
+ * the release it was needed for.
+ */
+class JitterBuffer {
+public:
+    explicit JitterBuffer(const JitterBufferConfig &config = JitterBufferConfig());
+    ~JitterBuffer() = default;
+
+    void Reset();
+    // the source's real block duration, it may differ from the configured one; kept across Reset
+    void SetFrameInterval(int64_t frameIntervalUs);
+    int64_t GetFrameInterval();
+    void OnArrival(int64_t nowUs, uint32_t depth);
+    // 0: release one frame now, otherwise the time in us to wait before asking again
+    int64_t Poll(int64_t nowUs, uint32_t depth);
+    void OnRelease(int64_t nowUs, uint32_t depth);
+    // no more arrivals: whatever is queued is released at the cadence without waiting for the target depth
+    void SetEndOfStream();
+    JitterBufferStats GetStats();
+
+private:
+    void UpdateTargetDepth(uint32_t desiredDepth);
+    void StartPlaying(int64_t nowUs);
+
+    std::mutex mutex_;
+    JitterBufferConfig config_;
+    bool isPlaying_ = false;
+    bool isStarved_ = false;
+    bool isEndOfStream_ = false;
+    bool hasArrival_ = false;
+    int64_t lastArrivalUs_ = 0;
+    int64_t nextReleaseUs_ = 0;
+    double meanIntervalUs_ = 0;
+    double varIntervalUs_ = 0;
+    uint32_t targetDepth_ = 0;
+    uint32_t shrinkHold_ = 0;
+    JitterBufferStats stats_;
+
+    DISALLOW_COPY(JitterBuffer);
+    DISALLOW_MOVE(JitterBuffer);
+};
+}
+}
+#endif
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef INTELL_VOICE_LOCK_FREE_QUEUE_H
+#define INTELL_VOICE_LOCK_FREE_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include "nocopyable.h"
+
+namespace OHOS {
+namespace IntellVoiceUtils {
+/*
+ * Bounded array queue with per-cell sequence numbers (Vyukov). Any number of threads may push and
+ * pop concurrently; a push or pop claims its cell with one CAS and never takes a lock.
+ * Capacity is rounded up to a power of two.
+ */
+template <typename T>
+class LockFreeQueue {
+public:
+    explicit LockFreeQueue(uint32_t capacity)
+    {
+        capacity_ = 1;
+        while (capacity_ < capacity) {
+            capacity_ <<= 1;
+        }
+        mask_ = capacity_ - 1;
+        cells_ = std::make_unique<Cell[]>(capacity_);
+        for (size_t i = 0; i < capacity_; ++i) {
+            cells_[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+    ~LockFreeQueue() = default;
+
+    bool Push(T &&element)
+    {
+        Cell *cell = nullptr;
+        size_t pos = tail_.load(std::memory_order_relaxed);
+        while (true) {
+            cell = &cells_[pos & mask_];
+            size_t seq = cell->seq.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+        cell->data = std::move(element);
+        cell->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool Pop(T &element)
+    {
+        Cell *cell = nullptr;
+        size_t pos = head_.load(std::memory_order_relaxed);
+        while (true) {
+            cell = &cells_[pos & mask_];
+            size_t seq = cell->seq.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = head_.load(std::memory_order_relaxed);
+            }
+        }
+        element = std::move(cell->data);
+        cell->data = T();
+        cell->seq.store(pos + mask_ + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t Capacity() const
+    {
+        return capacity_;
+    }
+
+private:
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    struct Cell {
+        std::atomic<size_t> seq { 0 };
+        T data {};
+    };
+
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> head_ { 0 };
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_ { 0 };
+    alignas(CACHE_LINE_SIZE) size_t capacity_ = 0;
+    size_t mask_ = 0;
+    std::unique_ptr<Cell[]> cells_;
+
+    DISALLOW_COPY(LockFreeQueue);
+    DISALLOW_MOVE(LockFreeQueue);
+};
+}
+}
+#endif
@@ -13,6 +13,14 @@
  * limitations under the License.
  */
 #include "message_queue.h"
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <thread>
+#include <ctime>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
 #include "intell_voice_log.h"
 
 #define LOG_TAG "MesaageQueue"
@@ -21,6 +29,44 @@ using namespace std;
 
 namespace OHOS {
 namespace IntellVoiceUtils {
+static constexpr int64_t NS_PER_S = 1000000000;
+static constexpr int32_t PARK_SPIN_ROUNDS = 4;
+
+static void FutexWait(std::atomic<int32_t> *addr, int32_t expected, const struct timespec *timeout)
+{
+    syscall(SYS_futex, reinterpret_cast<int32_t *>(addr), FUTEX_WAIT_PRIVATE, expected, timeout, nullptr, 0);
+}
+
+static void FutexWake(std::atomic<int32_t> *addr, int32_t count)
+{
+    syscall(SYS_futex, reinterpret_cast<int32_t *>(addr), FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+}
+
+bool SynInfo::Wait(uint32_t timeoutMs)
+{
+    auto deadline = chrono::steady_clock::now() + chrono::milliseconds(timeoutMs);
+    while (state_.load(memory_order_acquire) == 0) {
+        int64_t remainNs = chrono::duration_cast<chrono::nanoseconds>(deadline - chrono::steady_clock::now()).count();
+        if (remainNs <= 0) {
+            return false;
+        }
+        struct timespec timeout = { static_cast<time_t>(remainNs / NS_PER_S), static_cast<long>(remainNs % NS_PER_S) };
+        FutexWait(&state_, 0, &timeout);
+    }
+    return true;
+}
+
+void SynInfo::Notify()
+{
+    state_.store(1, memory_order_release);
+    FutexWake(&state_, INT_MAX);
+}
+
+void SynInfo::Reset()
+{
+    state_.store(0, memory_order_relaxed);
+}
+
 Message::Message(uint32_t what) : what_(what), arg1_(0), arg2_(0)
 {
 }
@@ -66,71 +112,113 @@ Message::~Message()
     voidPtr_ = nullptr;
 }
 
-MessageQueue::MessageQueue(uint32_t size) : size_(size), lock_(PTHREAD_MUTEX_INITIALIZER)
+void Message::Reset()
 {
-    pthread_condattr_t attr;
-    int result = pthread_condattr_init(&attr);
-    result += pthread_cond_init(&cond_, &attr);
-    result += pthread_condattr_destroy(&attr);
-    if (result != 0) {
-        INTELL_VOICE_LOG_ERROR("message queue construct init cond failed");
+    what_ = 0;
+    arg1_ = 0;
+    arg2_ = 0;
+    arg3_ = 0.0f;
+    obj_.clear();
+    obj2_ = nullptr;
+    obj3_ = nullptr;
+    voidPtr_ = nullptr;
+    callbackId_ = 0;
+    // the reply slot is kept for the next synchronous send unless a timed out sender still holds it
+    if (result_ != nullptr && result_.use_count() == 1) {
+        result_->Reset();
+    } else {
+        result_ = nullptr;
     }
 }
 
+MessageQueue::MessageQueue(uint32_t size) : size_(size), queue_(size), pool_(size)
+{
+}
+
 MessageQueue::~MessageQueue()
 {
-    int result = pthread_mutex_destroy(&lock_);
-    result += pthread_cond_destroy(&cond_);
-    if (result != 0) {
-        INTELL_VOICE_LOG_ERROR("message queue deconstruct destroy cond failed");
-    }
+    Clear();
 }
 
 shared_ptr<Message> MessageQueue::ReceiveMsg()
 {
     shared_ptr<Message> msg = nullptr;
-    pthread_mutex_lock(&lock_);
-    while (queue_.empty()) {
-        pthread_cond_wait(&cond_, &lock_);
+    while (true) {
+        // give producers a few chances to publish before paying for a sleep and a wake syscall
+        for (int32_t i = 0; i < PARK_SPIN_ROUNDS && pending_.load(memory_order_acquire) == 0; ++i) {
+            this_thread::yield();
+        }
+        if (pending_.load(memory_order_acquire) == 0) {
+            parked_.store(true, memory_order_seq_cst);
+            if (pending_.load(memory_order_seq_cst) == 0) {
+                FutexWait(&pending_, 0, nullptr);
+            }
+            parked_.store(false, memory_order_relaxed);
+            continue;
+        }
+
+        if (queue_.Pop(msg)) {
+            pending_.fetch_sub(1, memory_order_acq_rel);
+            return msg;
+        }
+        // a concurrent Clear took the message and has not updated pending_ yet
+        this_thread::yield();
     }
-
-    msg = queue_.front();
-    queue_.pop();
-    pthread_mutex_unlock(&lock_);
-
-    return msg;
 }
 
 bool MessageQueue::SendMsg(shared_ptr<Message> msg)
 {
-    pthread_mutex_lock(&lock_);
-    if (static_cast<uint32_t>(queue_.size()) >= size_ || msg == nullptr) {
-        INTELL_VOICE_LOG_WARN("send message failed, msg queue full(%{public}d)", static_cast<int>(queue_.size()));
-        pthread_mutex_unlock(&lock_);
+    if (msg == nullptr) {
+        INTELL_VOICE_LOG_WARN("send message failed, msg is nullptr");
         return false;
     }
 
-    try {
-        queue_.push(msg);
-    } catch (const std::length_error& err) {
-        INTELL_VOICE_LOG_ERROR("messagequeue push, length error");
-        pthread_mutex_unlock(&lock_);
+    int32_t pending = pending_.load(memory_order_relaxed);
+    if (static_cast<uint32_t>(pending) >= size_ || !queue_.Push(std::move(msg))) {
+        INTELL_VOICE_LOG_WARN("send message failed, msg queue full(%{public}d)", pending);
         return false;
     }
 
-    pthread_cond_signal(&cond_);
-    pthread_mutex_unlock(&lock_);
-
+    // only the send that makes the queue non-empty may find the consumer parked
+    if (pending_.fetch_add(1, memory_order_seq_cst) == 0 && parked_.load(memory_order_seq_cst)) {
+        FutexWake(&pending_, 1);
+    }
     return true;
 }
 
 void MessageQueue::Clear()
 {
-    pthread_mutex_lock(&lock_);
-    while (!queue_.empty()) {
-        queue_.pop();
+    shared_ptr<Message> msg = nullptr;
+    while (queue_.Pop(msg)) {
+        pending_.fetch_sub(1, memory_order_acq_rel);
+        RecycleMsg(msg);
+    }
+}
+
+shared_ptr<Message> MessageQueue::ObtainMsg()
+{
+    shared_ptr<Message> msg = nullptr;
+    if (pool_.Pop(msg)) {
+        return msg;
+    }
+    return make_shared<Message>(0);
+}
+
+void MessageQueue::RecycleMsg(shared_ptr<Message> &msg)
+{
+    if (msg == nullptr) {
+        return;
     }
-    pthread_mutex_unlock(&lock_);
+
+    // still referenced by a sender or a handler, the last owner frees it
+    if (msg.use_count() != 1) {
+        msg = nullptr;
+        return;
+    }
+
+    msg->Reset();
+    pool_.Push(std::move(msg));
+    msg = nullptr;
 }
 }
 }
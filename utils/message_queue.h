@@ -15,19 +15,24 @@
 #ifndef MESSAGE_QUEUE_H
 #define MESSAGE_QUEUE_H
 
-#include <queue>
+#include <atomic>
 #include <memory>
 #include <string>
-#include <pthread.h>
-#include <mutex>
-#include <condition_variable>
+#include "lock_free_queue.h"
 #include "nocopyable.h"
 
 namespace OHOS {
 namespace IntellVoiceUtils {
+/*
+ * Reply slot of a synchronous message: the handler thread flips state_ once the message has been
+ * handled and wakes only the thread parked on this slot.
+ */
 struct SynInfo {
-    std::mutex mutex_;
-    std::condition_variable cv_;
+    bool Wait(uint32_t timeoutMs);
+    void Notify();
+    void Reset();
+
+    std::atomic<int32_t> state_ { 0 };
 };
 struct Message {
 public:
@@ -41,6 +46,7 @@ public:
     Message(uint32_t what, void* voidPtr);
     Message(uint32_t what, int32_t arg1, void* voidPtr);
     ~Message();
+    void Reset();
 
     uint32_t what_ = 0;
     int32_t arg1_ = 0;
@@ -55,6 +61,13 @@ public:
     std::shared_ptr<SynInfo> result_ = nullptr;
 };
 
+/*
+ * Bounded multi-producer/single-consumer queue. Senders never block: a message is published with
+ * one CAS and the consumer is woken only when the queue goes from empty to non-empty, the consumer
+ * parks on the pending counter itself when there is nothing to do.
+ * Messages handed out by ObtainMsg come from a pool and go back to it through RecycleMsg, so a
+ * steady message flow does not allocate.
+ */
 class MessageQueue {
 public:
     explicit MessageQueue(uint32_t size);
@@ -62,12 +75,15 @@ public:
     std::shared_ptr<Message> ReceiveMsg();
     bool SendMsg(std::shared_ptr<Message> msg);
     void Clear();
+    std::shared_ptr<Message> ObtainMsg();
+    void RecycleMsg(std::shared_ptr<Message> &msg);
 
 private:
     uint32_t size_;
-    pthread_mutex_t lock_;
-    pthread_cond_t cond_;
-    std::queue<std::shared_ptr<Message>> queue_;
+    std::atomic<int32_t> pending_ { 0 };
+    std::atomic<bool> parked_ { false };
+    LockFreeQueue<std::shared_ptr<Message>> queue_;
+    LockFreeQueue<std::shared_ptr<Message>> pool_;
     DISALLOW_COPY(MessageQueue);
     DISALLOW_MOVE(MessageQueue);
 };
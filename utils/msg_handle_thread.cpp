@@ -24,7 +24,6 @@ using namespace std;
 namespace OHOS {
 namespace IntellVoiceUtils {
 static const uint32_t MSQ_QUEUE_MAX_LEN = 100;
-static const int32_t MSG_MAX_SYNC_TIMEOUT = 5;
 
 MsgHandleThread::MsgHandleThread() : msgQue_(MSQ_QUEUE_MAX_LEN), callbackThread_(nullptr) {}
 
@@ -53,16 +52,21 @@ bool MsgHandleThread::HandleMsg(Message &msg)
     return true;
 }
 
+shared_ptr<Message> MsgHandleThread::ObtainMsg()
+{
+    return msgQue_.ObtainMsg();
+}
+
 bool MsgHandleThread::SendMsg(Message msg)
 {
-    try {
-        msgQue_.SendMsg(std::make_shared<Message>(msg));
-    } catch (const std::length_error& err) {
-        INTELL_VOICE_LOG_ERROR("length error");
+    shared_ptr<Message> pooled = msgQue_.ObtainMsg();
+    if (pooled == nullptr) {
+        INTELL_VOICE_LOG_ERROR("obtain msg failed");
         return false;
     }
 
-    return true;
+    *pooled = std::move(msg);
+    return msgQue_.SendMsg(pooled);
 }
 
 bool MsgHandleThread::SendMsg(std::shared_ptr<Message> msg)
@@ -71,30 +75,31 @@ bool MsgHandleThread::SendMsg(std::shared_ptr<Message> msg)
         return false;
     }
 
-    msgQue_.SendMsg(msg);
-    return true;
+    return msgQue_.SendMsg(msg);
 }
 
-bool MsgHandleThread::SendSynMsg(shared_ptr<Message> msg)
+bool MsgHandleThread::SendSynMsg(shared_ptr<Message> msg, uint32_t timeoutMs)
 {
     if (msg == nullptr) {
         return false;
     }
 
-    msg->result_ = std::make_shared<SynInfo>();
     if (msg->result_ == nullptr) {
-        INTELL_VOICE_LOG_ERROR("create sync info failed");
+        msg->result_ = std::make_shared<SynInfo>();
+    } else {
+        msg->result_->Reset();
+    }
+    shared_ptr<SynInfo> result = msg->result_;
+
+    if (!msgQue_.SendMsg(msg)) {
         return false;
     }
 
-    unique_lock<mutex> lock(msg->result_->mutex_);
-    msgQue_.SendMsg(msg);
-    if (msg->result_->cv_.wait_for(lock, chrono::seconds(MSG_MAX_SYNC_TIMEOUT)) == std::cv_status::no_timeout) {
-        return true;
-    } else {
+    if (!result->Wait(timeoutMs)) {
         INTELL_VOICE_LOG_WARN("send syn msg timeout");
         return false;
     }
+    return true;
 }
 
 void MsgHandleThread::SendbackMsg(Message msg)
@@ -104,7 +109,11 @@ void MsgHandleThread::SendbackMsg(Message msg)
     }
 
     if (callbackMsgQue_ != nullptr) {
-        callbackMsgQue_->SendMsg(make_shared<Message>(msg));
+        shared_ptr<Message> pooled = callbackMsgQue_->ObtainMsg();
+        if (pooled != nullptr) {
+            *pooled = std::move(msg);
+            callbackMsgQue_->SendMsg(pooled);
+        }
     }
 }
 
@@ -118,9 +127,9 @@ void MsgHandleThread::Run()
         isQuit = HandleMsg(*msg);
 
         if (msg->result_ != nullptr) {
-            unique_lock<mutex> lock(msg->result_->mutex_);
-            msg->result_->cv_.notify_all();
+            msg->result_->Notify();
         }
+        msgQue_.RecycleMsg(msg);
     }
 }
 }
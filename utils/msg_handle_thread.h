@@ -23,6 +23,8 @@ namespace OHOS {
 namespace IntellVoiceUtils {
 class MsgHandleThread : public BaseThread {
 public:
+    static constexpr uint32_t DEFAULT_SYNC_TIMEOUT_MS = 5000;
+
     MsgHandleThread();
     // for compatible with wakeup engine
     explicit MsgHandleThread(std::shared_ptr<MessageQueue> callbackMsgQue);
@@ -30,7 +32,8 @@ public:
     ~MsgHandleThread() override;
     bool SendMsg(Message msg);
     bool SendMsg(std::shared_ptr<Message> msg);
-    bool SendSynMsg(std::shared_ptr<Message> msg);
+    bool SendSynMsg(std::shared_ptr<Message> msg, uint32_t timeoutMs = DEFAULT_SYNC_TIMEOUT_MS);
+    std::shared_ptr<Message> ObtainMsg();
     void SetCallbackThread(MsgHandleThread *tmpCallbackThread);
 
 protected:
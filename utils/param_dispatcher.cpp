@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "param_dispatcher.h"
+
+#include "intell_voice_log.h"
+
+#define LOG_TAG "ParamDispatcher"
+
+namespace OHOS {
+namespace IntellVoiceUtils {
+ParamDispatcher &ParamDispatcher::Register(ParamKey key, ParamHandler handler)
+{
+    if (key >= PARAM_KEY_NUM) {
+        INTELL_VOICE_LOG_ERROR("invalid key:%{public}u", key);
+        return *this;
+    }
+    handlers_[key] = std::move(handler);
+    return *this;
+}
+
+ParamDispatcher &ParamDispatcher::SetUnknownHandler(UnknownParamHandler handler)
+{
+    unknownHandler_ = std::move(handler);
+    return *this;
+}
+
+bool ParamDispatcher::DispatchPair(ParamKey key, std::string_view keyName, std::string_view value) const
+{
+    if ((key < PARAM_KEY_NUM) && (handlers_[key] != nullptr)) {
+        handlers_[key](value);
+        return true;
+    }
+
+    if (unknownHandler_ != nullptr) {
+        unknownHandler_(keyName, value);
+    }
+    return false;
+}
+
+uint32_t ParamDispatcher::Dispatch(std::string_view keyValueList) const
+{
+    uint32_t handled = 0;
+    IntellVoiceParam::ForEachKVPair(keyValueList, [this, &handled](std::string_view key, std::string_view value) {
+        if (DispatchPair(IntellVoiceParam::InternKey(key), key, value)) {
+            ++handled;
+        }
+    });
+    return handled;
+}
+
+uint32_t ParamDispatcher::Dispatch(const ParamBatch &batch) const
+{
+    uint32_t handled = 0;
+    for (const auto &entry : batch.Entries()) {
+        if (DispatchPair(entry.first, IntellVoiceParam::KeyName(entry.first), entry.second)) {
+            ++handled;
+        }
+    }
+    return handled;
+}
+}
+}
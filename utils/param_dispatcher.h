@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef PARAM_DISPATCHER_H
+#define PARAM_DISPATCHER_H
+
+#include <array>
+#include <functional>
+#include "intell_voice_param.h"
+
+namespace OHOS {
+namespace IntellVoiceUtils {
+using ParamHandler = std::function<void(std::string_view value)>;
+using UnknownParamHandler = std::function<void(std::string_view key, std::string_view value)>;
+
+/*
+ * Table driven dispatch of parameters: handlers are indexed by interned key, pairs are handled in
+ * the order they appear. Keys without a handler go to the unknown handler if one is set.
+ */
+class ParamDispatcher {
+public:
+    ParamDispatcher() = default;
+    ~ParamDispatcher() = default;
+
+    ParamDispatcher &Register(ParamKey key, ParamHandler handler);
+    ParamDispatcher &SetUnknownHandler(UnknownParamHandler handler);
+    uint32_t Dispatch(std::string_view keyValueList) const;
+    uint32_t Dispatch(const ParamBatch &batch) const;
+
+private:
+    bool DispatchPair(ParamKey key, std::string_view keyName, std::string_view value) const;
+
+    std::array<ParamHandler, PARAM_KEY_NUM> handlers_;
+    UnknownParamHandler unknownHandler_ = nullptr;
+};
+}
+}
+#endif
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "slot_ring.h"
+#include "intell_voice_log.h"
+
+#define LOG_TAG "SlotRing"
+
+namespace OHOS {
+namespace IntellVoiceUtils {
+bool SlotRing::Init(uint32_t slotNum, size_t slotSize)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (slotNum == 0) {
+        INTELL_VOICE_LOG_ERROR("slot num is zero");
+        return false;
+    }
+
+    slots_.resize(slotNum + 1);
+    for (auto &slot : slots_) {
+        slot.clear();
+        slot.reserve(slotSize);
+    }
+    readIdx_ = 0;
+    writeIdx_ = 0;
+    count_ = 0;
+    droppedCount_ = 0;
+    isAvailable_ = true;
+    return true;
+}
+
+// the producer thread must be joined and no Borrow in flight, the slots are freed here
+void SlotRing::Uninit()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (droppedCount_ != 0) {
+            INTELL_VOICE_LOG_WARN("ring was full, dropped %{public}u frames", droppedCount_);
+        }
+        isAvailable_ = false;
+        std::vector<std::vector<uint8_t>>().swap(slots_);
+        count_ = 0;
+    }
+    cv_.notify_all();
+}
+
+std::vector<uint8_t> *SlotRing::AcquireWriteSlot()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!isAvailable_) {
+        return nullptr;
+    }
+
+    std::vector<uint8_t> *slot = &slots_[writeIdx_];
+    slot->clear();
+    return slot;
+}
+
+bool SlotRing::Commit()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!isAvailable_) {
+            return false;
+        }
+        // full: keep writing into the same slot, the frame just filled is dropped as the old queue did
+        if (count_ + 1 >= slots_.size()) {
+            ++droppedCount_;
+            return false;
+        }
+        writeIdx_ = (writeIdx_ + 1) % slots_.size();
+        ++count_;
+        ++commitSeq_;
+    }
+    cv_.notify_all();
+    return true;
+}
+
+bool SlotRing::Read(std::vector<uint8_t> &data, uint32_t timeoutMs)
+{
+    return Borrow(timeoutMs, [&data](const uint8_t *buffer, size_t size) {
+        data.insert(data.end(), buffer, buffer + size);
+    });
+}
+
+uint32_t SlotRing::GetCount()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return count_;
+}
+
+void SlotRing::WaitCommit(int64_t timeoutUs)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    uint64_t seq = commitSeq_;
+    cv_.wait_for(lock, std::chrono::microseconds(timeoutUs), [this, seq] {
+        return (commitSeq_ != seq) || !isAvailable_;
+    });
+}
+
+uint32_t SlotRing::GetDroppedCount()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return droppedCount_;
+}
+}
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef INTELL_VOICE_SLOT_RING_H
+#define INTELL_VOICE_SLOT_RING_H
+
+#include <cstdint>
+#include <vector>
+#include <mutex>
+#include <chrono>
+#include <condition_variable>
+#include "nocopyable.h"
+
+namespace OHOS {
+namespace IntellVoiceUtils {
+/*
+ * Single-producer/single-consumer ring of preallocated byte slots. The producer fills the slot
+ * returned by AcquireWriteSlot in place and publishes it with Commit; the consumer borrows the
+ * oldest slot without copying it out of the ring. Slots keep their capacity across laps, so once
+ * warmed up a frame costs no heap allocation.
+ */
+class SlotRing {
+public:
+    SlotRing() = default;
+    ~SlotRing() = default;
+
+    bool Init(uint32_t slotNum, size_t slotSize);
+    void Uninit();
+    std::vector<uint8_t> *AcquireWriteSlot();
+    bool Commit();
+    bool Read(std::vector<uint8_t> &data, uint32_t timeoutMs);
+    uint32_t GetDroppedCount();
+    uint32_t GetCount();
+    void WaitCommit(int64_t timeoutUs);
+
+    // calls func(const uint8_t *data, size_t size) on the oldest slot, then hands the slot back
+    template <typename Func>
+    bool Borrow(uint32_t timeoutMs, Func &&func)
+    {
+        const std::vector<uint8_t> *slot = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (!cv_.wait_for(lock, std::chrono::milliseconds(timeoutMs),
+                [this] { return (count_ != 0) || !isAvailable_; }) || !isAvailable_) {
+                return false;
+            }
+            slot = &slots_[readIdx_];
+        }
+
+        // the producer never writes a published slot, so the borrowed one is stable without the lock
+        func(slot->data(), slot->size());
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        readIdx_ = (readIdx_ + 1) % slots_.size();
+        --count_;
+        return true;
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool isAvailable_ = false;
+    // one spare slot so the producer always has a slot that no reader can see
+    std::vector<std::vector<uint8_t>> slots_;
+    size_t readIdx_ = 0;
+    size_t writeIdx_ = 0;
+    uint32_t count_ = 0;
+    uint32_t droppedCount_ = 0;
+    uint64_t commitSeq_ = 0;
+
+    DISALLOW_COPY(SlotRing);
+    DISALLOW_MOVE(SlotRing);
+};
+}
+}
+#endif
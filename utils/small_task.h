@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef INTELL_VOICE_SMALL_TASK_H
+#define INTELL_VOICE_SMALL_TASK_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace OHOS {
+namespace IntellVoiceUtils {
+/*
+ * Move-only void() callable. Callables up to INLINE_SIZE bytes (a few pointers plus a std::string)
+ * are stored in place, so queuing them does not touch the heap; larger ones fall back to new.
+ */
+class SmallTask {
+public:
+    static constexpr size_t INLINE_SIZE = 48;
+
+    SmallTask() = default;
+    template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, SmallTask>>>
+    SmallTask(F &&func) // NOLINT: implicit by design, mirrors std::function
+    {
+        using Fn = std::decay_t<F>;
+        if constexpr (IsInline<Fn>()) {
+            new (storage_) Fn(std::forward<F>(func));
+            ops_ = &INLINE_OPS<Fn>;
+        } else {
+            *reinterpret_cast<Fn **>(storage_) = new Fn(std::forward<F>(func));
+            ops_ = &HEAP_OPS<Fn>;
+        }
+    }
+    SmallTask(SmallTask &&other) noexcept
+    {
+        MoveFrom(other);
+    }
+    SmallTask &operator=(SmallTask &&other) noexcept
+    {
+        if (this != &other) {
+            Reset();
+            MoveFrom(other);
+        }
+        return *this;
+    }
+    ~SmallTask()
+    {
+        Reset();
+    }
+    SmallTask(const SmallTask &) = delete;
+    SmallTask &operator=(const SmallTask &) = delete;
+
+    explicit operator bool() const
+    {
+        return ops_ != nullptr;
+    }
+    void operator()()
+    {
+        ops_->invoke(storage_);
+    }
+    bool IsStoredInline() const
+    {
+        return (ops_ != nullptr) && ops_->isInline;
+    }
+    void Reset()
+    {
+        if (ops_ != nullptr) {
+            ops_->destroy(storage_);
+            ops_ = nullptr;
+        }
+    }
+
+private:
+    struct Ops {
+        void (*invoke)(void *storage);
+        void (*move)(void *dst, void *src);
+        void (*destroy)(void *storage);
+        bool isInline;
+    };
+
+    template <typename Fn>
+    static constexpr bool IsInline()
+    {
+        return (sizeof(Fn) <= INLINE_SIZE) && (alignof(Fn) <= alignof(std::max_align_t)) &&
+            std::is_nothrow_move_constructible_v<Fn>;
+    }
+
+    template <typename Fn>
+    static inline const Ops INLINE_OPS = {
+        [](void *storage) { (*static_cast<Fn *>(storage))(); },
+        [](void *dst, void *src) {
+            new (dst) Fn(std::move(*static_cast<Fn *>(src)));
+            static_cast<Fn *>(src)->~Fn();
+        },
+        [](void *storage) { static_cast<Fn *>(storage)->~Fn(); },
+        true,
+    };
+
+    template <typename Fn>
+    static inline const Ops HEAP_OPS = {
+        [](void *storage) { (**static_cast<Fn **>(storage))(); },
+        [](void *dst, void *src) { *static_cast<Fn **>(dst) = *static_cast<Fn **>(src); },
+        [](void *storage) { delete *static_cast<Fn **>(storage); },
+        false,
+    };
+
+    void MoveFrom(SmallTask &other)
+    {
+        if (other.ops_ != nullptr) {
+            other.ops_->move(storage_, other.storage_);
+            ops_ = other.ops_;
+            other.ops_ = nullptr;
+        }
+    }
+
+    alignas(std::max_align_t) unsigned char storage_[INLINE_SIZE] = {};
+    const Ops *ops_ = nullptr;
+};
+}
+}
+#endif
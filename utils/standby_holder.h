@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef INTELL_VOICE_STANDBY_HOLDER_H
+#define INTELL_VOICE_STANDBY_HOLDER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "nocopyable.h"
+
+namespace OHOS {
+namespace IntellVoiceUtils {
+/*
+ * Keeps one idle, already configured object for a grace period so that the next user with the same
+ * key can take it instead of building a new one. Whatever is not taken in time, is parked under
+ * another key, or is flushed goes to the release function, always outside the lock. Expiry is
+ * handled by a reaper thread that only runs while something is parked.
+ */
+template <typename T>
+class StandbyHolder {
+public:
+    using ReleaseFunc = std::function<void(std::unique_ptr<T> item)>;
+
+    explicit StandbyHolder(ReleaseFunc releaseFunc) : releaseFunc_(std::move(releaseFunc)) {}
+    ~StandbyHolder()
+    {
+        Flush();
+        std::thread reaper;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            isStopping_ = true;
+            reaper = std::move(reaper_);
+        }
+        cv_.notify_all();
+        if (reaper.joinable()) {
+            reaper.join();
+        }
+    }
+
+    void Park(std::unique_ptr<T> item, const std::string &key, uint32_t graceMs)
+    {
+        if (item == nullptr) {
+            return;
+        }
+        if (graceMs == 0) {
+            Release(std::move(item));
+            return;
+        }
+
+        std::unique_ptr<T> old = nullptr;
+        std::thread finished;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            old = std::move(item_);
+            item_ = std::move(item);
+            key_ = key;
+            deadline_ = std::chrono::steady_clock::now() + std::chrono::milliseconds(graceMs);
+            if (!isReaperRunning_) {
+                // the previous reaper has left its loop, reap it before starting a new one
+                finished = std::move(reaper_);
+                isReaperRunning_ = true;
+                reaper_ = std::thread(&StandbyHolder::ReapLoop, this);
+            }
+        }
+        cv_.notify_all();
+        if (finished.joinable()) {
+            finished.join();
+        }
+        Release(std::move(old));
+    }
+
+    // nullptr when nothing matching is parked, a parked object with another key is released
+    std::unique_ptr<T> Take(const std::string &key)
+    {
+        std::unique_ptr<T> item = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            item = std::move(item_);
+            if ((item == nullptr) || (key_ == key)) {
+                cv_.notify_all();
+                return item;
+            }
+        }
+        cv_.notify_all();
+        Release(std::move(item));
+        return nullptr;
+    }
+
+    void Flush()
+    {
+        std::unique_ptr<T> item = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            item = std::move(item_);
+        }
+        cv_.notify_all();
+        Release(std::move(item));
+    }
+
+    bool IsParked()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return item_ != nullptr;
+    }
+
+private:
+    void Release(std::unique_ptr<T> item)
+    {
+        if ((item != nullptr) && (releaseFunc_ != nullptr)) {
+            releaseFunc_(std::move(item));
+        }
+    }
+
+    void ReapLoop()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!isStopping_ && (item_ != nullptr)) {
+            if (cv_.wait_until(lock, deadline_) != std::cv_status::timeout) {
+                continue;
+            }
+            if ((item_ == nullptr) || (std::chrono::steady_clock::now() < deadline_)) {
+                continue;
+            }
+            std::unique_ptr<T> expired = std::move(item_);
+            lock.unlock();
+            Release(std::move(expired));
+            lock.lock();
+        }
+        isReaperRunning_ = false;
+    }
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    ReleaseFunc releaseFunc_;
+    std::unique_ptr<T> item_ = nullptr;
+    std::string key_;
+    std::chrono::steady_clock::time_point deadline_;
+    std::thread reaper_;
+    bool isReaperRunning_ = false;
+    bool isStopping_ = false;
+
+    DISALLOW_COPY(StandbyHolder);
+    DISALLOW_MOVE(StandbyHolder);
+};
+}
+}
+#endif
@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "startup_scheduler.h"
+
+#include <ctime>
+#include <chrono>
+#include "intell_voice_log.h"
+
+#define LOG_TAG "StartupScheduler"
+
+namespace OHOS {
+namespace IntellVoiceUtils {
+static constexpr int64_t US_PER_MS_VALUE = 1000;
+static constexpr int64_t US_PER_S_VALUE = 1000000;
+static constexpr int64_t NS_PER_US_VALUE = 1000;
+
+StartupScheduler::StartupScheduler(const std::string &name) : name_(name)
+{
+    createUs_ = NowTimeUs();
+}
+
+StartupScheduler::~StartupScheduler()
+{
+    Join();
+}
+
+int64_t StartupScheduler::NowTimeUs()
+{
+    struct timespec t;
+    if (clock_gettime(CLOCK_MONOTONIC, &t) < 0) {
+        return 0;
+    }
+    return t.tv_sec * US_PER_S_VALUE + t.tv_nsec / NS_PER_US_VALUE;
+}
+
+bool StartupScheduler::AddStage(const std::string &name, const std::vector<std::string> &deps,
+    std::function<void()> func, bool isInline)
+{
+    std::vector<std::string> inlineStages;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (func == nullptr) {
+            INTELL_VOICE_LOG_ERROR("func of stage %{public}s is nullptr", name.c_str());
+            return false;
+        }
+
+        if (stages_.count(name) != 0) {
+            INTELL_VOICE_LOG_ERROR("stage %{public}s already exists", name.c_str());
+            return false;
+        }
+
+        for (const auto &dep : deps) {
+            if (stages_.count(dep) == 0) {
+                INTELL_VOICE_LOG_ERROR("dependency %{public}s of stage %{public}s is not added", dep.c_str(),
+                    name.c_str());
+                return false;
+            }
+        }
+
+        Stage &stage = stages_[name];
+        stage.func = std::move(func);
+        stage.isInline = isInline;
+        for (const auto &dep : deps) {
+            if (stages_[dep].state != StageState::STAGE_DONE) {
+                stages_[dep].dependents.push_back(name);
+                stage.pendingDeps++;
+            }
+        }
+
+        if (stage.pendingDeps == 0) {
+            DispatchLocked(name, inlineStages);
+        }
+    }
+
+    RunInlineStages(inlineStages);
+    return true;
+}
+
+void StartupScheduler::DispatchLocked(const std::string &name, std::vector<std::string> &inlineStages)
+{
+    Stage &stage = stages_[name];
+    stage.state = StageState::STAGE_RUNNING;
+    stage.startUs = NowTimeUs();
+    stage.startSeq = seq_++;
+    // inline stages are run by the caller once the lock is released
+    if (stage.isInline) {
+        inlineStages.push_back(name);
+        return;
+    }
+    threads_.emplace_back(&StartupScheduler::RunStage, this, name);
+}
+
+void StartupScheduler::RunInlineStages(const std::vector<std::string> &inlineStages)
+{
+    for (const auto &name : inlineStages) {
+        RunStage(name);
+    }
+}
+
+void StartupScheduler::RunStage(const std::string &name)
+{
+    std::function<void()> func;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        func = std::move(stages_[name].func);
+    }
+
+    func();
+
+    std::vector<std::string> inlineStages;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Stage &stage = stages_[name];
+        stage.state = StageState::STAGE_DONE;
+        stage.endUs = NowTimeUs();
+        stage.doneSeq = seq_++;
+        INTELL_VOICE_LOG_INFO("%{public}s stage %{public}s done, start:%{public}lld ms, cost:%{public}lld ms",
+            name_.c_str(), name.c_str(), static_cast<long long>((stage.startUs - createUs_) / US_PER_MS_VALUE),
+            static_cast<long long>((stage.endUs - stage.startUs) / US_PER_MS_VALUE));
+
+        for (const auto &dependent : stage.dependents) {
+            auto it = stages_.find(dependent);
+            if (it == stages_.end() || it->second.pendingDeps == 0) {
+                continue;
+            }
+            if (--it->second.pendingDeps == 0) {
+                DispatchLocked(dependent, inlineStages);
+            }
+        }
+        stage.dependents.clear();
+        cv_.notify_all();
+    }
+
+    RunInlineStages(inlineStages);
+}
+
+bool StartupScheduler::WaitStage(const std::string &name, uint32_t timeoutMs)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (stages_.count(name) == 0) {
+        INTELL_VOICE_LOG_WARN("stage %{public}s is not added", name.c_str());
+        return false;
+    }
+
+    if (!cv_.wait_for(lock, std::chrono::milliseconds(timeoutMs),
+        [this, &name] { return stages_[name].state == StageState::STAGE_DONE; })) {
+        INTELL_VOICE_LOG_WARN("wait stage %{public}s time out", name.c_str());
+        return false;
+    }
+    return true;
+}
+
+void StartupScheduler::Join()
+{
+    while (true) {
+        std::vector<std::thread> threads;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (threads_.empty()) {
+                break;
+            }
+            threads.swap(threads_);
+        }
+
+        for (auto &thread : threads) {
+            if (thread.joinable()) {
+                thread.join();
+            }
+        }
+    }
+}
+
+void StartupScheduler::Clear()
+{
+    Join();
+    std::lock_guard<std::mutex> lock(mutex_);
+    stages_.clear();
+    createUs_ = NowTimeUs();
+    seq_ = 0;
+}
+
+std::map<std::string, StageCost> StartupScheduler::GetStageCosts()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::map<std::string, StageCost> costs;
+    for (const auto &it : stages_) {
+        if (it.second.state != StageState::STAGE_DONE) {
+            continue;
+        }
+        costs[it.first].startOffsetMs = (it.second.startUs - createUs_) / US_PER_MS_VALUE;
+        costs[it.first].costMs = (it.second.endUs - it.second.startUs) / US_PER_MS_VALUE;
+        costs[it.first].startSeq = it.second.startSeq;
+        costs[it.first].doneSeq = it.second.doneSeq;
+    }
+    return costs;
+}
+}
+}
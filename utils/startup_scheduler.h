@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef STARTUP_SCHEDULER_H
+#define STARTUP_SCHEDULER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <functional>
+#include <condition_variable>
+#include "nocopyable.h"
+
+namespace OHOS {
+namespace IntellVoiceUtils {
+enum class StageState {
+    STAGE_PENDING = 0,
+    STAGE_RUNNING,
+    STAGE_DONE,
+};
+
+struct StageCost {
+    int64_t startOffsetMs = 0;
+    int64_t costMs = 0;
+    // position of the stage start and end among all start and end events of the scheduler
+    uint32_t startSeq = 0;
+    uint32_t doneSeq = 0;
+};
+
+/*
+ * Runs startup stages as a dependency graph: a stage is dispatched on its own thread as soon as
+ * all of its dependencies are done, so independent stages run concurrently. An inline stage runs on
+ * the thread that makes it ready instead, which suits stages that return at once.
+ * Dependencies must be added before the stages that use them, which keeps the graph acyclic.
+ */
+class StartupScheduler {
+public:
+    explicit StartupScheduler(const std::string &name);
+    ~StartupScheduler();
+
+    bool AddStage(const std::string &name, const std::vector<std::string> &deps, std::function<void()> func,
+        bool isInline = false);
+    bool WaitStage(const std::string &name, uint32_t timeoutMs);
+    void Join();
+    void Clear();
+    std::map<std::string, StageCost> GetStageCosts();
+
+private:
+    struct Stage {
+        StageState state = StageState::STAGE_PENDING;
+        bool isInline = false;
+        uint32_t pendingDeps = 0;
+        std::vector<std::string> dependents;
+        std::function<void()> func;
+        int64_t startUs = 0;
+        int64_t endUs = 0;
+        uint32_t startSeq = 0;
+        uint32_t doneSeq = 0;
+    };
+
+    void DispatchLocked(const std::string &name, std::vector<std::string> &inlineStages);
+    void RunStage(const std::string &name);
+    void RunInlineStages(const std::vector<std::string> &inlineStages);
+    static int64_t NowTimeUs();
+
+private:
+    std::string name_;
+    int64_t createUs_ = 0;
+    uint32_t seq_ = 0;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::map<std::string, Stage> stages_;
+    std::vector<std::thread> threads_;
+
+    DISALLOW_COPY(StartupScheduler);
+    DISALLOW_MOVE(StartupScheduler);
+};
+}
+}
+#endif
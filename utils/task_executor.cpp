@@ -14,20 +14,120 @@
  */
 #include "task_executor.h"
 #include <sys/prctl.h>
+#include <algorithm>
+#include <set>
+#include <sstream>
+#include <exception>
 #include "intell_voice_log.h"
+#include "hot_log.h"
 
 #define LOG_TAG "TaskExecutor"
 
 namespace OHOS {
 namespace IntellVoiceUtils {
+static constexpr uint32_t HIGH_PRIORITY_CAPACITY = 32;
+static constexpr uint32_t INIT_LANE_SIZE = 16;
+static constexpr uint32_t PERCENT_50 = 50;
+static constexpr uint32_t PERCENT_90 = 90;
+static constexpr uint32_t PERCENT_99 = 99;
+static constexpr uint32_t PERCENT_100 = 100;
+static constexpr uint32_t SLOW_TASK_LOG_INTERVAL_MS = 1000;
+static constexpr int64_t SLOW_TASK_US = 100 * 1000;
+
+static std::mutex &GetRegistryMutex()
+{
+    static std::mutex registryMutex;
+    return registryMutex;
+}
+
+static std::set<TaskExecutor *> &GetRegistry()
+{
+    static std::set<TaskExecutor *> registry;
+    return registry;
+}
+
+void LatencyHistogram::Record(int64_t us)
+{
+    // bucket i holds values in [2^(i - 1), 2^i) us, bucket 0 holds values below 1 us
+    uint32_t bucket = 0;
+    uint64_t value = (us > 0) ? static_cast<uint64_t>(us) : 0;
+    while ((value != 0) && (bucket < BUCKET_NUM - 1)) {
+        value >>= 1;
+        bucket++;
+    }
+    buckets_[bucket]++;
+    count_++;
+}
+
+int64_t LatencyHistogram::Percentile(uint32_t percent) const
+{
+    if (count_ == 0) {
+        return 0;
+    }
+
+    uint64_t target = (count_ * percent + PERCENT_100 - 1) / PERCENT_100;
+    uint64_t sum = 0;
+    for (uint32_t i = 0; i < BUCKET_NUM; i++) {
+        sum += buckets_[i];
+        if (sum >= target) {
+            return static_cast<int64_t>(1) << i;
+        }
+    }
+    return static_cast<int64_t>(1) << (BUCKET_NUM - 1);
+}
+
+void TaskExecutor::TaskLane::Push(QueuedTask &&task)
+{
+    if (size_ == ring_.size()) {
+        uint32_t newSize = ring_.empty() ? std::min(INIT_LANE_SIZE, capacity_) :
+            std::min(static_cast<uint32_t>(ring_.size()) * 2, capacity_);
+        std::vector<QueuedTask> ring(newSize);
+        for (uint32_t i = 0; i < size_; i++) {
+            ring[i] = std::move(ring_[(head_ + i) % ring_.size()]);
+        }
+        ring_.swap(ring);
+        head_ = 0;
+    }
+    ring_[(head_ + size_) % ring_.size()] = std::move(task);
+    size_++;
+}
+
+TaskExecutor::QueuedTask TaskExecutor::TaskLane::Pop()
+{
+    QueuedTask task = std::move(ring_[head_]);
+    head_ = (head_ + 1) % ring_.size();
+    size_--;
+    return task;
+}
+
+void TaskExecutor::TaskLane::Clear()
+{
+    while (size_ != 0) {
+        ring_[head_].task.Reset();
+        head_ = (head_ + 1) % ring_.size();
+        size_--;
+    }
+}
+
 TaskExecutor::TaskExecutor(const std::string &threadName, uint32_t capacity) : threadName_(threadName)
 {
     INTELL_VOICE_LOG_INFO("constructor, thread name:%{public}s, capacity:%{public}u", threadName_.c_str(), capacity);
-    Init(capacity);
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        lanes_[static_cast<uint32_t>(TaskPriority::HIGH)].SetCapacity(HIGH_PRIORITY_CAPACITY);
+        lanes_[static_cast<uint32_t>(TaskPriority::NORMAL)].SetCapacity(capacity);
+        isAvailable_ = true;
+    }
+    std::lock_guard<std::mutex> lock(GetRegistryMutex());
+    GetRegistry().insert(this);
 }
 
 TaskExecutor::~TaskExecutor()
 {
+    {
+        std::lock_guard<std::mutex> lock(GetRegistryMutex());
+        GetRegistry().erase(this);
+    }
     StopThread();
     INTELL_VOICE_LOG_INFO("destructor, thread name:%{public}s", threadName_.c_str());
 }
@@ -60,6 +160,135 @@ void TaskExecutor::StopThread()
     INTELL_VOICE_LOG_INFO("exit");
 }
 
+int64_t TaskExecutor::NowTimeUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool TaskExecutor::Push(SmallTask &&task, bool isWait, TaskPriority priority)
+{
+    uint32_t index = static_cast<uint32_t>(priority);
+    if (index >= TASK_PRIORITY_NUM) {
+        INTELL_VOICE_LOG_ERROR("invalid priority:%{public}u", index);
+        return false;
+    }
+
+    std::unique_lock<std::mutex> lock(queueMutex_);
+    CHECK_CONDITION_RETURN_FALSE(!isAvailable_, "queue is not available");
+
+    TaskLane &lane = lanes_[index];
+    while (lane.IsFull()) {
+        if (!isWait) {
+            dropped_[index]++;
+            return false;
+        }
+        notFullCv_.wait(lock, [&]() { return (!lane.IsFull() || !isAvailable_); });
+        CHECK_CONDITION_RETURN_FALSE(!isAvailable_, "queue is not available");
+    }
+
+    lane.Push({ std::move(task), NowTimeUs() });
+    if (lane.Size() > highWater_[index]) {
+        highWater_[index] = lane.Size();
+    }
+    notEmptyCv_.notify_one();
+    return true;
+}
+
+bool TaskExecutor::Pop(QueuedTask &task)
+{
+    std::unique_lock<std::mutex> lock(queueMutex_);
+    auto hasTask = [this]() {
+        for (const auto &lane : lanes_) {
+            if (!lane.IsEmpty()) {
+                return true;
+            }
+        }
+        return false;
+    };
+    notEmptyCv_.wait(lock, [&] { return (hasTask() || !isAvailable_); });
+    CHECK_CONDITION_RETURN_FALSE(!isAvailable_, "queue is not available");
+
+    for (auto &lane : lanes_) {
+        if (!lane.IsEmpty()) {
+            task = lane.Pop();
+            break;
+        }
+    }
+    // waiters of different lanes share the cv
+    notFullCv_.notify_all();
+    return true;
+}
+
+void TaskExecutor::Uninit()
+{
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        for (auto &lane : lanes_) {
+            lane.Clear();
+            lane.SetCapacity(0);
+        }
+        isAvailable_ = false;
+    }
+    notEmptyCv_.notify_all();
+    notFullCv_.notify_all();
+}
+
+void TaskExecutor::OnSyncTimeout(uint32_t timeoutMs)
+{
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        syncTimeoutCnt_++;
+    }
+    INTELL_VOICE_LOG_WARN("%{public}s sync task time out, timeout:%{public}u ms", threadName_.c_str(), timeoutMs);
+}
+
+TaskExecutorMetrics TaskExecutor::GetMetrics()
+{
+    std::lock_guard<std::mutex> lock(queueMutex_);
+    TaskExecutorMetrics metrics;
+    for (uint32_t i = 0; i < TASK_PRIORITY_NUM; i++) {
+        metrics.queueDepth[i] = lanes_[i].Size();
+    }
+    metrics.highWater = highWater_;
+    metrics.dropped = dropped_;
+    metrics.executedCnt = executedCnt_;
+    metrics.syncTimeoutCnt = syncTimeoutCnt_;
+    metrics.waitP50Us = waitHist_.Percentile(PERCENT_50);
+    metrics.waitP90Us = waitHist_.Percentile(PERCENT_90);
+    metrics.waitP99Us = waitHist_.Percentile(PERCENT_99);
+    metrics.runP50Us = runHist_.Percentile(PERCENT_50);
+    metrics.runP90Us = runHist_.Percentile(PERCENT_90);
+    metrics.runP99Us = runHist_.Percentile(PERCENT_99);
+    return metrics;
+}
+
+std::string TaskExecutor::DumpMetrics()
+{
+    TaskExecutorMetrics metrics = GetMetrics();
+    uint32_t high = static_cast<uint32_t>(TaskPriority::HIGH);
+    uint32_t normal = static_cast<uint32_t>(TaskPriority::NORMAL);
+    std::ostringstream oss;
+    oss << threadName_ << ": executed:" << metrics.executedCnt << ", sync timeout:" << metrics.syncTimeoutCnt
+        << "\n  depth(high/normal):" << metrics.queueDepth[high] << "/" << metrics.queueDepth[normal]
+        << ", high water:" << metrics.highWater[high] << "/" << metrics.highWater[normal]
+        << ", dropped:" << metrics.dropped[high] << "/" << metrics.dropped[normal]
+        << "\n  wait us(p50/p90/p99):" << metrics.waitP50Us << "/" << metrics.waitP90Us << "/" << metrics.waitP99Us
+        << ", run us(p50/p90/p99):" << metrics.runP50Us << "/" << metrics.runP90Us << "/" << metrics.runP99Us
+        << "\n";
+    return oss.str();
+}
+
+std::string TaskExecutor::DumpAllMetrics()
+{
+    std::lock_guard<std::mutex> lock(GetRegistryMutex());
+    std::string info;
+    for (auto executor : GetRegistry()) {
+        info += executor->DumpMetrics();
+    }
+    return info;
+}
+
 void *TaskExecutor::ExecuteInThread(void *arg)
 {
     TaskExecutor *executor = static_cast<TaskExecutor *>(arg);
@@ -69,14 +298,33 @@ void *TaskExecutor::ExecuteInThread(void *arg)
     }
     prctl(PR_SET_NAME, reinterpret_cast<unsigned long>(executor->threadName_.c_str()), 0, 0, 0);
     do {
-        std::function<void()> task;
+        QueuedTask task;
         if (!executor->Pop(task)) {
             INTELL_VOICE_LOG_INFO("no task needed to execute");
             break;
         }
-        task();
+        int64_t startUs = NowTimeUs();
+        try {
+            task.task();
+        } catch (const std::exception &e) {
+            INTELL_VOICE_LOG_ERROR("task throws exception:%{public}s", e.what());
+        } catch (...) {
+            INTELL_VOICE_LOG_ERROR("task throws unknown exception");
+        }
+        int64_t endUs = NowTimeUs();
+        // release captures before taking the lock, their destructors may post new tasks
+        task.task.Reset();
+
+        if (endUs - startUs > SLOW_TASK_US) {
+            INTELL_VOICE_LOG_WARN_LIMIT(SLOW_TASK_LOG_INTERVAL_MS, "%{public}s slow task, run:%{public}lld us",
+                executor->threadName_.c_str(), static_cast<long long>(endUs - startUs));
+        }
+        std::lock_guard<std::mutex> lock(executor->queueMutex_);
+        executor->waitHist_.Record(startUs - task.enqueueUs);
+        executor->runHist_.Record(endUs - startUs);
+        executor->executedCnt_++;
     } while (1);
     return nullptr;
 }
 }
-}
\ No newline at end of file
+}
@@ -19,27 +19,80 @@
 #include <memory>
 #include <functional>
 #include <future>
+#include <optional>
+#include <array>
+#include <vector>
+#include <condition_variable>
 #include <pthread.h>
 #include <sys/types.h>
 #include <string>
-#include "queue_util.h"
+#include "small_task.h"
+#include "intell_voice_log.h"
 
 #define LOG_TAG "TaskExecutor"
 
 namespace OHOS {
 namespace IntellVoiceUtils {
-class TaskExecutor : private QueueUtil<std::function<void()>> {
+enum class TaskPriority : uint32_t {
+    HIGH = 0,
+    NORMAL,
+    PRIORITY_NUM,
+};
+
+constexpr uint32_t TASK_PRIORITY_NUM = static_cast<uint32_t>(TaskPriority::PRIORITY_NUM);
+
+class LatencyHistogram {
+public:
+    static constexpr uint32_t BUCKET_NUM = 32;
+
+    void Record(int64_t us);
+    int64_t Percentile(uint32_t percent) const;
+    uint64_t Count() const
+    {
+        return count_;
+    }
+
+private:
+    std::array<uint64_t, BUCKET_NUM> buckets_ {};
+    uint64_t count_ = 0;
+};
+
+struct TaskExecutorMetrics {
+    std::array<uint32_t, TASK_PRIORITY_NUM> queueDepth {};
+    std::array<uint32_t, TASK_PRIORITY_NUM> highWater {};
+    std::array<uint64_t, TASK_PRIORITY_NUM> dropped {};
+    uint64_t executedCnt = 0;
+    uint64_t syncTimeoutCnt = 0;
+    int64_t waitP50Us = 0;
+    int64_t waitP90Us = 0;
+    int64_t waitP99Us = 0;
+    int64_t runP50Us = 0;
+    int64_t runP90Us = 0;
+    int64_t runP99Us = 0;
+};
+
+/*
+ * Single thread executor with a HIGH and a NORMAL lane. HIGH tasks (engine callbacks such as
+ * RECOGNIZE_COMPLETE) run before any queued NORMAL work and have their own capacity, so bulk work
+ * can neither delay nor drop them.
+ */
+class TaskExecutor {
 public:
     TaskExecutor(const std::string &threadName, uint32_t capacity);
     ~TaskExecutor();
     void StartThread();
     void StopThread();
+    TaskExecutorMetrics GetMetrics();
+    std::string DumpMetrics();
+    static std::string DumpAllMetrics();
+
     template <typename F>
-    void AddAsyncTask(F &&func, const std::string &desc = "", bool isWait = true)
+    void AddAsyncTask(F &&func, const std::string &desc = "", bool isWait = true,
+        TaskPriority priority = TaskPriority::NORMAL)
     {
-        auto task = std::make_shared<std::packaged_task<void()>>(std::forward<F>(func));
-        if (!Push([task]() { (*task)(); }, isWait)) {
-            INTELL_VOICE_LOG_ERROR("failed to push task, desc:%{public}s, isWait:%{public}d", desc.c_str(), isWait);
+        if (!Push(SmallTask(std::forward<F>(func)), isWait, priority)) {
+            INTELL_VOICE_LOG_ERROR("failed to push task, desc:%{public}s, isWait:%{public}d, priority:%{public}u",
+                desc.c_str(), isWait, static_cast<uint32_t>(priority));
         }
     }
     template <typename F, typename... Args>
@@ -48,13 +101,70 @@ public:
         auto task = std::make_shared<std::packaged_task<decltype(func(args...))()>>(std::bind(
             std::forward<F>(func), std::forward<Args>(args)...));
         auto ret = task->get_future();
-        Push([task]() { (*task)(); });
+        Push(SmallTask([task]() { (*task)(); }), true, TaskPriority::NORMAL);
 
         ret.wait();
         return ret.get();
     }
+    // returns nullopt if the task could not be queued or did not finish in time, the task still runs later
+    template <typename F>
+    auto AddSyncTaskWithTimeout(uint32_t timeoutMs, F &&func) -> std::optional<decltype(func())>
+    {
+        auto task = std::make_shared<std::packaged_task<decltype(func())()>>(std::forward<F>(func));
+        auto ret = task->get_future();
+        if (!Push(SmallTask([task]() { (*task)(); }), false, TaskPriority::NORMAL)) {
+            INTELL_VOICE_LOG_ERROR("failed to push sync task");
+            return std::nullopt;
+        }
+
+        if (ret.wait_for(std::chrono::milliseconds(timeoutMs)) != std::future_status::ready) {
+            OnSyncTimeout(timeoutMs);
+            return std::nullopt;
+        }
+        return ret.get();
+    }
 
 private:
+    struct QueuedTask {
+        SmallTask task;
+        int64_t enqueueUs = 0;
+    };
+
+    // ring of queued tasks, grows on demand up to its capacity and never shrinks
+    class TaskLane {
+    public:
+        void SetCapacity(uint32_t capacity)
+        {
+            capacity_ = capacity;
+        }
+        bool IsFull() const
+        {
+            return size_ >= capacity_;
+        }
+        bool IsEmpty() const
+        {
+            return size_ == 0;
+        }
+        uint32_t Size() const
+        {
+            return size_;
+        }
+        void Push(QueuedTask &&task);
+        QueuedTask Pop();
+        void Clear();
+
+    private:
+        std::vector<QueuedTask> ring_;
+        uint32_t head_ = 0;
+        uint32_t size_ = 0;
+        uint32_t capacity_ = 0;
+    };
+
+    bool Push(SmallTask &&task, bool isWait, TaskPriority priority);
+    bool Pop(QueuedTask &task);
+    void Uninit();
+    void OnSyncTimeout(uint32_t timeoutMs);
+    static int64_t NowTimeUs();
     static void *ExecuteInThread(void *arg);
 
 private:
@@ -62,10 +172,22 @@ private:
     std::string threadName_;
     pthread_t tid_ = 0;
     bool isRuning_ = false;
+
+    std::mutex queueMutex_;
+    std::condition_variable notEmptyCv_;
+    std::condition_variable notFullCv_;
+    bool isAvailable_ = false;
+    std::array<TaskLane, TASK_PRIORITY_NUM> lanes_;
+    std::array<uint32_t, TASK_PRIORITY_NUM> highWater_ {};
+    std::array<uint64_t, TASK_PRIORITY_NUM> dropped_ {};
+    uint64_t executedCnt_ = 0;
+    uint64_t syncTimeoutCnt_ = 0;
+    LatencyHistogram waitHist_;
+    LatencyHistogram runHist_;
 };
 }
 }
 
 #undef LOG_TAG
 
-#endif
\ No newline at end of file
+#endif
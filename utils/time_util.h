@@ -60,6 +60,7 @@ public:
     static void TimeElapse(const timespec &start, const timespec &end);
     static long TimeElapseUs(const timespec &start, const timespec &end);
     static uint64_t GetCurrentTimeMs();
+    static int64_t GetMonotonicTimeUs();
 };
 
 inline void TimeUtil::GetTime(timespec &start)
@@ -95,6 +96,16 @@ inline long TimeUtil::TimeElapseUs(const timespec &start, const timespec &end)
     long usecs = MS_PER_US * S_PER_MS * (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / US_PER_NS;
     return usecs;
 }
+
+// CLOCK_MONOTONIC is system wide, so stamps taken in the service can be compared with the client's
+inline int64_t TimeUtil::GetMonotonicTimeUs()
+{
+    timespec current = { 0, 0 };
+    if (clock_gettime(CLOCK_MONOTONIC, &current) == -1) {
+        return 0;
+    }
+    return static_cast<int64_t>(current.tv_sec) * MS_PER_US * S_PER_MS + current.tv_nsec / US_PER_NS;
+}
 }
 }
 
@@ -18,6 +18,7 @@
 #include <sys/time.h>
 #include <sstream>
 #include "intell_voice_log.h"
+#include "hot_log.h"
 
 #define LOG_TAG "TimerMgr"
 
@@ -153,9 +154,9 @@ int TimerMgr::SetTimer(int type, int64_t delayUs, int cookie, ITimerObserver *cu
         cv_.notify_one();
     }
 
-    ostringstream oss;
-    oss << "set timer id " << id << " type " << type << " delay " << delayUs << " cookie " << cookie << " time ";
-    LogTime(oss.str());
+    INTELL_VOICE_HOT_LOG_DEBUG("set timer id %{public}d type %{public}d delay %{public}lld cookie %{public}d", id,
+        type, static_cast<long long>(delayUs), cookie);
+    INTELL_VOICE_HOT_RECORD("set_timer", id, type, delayUs, cookie);
 
     return id;
 }
@@ -164,6 +165,10 @@ int TimerMgr::ResetTimer(int timerId, int type, int64_t delayUs, int cookie, ITi
 {
     {
         std::unique_lock<ffrt::mutex> lock(timeMutex_);
+        if (!IsAllocated(timerId)) {
+            INTELL_VOICE_LOG_WARN("timer id:%{public}d is stale, no need to reset", timerId);
+            return INVALID_ID;
+        }
         if (itemQueue_.size() == 1) {
             auto it = itemQueue_.begin();
             if ((*it)->timerId != timerId) {
@@ -184,6 +189,11 @@ void TimerMgr::KillTimer(int &timerId)
 {
     std::unique_lock<ffrt::mutex> lock(timeMutex_);
     INTELL_VOICE_LOG_INFO("kill timer %{public}d", timerId);
+    if (!IsAllocated(timerId)) {
+        INTELL_VOICE_LOG_WARN("timer id:%{public}d is stale, no need to kill", timerId);
+        timerId = INVALID_ID;
+        return;
+    }
     for (auto it = itemQueue_.begin(); it != itemQueue_.end(); it++) {
         shared_ptr<TimerItem> curItem = *it;
         if (curItem->timerId == timerId) {
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "worker_pool.h"
+
+#include <ctime>
+#include "intell_voice_log.h"
+
+#define LOG_TAG "WorkerPool"
+
+namespace OHOS {
+namespace IntellVoiceUtils {
+static constexpr uint32_t WORKER_NUM = 2;
+static constexpr uint32_t MAX_TASK_NUM = 32;
+static constexpr int64_t US_PER_S_VALUE = 1000000;
+static constexpr int64_t NS_PER_US_VALUE = 1000;
+
+WorkerPool &WorkerPool::GetInstance()
+{
+    static WorkerPool instance;
+    return instance;
+}
+
+WorkerPool::~WorkerPool()
+{
+    Shutdown();
+}
+
+int64_t WorkerPool::NowTimeUs()
+{
+    struct timespec t;
+    if (clock_gettime(CLOCK_MONOTONIC, &t) < 0) {
+        return 0;
+    }
+    return t.tv_sec * US_PER_S_VALUE + t.tv_nsec / NS_PER_US_VALUE;
+}
+
+bool WorkerPool::Submit(const std::string &name, std::function<void()> func)
+{
+    if (func == nullptr) {
+        INTELL_VOICE_LOG_ERROR("func of task %{public}s is nullptr", name.c_str());
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (tasks_.size() >= MAX_TASK_NUM) {
+            stats_.rejectedCnt++;
+            INTELL_VOICE_LOG_ERROR("queue is full, reject task %{public}s", name.c_str());
+            return false;
+        }
+        if (!isRunning_) {
+            StartLocked();
+        }
+        tasks_.push_back({ name, std::move(func), NowTimeUs() });
+        uint32_t depth = static_cast<uint32_t>(tasks_.size());
+        if (depth > stats_.peakQueueDepth) {
+            stats_.peakQueueDepth = depth;
+        }
+    }
+    cv_.notify_one();
+    return true;
+}
+
+void WorkerPool::StartLocked()
+{
+    isRunning_ = true;
+    for (uint32_t i = 0; i < WORKER_NUM; i++) {
+        workers_.emplace_back(&WorkerPool::Run, this);
+    }
+}
+
+void WorkerPool::Run()
+{
+    while (true) {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] { return !isRunning_ || !tasks_.empty(); });
+            if (!isRunning_) {
+                return;
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+            int64_t waitUs = NowTimeUs() - task.enqueueUs;
+            totalWaitUs_ += waitUs;
+            if (waitUs > stats_.maxWaitUs) {
+                stats_.maxWaitUs = waitUs;
+            }
+        }
+
+        int64_t startUs = NowTimeUs();
+        task.func();
+        int64_t runUs = NowTimeUs() - startUs;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.executedCnt++;
+        if (runUs > stats_.maxRunUs) {
+            stats_.maxRunUs = runUs;
+        }
+    }
+}
+
+void WorkerPool::Shutdown()
+{
+    std::vector<std::thread> workers;
+    std::deque<Task> pendingTasks;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!isRunning_) {
+            return;
+        }
+        isRunning_ = false;
+        pendingTasks.swap(tasks_);
+        workers.swap(workers_);
+    }
+    cv_.notify_all();
+
+    // a submitted task is never lost, whatever is still queued runs in order on a detached thread
+    if (!pendingTasks.empty()) {
+        INTELL_VOICE_LOG_WARN("hand %{public}zu pending tasks to a detached thread", pendingTasks.size());
+        std::thread([tasks = std::move(pendingTasks)]() {
+            for (const auto &task : tasks) {
+                task.func();
+            }
+        }).detach();
+    }
+
+    // running tasks are allowed to finish
+    for (auto &worker : workers) {
+        if (worker.get_id() == std::this_thread::get_id()) {
+            // shutdown from inside a task, the worker exits by itself once the task returns
+            worker.detach();
+            continue;
+        }
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    DumpStats();
+}
+
+WorkerPoolStats WorkerPool::GetStats()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    WorkerPoolStats stats = stats_;
+    stats.queueDepth = static_cast<uint32_t>(tasks_.size());
+    if (stats.executedCnt != 0) {
+        stats.avgWaitUs = totalWaitUs_ / static_cast<int64_t>(stats.executedCnt);
+    }
+    return stats;
+}
+
+void WorkerPool::DumpStats()
+{
+    WorkerPoolStats stats = GetStats();
+    INTELL_VOICE_LOG_INFO("depth:%{public}u, peak:%{public}u, executed:%{public}llu, rejected:%{public}llu, "
+        "avg wait:%{public}lld us, max wait:%{public}lld us, max run:%{public}lld us", stats.queueDepth,
+        stats.peakQueueDepth, static_cast<unsigned long long>(stats.executedCnt),
+        static_cast<unsigned long long>(stats.rejectedCnt), static_cast<long long>(stats.avgWaitUs),
+        static_cast<long long>(stats.maxWaitUs), static_cast<long long>(stats.maxRunUs));
+}
+}
+}
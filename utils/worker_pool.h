@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <functional>
+#include <condition_variable>
+#include "nocopyable.h"
+
+namespace OHOS {
+namespace IntellVoiceUtils {
+struct WorkerPoolStats {
+    uint32_t queueDepth = 0;
+    uint32_t peakQueueDepth = 0;
+    uint64_t executedCnt = 0;
+    uint64_t rejectedCnt = 0;
+    int64_t avgWaitUs = 0;
+    int64_t maxWaitUs = 0;
+    int64_t maxRunUs = 0;
+};
+
+/*
+ * Bounded MPMC pool shared by the fire-and-forget work of the service, replacing detached threads.
+ * Workers are created on first submit and joined by Shutdown, after which the pool can be used again.
+ * Submit fails when the queue is full, the caller then has to run the task some other way.
+ * Tasks still queued at Shutdown are run on a detached thread instead of being dropped.
+ */
+class WorkerPool {
+public:
+    static WorkerPool &GetInstance();
+
+    bool Submit(const std::string &name, std::function<void()> func);
+    void Shutdown();
+    WorkerPoolStats GetStats();
+    void DumpStats();
+
+private:
+    struct Task {
+        std::string name;
+        std::function<void()> func;
+        int64_t enqueueUs = 0;
+    };
+
+    WorkerPool() = default;
+    ~WorkerPool();
+    void StartLocked();
+    void Run();
+    static int64_t NowTimeUs();
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<Task> tasks_;
+    std::vector<std::thread> workers_;
+    bool isRunning_ = false;
+    WorkerPoolStats stats_;
+    int64_t totalWaitUs_ = 0;
+
+    DISALLOW_COPY(WorkerPool);
+    DISALLOW_MOVE(WorkerPool);
+};
+}
+}
+#endif